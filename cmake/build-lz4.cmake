@@ -0,0 +1,24 @@
+set(lz4_PREFIX ${CMAKE_BINARY_DIR}/external/lz4)
+
+if(SOLID_ON_WINDOWS)
+    set(LZ4_LIB ${CMAKE_BINARY_DIR}/external/lib/lz4.lib)
+else()
+    set(LZ4_LIB ${CMAKE_BINARY_DIR}/external/lib/liblz4.a)
+endif()
+
+ExternalProject_Add(
+    build-lz4
+    EXCLUDE_FROM_ALL 1
+    PREFIX ${lz4_PREFIX}
+    URL https://github.com/lz4/lz4/archive/refs/tags/v1.10.0.tar.gz
+    DOWNLOAD_NO_PROGRESS ON
+    SOURCE_SUBDIR build/cmake
+    CMAKE_ARGS
+            -DCMAKE_INSTALL_PREFIX:PATH=${CMAKE_BINARY_DIR}/external -DCMAKE_INSTALL_LIBDIR=lib -DBUILD_SHARED_LIBS=OFF -DBUILD_STATIC_LIBS=ON -DLZ4_BUILD_CLI=OFF -DLZ4_BUILD_LEGACY_LZ4C=OFF
+    LOG_UPDATE ON
+    LOG_CONFIGURE ON
+    LOG_BUILD ON
+    LOG_INSTALL ON
+    DOWNLOAD_EXTRACT_TIMESTAMP ON
+    BUILD_BYPRODUCTS ${LZ4_LIB}
+)
@@ -0,0 +1,24 @@
+set(zstd_PREFIX ${CMAKE_BINARY_DIR}/external/zstd)
+
+if(SOLID_ON_WINDOWS)
+    set(ZSTD_LIB ${CMAKE_BINARY_DIR}/external/lib/zstd_static.lib)
+else()
+    set(ZSTD_LIB ${CMAKE_BINARY_DIR}/external/lib/libzstd.a)
+endif()
+
+ExternalProject_Add(
+    build-zstd
+    EXCLUDE_FROM_ALL 1
+    PREFIX ${zstd_PREFIX}
+    URL https://github.com/facebook/zstd/releases/download/v1.5.7/zstd-1.5.7.tar.gz
+    DOWNLOAD_NO_PROGRESS ON
+    SOURCE_SUBDIR build/cmake
+    CMAKE_ARGS
+            -DCMAKE_INSTALL_PREFIX:PATH=${CMAKE_BINARY_DIR}/external -DCMAKE_INSTALL_LIBDIR=lib -DZSTD_BUILD_SHARED=OFF -DZSTD_BUILD_STATIC=ON -DZSTD_BUILD_PROGRAMS=OFF -DZSTD_BUILD_TESTS=OFF -DZSTD_LEGACY_SUPPORT=OFF
+    LOG_UPDATE ON
+    LOG_CONFIGURE ON
+    LOG_BUILD ON
+    LOG_INSTALL ON
+    DOWNLOAD_EXTRACT_TIMESTAMP ON
+    BUILD_BYPRODUCTS ${ZSTD_LIB}
+)
@@ -53,5 +53,13 @@ file (READ "${CMAKE_CURRENT_SOURCE_DIR}/cmake/check/stringstream_view.cpp" sourc
 
 CHECK_CXX_SOURCE_COMPILES("${source_code}" SOLID_USE_STRINGSTREAM_VIEW)
 
+if(SOLID_FRAME_AIO_REACTOR_USE_IO_URING AND SOLID_USE_EPOLL2)
+    # only compile check - the reactor falls back to epoll at runtime
+    # when io_uring is not available on the running kernel
+    file (READ "${CMAKE_CURRENT_SOURCE_DIR}/cmake/check/io_uring.cpp" source_code)
+
+    CHECK_CXX_SOURCE_COMPILES("${source_code}" SOLID_USE_IO_URING)
+endif()
+
 #TODO:
 #set(SOLID_FRAME_AIO_REACTOR_USE_SPINLOCK TRUE)
\ No newline at end of file
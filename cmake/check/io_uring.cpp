@@ -0,0 +1,17 @@
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#include <cstdio>
+
+int main(){
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, 8, &params));
+    printf("fd = %d features = %x", fd, params.features);
+    io_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+    int rv = static_cast<int>(syscall(__NR_io_uring_enter, fd, 0, 0, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg)));
+    printf("rv = %d %d", rv, IORING_POLL_ADD_MULTI);
+    return 0;
+}
@@ -67,6 +67,21 @@ protected:
 
     bool isRunning() const;
 
+    //! Allow the reactor to move the actor, with its completion handlers, onto another reactor
+    /*!
+        See Scheduler::migrateActor and Rebalancer.
+        Only allow it for actors not keeping state bound to the reactor thread.
+    */
+    void migratable(const bool _migratable)
+    {
+        migratable_ = _migratable;
+    }
+
+    bool isMigratable() const
+    {
+        return migratable_;
+    }
+
     void postStop(ReactorContext& _rctx)
     {
         if (doPrepareStop(_rctx)) {
@@ -91,6 +106,9 @@ protected:
 private:
     virtual void onEvent(ReactorContext& _rctx, EventBase&& _uevent);
     bool         doPrepareStop(ReactorContext& _rctx);
+
+private:
+    bool migratable_ = false;
 };
 
 } // namespace aio
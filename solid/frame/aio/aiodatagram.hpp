@@ -239,6 +239,76 @@ class Datagram : public CompletionHandler {
         }
     };
 
+    template <class F>
+    struct RecvFromManyFunctor {
+        F f;
+
+        RecvFromManyFunctor(F&& _rf)
+            : f{std::forward<F>(_rf)}
+        {
+        }
+
+        void operator()(ThisT& _rthis, ReactorContext& _rctx)
+        {
+            size_t recv_count = 0;
+
+            if (!_rctx.error()) {
+                bool       can_retry;
+                ErrorCodeT err;
+                ssize_t    rv = _rthis.s.recvFromMany(_rctx, _rthis.recv_dgram_buf, _rthis.recv_buf_cp, can_retry, err);
+
+                if (rv > 0) {
+                    recv_count = rv;
+                } else if (rv == 0) {
+                    _rthis.error(_rctx, error_datagram_shutdown);
+                } else if (rv == -1) {
+                    if (can_retry) {
+                        return;
+                    } else {
+                        _rthis.error(_rctx, error_datagram_system);
+                        _rthis.systemError(_rctx, err);
+                        solid_assert_log(err, generic_logger);
+                    }
+                }
+            }
+
+            F tmp{std::move(f)};
+            _rthis.doClearRecv(_rctx);
+            tmp(_rctx, recv_count);
+        }
+    };
+
+    template <class F>
+    struct SendToManyFunctor {
+        F f;
+
+        SendToManyFunctor(F&& _rf)
+            : f{std::forward<F>(_rf)}
+        {
+        }
+
+        void operator()(ThisT& _rthis, ReactorContext& _rctx)
+        {
+            if (!_rctx.error()) {
+                bool       can_retry;
+                ErrorCodeT err;
+
+                if (_rthis.doSendToMany(_rctx, can_retry, err)) {
+                } else if (can_retry) {
+                    return;
+                } else {
+                    _rthis.error(_rctx, error_datagram_system);
+                    _rthis.systemError(_rctx, err);
+                    solid_assert_log(err, generic_logger);
+                }
+            }
+
+            F tmp{std::move(f)};
+            _rthis.doClearSend(_rctx);
+            tmp(_rctx);
+        }
+    };
+
     template <class F>
     struct ConnectFunctor {
         F f;
@@ -262,9 +332,11 @@ public:
         : CompletionHandler(_ract, on_init_completion)
         , s(std::move(_rsd))
         , recv_buf(nullptr)
+        , recv_dgram_buf(nullptr)
         , recv_buf_cp(0)
         , recv_is_posted(false)
         , send_buf(nullptr)
+        , send_dgram_buf(nullptr)
         , send_buf_cp(0)
         , send_is_posted(false)
     {
@@ -274,9 +346,11 @@ public:
         ActorProxy const& _ract)
         : CompletionHandler(_ract, on_dummy_completion)
         , recv_buf(nullptr)
+        , recv_dgram_buf(nullptr)
         , recv_buf_cp(0)
         , recv_is_posted(false)
         , send_buf(nullptr)
+        , send_dgram_buf(nullptr)
         , send_buf_cp(0)
         , send_is_posted(false)
     {
@@ -356,6 +430,30 @@ public:
         }
     }
 
+    // Receives up to _count datagrams with a single system call (recvmmsg on Linux).
+    // On completion, _f(ReactorContext&, size_t _recv_count) is called with the number
+    // of filled DatagramBuffers.
+    template <typename F>
+    bool postRecvFromMany(
+        ReactorContext& _rctx,
+        DatagramBuffer* _pbufs, size_t _count,
+        F&& _f)
+    {
+        if (solid_function_empty(recv_fnc)) {
+            using RealF    = typename std::decay<F>::type;
+            recv_fnc       = RecvFromManyFunctor<RealF>{std::forward<RealF>(_f)};
+            recv_dgram_buf = _pbufs;
+            recv_buf_cp    = _count;
+            recv_is_posted = true;
+            doPostRecvSome(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            return true;
+        }
+    }
+
     template <typename F>
     bool postRecv(
         ReactorContext& _rctx,
@@ -392,10 +490,10 @@ public:
             ErrorCodeT err;
             ssize_t    rv = s.recvFrom(_rctx, _buf, _bufcp, _raddr, can_retry, err);
 
-            if (rv == static_cast<ssize_t>(_bufcp)) {
+            if (rv > 0) {
                 _sz = rv;
                 errorClear(_rctx);
-            } else if (rv >= 0) {
+            } else if (rv == 0) {
                 error(_rctx, error_datagram_shutdown);
                 _sz = 0;
             } else if (rv == -1) {
@@ -419,6 +517,47 @@ public:
         return true;
     }
 
+    template <typename F>
+    bool recvFromMany(
+        ReactorContext& _rctx,
+        DatagramBuffer* _pbufs, size_t _count,
+        F&&     _f,
+        size_t& _rrecv_count)
+    {
+        if (solid_function_empty(recv_fnc)) {
+            contextBind(_rctx);
+
+            bool       can_retry;
+            ErrorCodeT err;
+            ssize_t    rv = s.recvFromMany(_rctx, _pbufs, _count, can_retry, err);
+
+            if (rv > 0) {
+                _rrecv_count = rv;
+                errorClear(_rctx);
+            } else if (rv == 0) {
+                error(_rctx, error_datagram_shutdown);
+                _rrecv_count = 0;
+            } else if (rv == -1) {
+                _rrecv_count = 0;
+                if (can_retry) {
+                    recv_dgram_buf = _pbufs;
+                    recv_buf_cp    = _count;
+                    using RealF    = typename std::decay<F>::type;
+                    recv_fnc       = RecvFromManyFunctor<RealF>{std::forward<RealF>(_f)};
+                    errorClear(_rctx);
+                    return false;
+                } else {
+                    error(_rctx, error_datagram_system);
+                    systemError(_rctx, err);
+                    solid_assert_log(err, generic_logger);
+                }
+            }
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
     template <typename F>
     bool recv(
         ReactorContext& _rctx,
@@ -484,6 +623,31 @@ public:
         }
     }
 
+    // Sends all _count datagrams using as few system calls as possible (sendmmsg on Linux).
+    // A DatagramBuffer with a non-zero segment_size_ is sent as one GSO super-buffer.
+    // The buffers must stay valid until _f(ReactorContext&) is called.
+    template <typename F>
+    bool postSendToMany(
+        ReactorContext& _rctx,
+        const DatagramBuffer* _pbufs, size_t _count,
+        F&& _f)
+    {
+        if (solid_function_empty(send_fnc)) {
+            using RealF    = typename std::decay<F>::type;
+            send_fnc       = SendToManyFunctor<RealF>{std::forward<RealF>(_f)};
+            send_dgram_buf = _pbufs;
+            send_buf_cp    = _count;
+            send_is_posted = true;
+            doPostSendAll(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            solid_assert_log(false, generic_logger);
+            return true;
+        }
+    }
+
     template <typename F>
     bool postSend(
         ReactorContext& _rctx,
@@ -545,6 +709,42 @@ public:
         return true;
     }
 
+    template <typename F>
+    bool sendToMany(
+        ReactorContext& _rctx,
+        const DatagramBuffer* _pbufs, size_t _count,
+        F&& _f)
+    {
+        if (solid_function_empty(send_fnc)) {
+            contextBind(_rctx);
+
+            bool       can_retry;
+            ErrorCodeT err;
+
+            send_dgram_buf = _pbufs;
+            send_buf_cp    = _count;
+
+            if (doSendToMany(_rctx, can_retry, err)) {
+                send_dgram_buf = nullptr;
+                errorClear(_rctx);
+            } else if (can_retry) {
+                using RealF = typename std::decay<F>::type;
+                send_fnc    = SendToManyFunctor<RealF>{std::forward<RealF>(_f)};
+                errorClear(_rctx);
+                return false;
+            } else {
+                send_dgram_buf = nullptr;
+                send_buf_cp    = 0;
+                error(_rctx, error_datagram_system);
+                systemError(_rctx, err);
+                solid_assert_log(err, generic_logger);
+            }
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
     template <typename F>
     bool send(
         ReactorContext& _rctx,
@@ -593,6 +793,24 @@ private:
         reactor(_rctx).post(_rctx, on_posted_send, Event<>(), *this);
     }
 
+    // returns true when all pending datagrams were sent
+    bool doSendToMany(ReactorContext& _rctx, bool& _rcan_retry, ErrorCodeT& _rerr)
+    {
+        while (send_buf_cp != 0) {
+            const ssize_t rv = s.sendToMany(_rctx, send_dgram_buf, send_buf_cp, _rcan_retry, _rerr);
+            if (rv > 0) {
+                send_dgram_buf += rv;
+                send_buf_cp -= rv;
+            } else {
+                if (rv == 0) {
+                    _rcan_retry = true;
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
     void doRecv(ReactorContext& _rctx)
     {
         if (!recv_is_posted && !solid_function_empty(recv_fnc)) {
@@ -625,15 +843,17 @@ private:
     void doClearRecv(ReactorContext& _rctx)
     {
         solid_function_clear(recv_fnc);
-        recv_buf    = nullptr;
-        recv_buf_cp = 0;
+        recv_buf       = nullptr;
+        recv_dgram_buf = nullptr;
+        recv_buf_cp    = 0;
     }
 
     void doClearSend(ReactorContext& _rctx)
     {
         solid_function_clear(send_fnc);
-        send_buf    = nullptr;
-        recv_buf_cp = 0;
+        send_buf       = nullptr;
+        send_dgram_buf = nullptr;
+        send_buf_cp    = 0;
     }
     void doClear(ReactorContext& _rctx)
     {
@@ -645,17 +865,19 @@ private:
     }
 
 private:
-    Sock          s;
-    char*         recv_buf;
-    size_t        recv_buf_cp;
-    RecvFunctionT recv_fnc;
-    bool          recv_is_posted;
-
-    const char*   send_buf;
-    size_t        send_buf_cp;
-    SendFunctionT send_fnc;
-    SocketAddress send_addr;
-    bool          send_is_posted;
+    Sock                  s;
+    char*                 recv_buf;
+    DatagramBuffer*       recv_dgram_buf;
+    size_t                recv_buf_cp; // buffer capacity or datagram count
+    RecvFunctionT         recv_fnc;
+    bool                  recv_is_posted;
+
+    const char*           send_buf;
+    const DatagramBuffer* send_dgram_buf;
+    size_t                send_buf_cp; // buffer capacity or datagram count
+    SendFunctionT         send_fnc;
+    SocketAddress         send_addr;
+    bool                  send_is_posted;
 };
 
 } // namespace aio
@@ -52,6 +52,13 @@ struct ReactorStatistic : ReactorStatisticBase {
     std::atomic_size_t   max_exec_size_;
     std::atomic_size_t   actor_count_;
     std::atomic_size_t   max_actor_count_;
+    std::atomic_uint64_t event_count_;   // io events and executed posts
+    std::atomic_uint64_t busy_time_ns_;  // time spent outside of waiting for events
+    std::atomic_uint64_t migrate_in_count_;
+    std::atomic_uint64_t migrate_out_count_;
+    std::atomic_uint64_t migrate_fail_count_;
+    std::atomic_uint64_t broadcast_count_;
+    std::atomic_uint64_t broadcast_actor_count_;
 
     void actorCount(const size_t _count)
     {
@@ -92,6 +99,34 @@ struct ReactorStatistic : ReactorStatisticBase {
         solid_statistic_max(max_exec_size_, _sz);
     }
 
+    // once per reactor loop - sampled by the Rebalancer
+    void loop(const uint64_t _busy_time_ns, const size_t _event_count)
+    {
+        busy_time_ns_.fetch_add(_busy_time_ns, std::memory_order_relaxed);
+        event_count_.fetch_add(_event_count, std::memory_order_relaxed);
+    }
+
+    void migrateIn()
+    {
+        ++migrate_in_count_;
+    }
+
+    void migrateOut()
+    {
+        ++migrate_out_count_;
+    }
+
+    void migrateFail()
+    {
+        ++migrate_fail_count_;
+    }
+
+    void broadcast(const size_t _actor_count)
+    {
+        ++broadcast_count_;
+        broadcast_actor_count_ += _actor_count;
+    }
+
     std::ostream& print(std::ostream& _ros) const override;
 
     void clear();
@@ -99,6 +134,25 @@ struct ReactorStatistic : ReactorStatisticBase {
 
 namespace impl {
 
+//! Asks the reactor of an actor to move it onto reactor_ptr_ - see Scheduler::migrateActor
+struct MigrateRequest {
+    ReactorBasePtrT reactor_ptr_;
+    size_t          retry_count_ = 0;
+};
+
+//! Asks a reactor to move actors worth load_fraction_ of its events onto reactor_ptr_ - see Rebalancer
+struct RebalanceRequest {
+    ReactorBasePtrT reactor_ptr_;
+    double          load_fraction_   = 0;
+    size_t          max_actor_count_ = 1;
+};
+
+//! The actors of a reactor to be woken with event_ - see Manager::notifyAll
+struct BroadcastRequest {
+    std::vector<UniqueId> uid_vec_;
+    Event<32>             event_; // bigger payloads are kept on the heap
+};
+
 class Reactor : public frame::ReactorBase {
     friend struct solid::frame::aio::EventHandler;
     friend class solid::frame::aio::CompletionHandler;
@@ -114,7 +168,8 @@ class Reactor : public frame::ReactorBase {
     friend class solid::frame::aio::Actor;
 
     struct Data;
-    Pimpl<Data, 576> impl_;
+    struct MigrateStub;
+    Pimpl<Data, 704> impl_;
 
 protected:
 #ifdef SOLID_FRAME_AIO_REACTOR_USE_SPINLOCK
@@ -133,11 +188,21 @@ protected:
 public:
     using StatisticT     = ReactorStatistic;
     using EventFunctionT = solid_function_t(void(ReactorContext&, EventBase&&));
+    using MigrateEventT  = Event<sizeof(MigrateRequest)>;
 
     bool start();
     void stop() override;
     void run();
 
+    //! The event moving the notified actor onto _reactor_ptr - only actors allowing it are moved
+    static MigrateEventT migrate_event(ReactorBasePtrT&& _reactor_ptr);
+
+    //! Move the busiest movable actors, worth at most _load_fraction of the events, onto _reactor_ptr
+    void rebalance(ReactorBasePtrT&& _reactor_ptr, const double _load_fraction, const size_t _max_actor_count);
+
+    //! One wake for all the actors - fanned out on the reactor thread
+    void wakeAll(std::vector<UniqueId>&& _ruid_vec, EventBase const& _revent) override;
+
 protected:
     Reactor(SchedulerBase& _rsched, StatisticT& _rstatistic, const size_t _schedidx, const size_t _wake_capacity);
     ~Reactor();
@@ -222,8 +287,12 @@ protected:
     MutexT&  mutex();
     UniqueId actorUid(ReactorContext const& _rctx) const;
 
-    void addActor(UniqueId const& _uid, Service& _rservice, ActorPointerT&& _actor_ptr);
-    bool isValid(UniqueId const& _actor_uid, UniqueId const& _completion_handler_uid) const;
+    using ExecFunctionT = void (*)(ReactorContext&, EventBase&&);
+
+    void          addActor(UniqueId const& _uid, Service& _rservice, ActorPointerT&& _actor_ptr, EventBase& _revent);
+    UniqueId      execActorUid(ReactorContext const& _rctx);
+    ExecFunctionT wakeExecFunction(UniqueId& _ruid, EventBase const& _revent, ReactorBase*& _rpforward_reactor);
+    bool          popExec(UniqueId const& _actor_uid, UniqueId const& _completion_handler_uid);
 
     ReactorContext context(NanoTime const& _rcrttime)
     {
@@ -240,6 +309,9 @@ protected:
     static void increase_event_vector_size(ReactorContext& _rctx, EventBase&& _uevent);
     static void stop_actor(ReactorContext& _rctx, EventBase&& _uevent);
     static void stop_actor_repost(ReactorContext& _rctx, EventBase&& _uevent);
+    static void migrate_actor(ReactorContext& _rctx, EventBase&& _uevent);
+    static void rebalance_actors(ReactorContext& _rctx, EventBase&& _uevent);
+    static void broadcast_actors(ReactorContext& _rctx, EventBase&& _uevent);
 
 private:
     static Reactor* safeSpecific();
@@ -256,13 +328,21 @@ private:
     void doPost(ReactorContext& _rctx, EventFunctionT&& _revfn, EventBase&& _uevent);
     void doPost(ReactorContext& _rctx, EventFunctionT&& _revfn, EventBase&& _uevent, CompletionHandler const& _rch);
 
-    virtual void   doPostActorStop(ReactorContext& _rctx, const UniqueId& _completion_handler_uid)                                   = 0;
-    virtual void   doPost(ReactorContext& _rctx, EventFunctionT&& _revfn, EventBase&& _uev, const UniqueId& _completion_handler_uid) = 0;
-    virtual void   doStopActorRepost(ReactorContext& _rctx, const UniqueId& _completion_handler_uid)                                 = 0;
-    virtual size_t doCompleteExec(NanoTime const& _rcrttime)                                                                         = 0;
-    virtual void   doCompleteEvents(NanoTime const& _rcrttime, const UniqueId& _completion_handler_uid)                              = 0;
+    virtual void   doPostActorStop(ReactorContext& _rctx, const UniqueId& _completion_handler_uid)                                               = 0;
+    virtual void   doPost(ReactorContext& _rctx, EventFunctionT&& _revfn, EventBase&& _uev, const UniqueId& _completion_handler_uid)             = 0;
+    virtual void   doStopActorRepost(ReactorContext& _rctx, const UniqueId& _completion_handler_uid)                                             = 0;
+    virtual size_t doCompleteExec(NanoTime const& _rcrttime)                                                                                     = 0;
+    virtual void   doCompleteEvents(NanoTime const& _rcrttime, const UniqueId& _completion_handler_uid)                                          = 0;
+    virtual bool   doPushActor(ActorPointerT&& _ract, Service& _rsvc, EventBase&& _uevent)                                                       = 0;
+    virtual void   doPushExec(UniqueId const& _ruid, ExecFunctionT _exec_fnc, const UniqueId& _completion_handler_uid, EventBase const& _revent) = 0;
 
     void doStopActor(ReactorContext& _rctx);
+    bool doMigrateActor(ReactorContext& _rctx, Reactor& _rreactor);
+    void doDetachActor(Actor& _ract, MigrateStub& _rstub);
+    void doAttachActor(const size_t _actor_index, MigrateStub& _rstub);
+    void doRebalance(ReactorContext& _rctx, RebalanceRequest& _rrequest);
+    void doBroadcast(BroadcastRequest& _rrequest);
+    void doReleaseForwards(NanoTime const& _rcrttime);
 
     void onTimer(ReactorContext& _rctx, const size_t _chidx);
 };
@@ -493,9 +573,21 @@ private:
         return true;
     }
 
+    bool doPushActor(ActorPointerT&& _ract, Service& _rsvc, EventBase&& _uevent) override
+    {
+        return push(std::move(_ract), _rsvc, std::move(_uevent));
+    }
+
+    void doPushExec(UniqueId const& _ruid, ExecFunctionT _exec_fnc, const UniqueId& _completion_handler_uid, EventBase const& _revent) override
+    {
+        exec_q_.push(ExecStubT(_ruid, _exec_fnc, _completion_handler_uid));
+        exec_q_.back().event_ = _revent;
+        current_exec_size_    = exec_q_.size();
+    }
+
     void doPost(ReactorContext& _rctx, EventFunctionT&& _revent_fnc, EventBase&& _uev, const UniqueId& _completion_handler_uid) override
     {
-        exec_q_.push(ExecStubT(actorUid(_rctx), std::move(_uev)));
+        exec_q_.push(ExecStubT(execActorUid(_rctx), std::move(_uev)));
         exec_q_.back().exec_fnc_               = std::move(_revent_fnc);
         exec_q_.back().completion_handler_uid_ = _completion_handler_uid;
         current_exec_size_                     = exec_q_.size();
@@ -504,7 +596,7 @@ private:
 
     void doStopActorRepost(ReactorContext& _rctx, const UniqueId& _completion_handler_uid) override
     {
-        exec_q_.push(ExecStubT(actorUid(_rctx)));
+        exec_q_.push(ExecStubT(execActorUid(_rctx)));
         exec_q_.back().exec_fnc_               = &stop_actor;
         exec_q_.back().completion_handler_uid_ = _completion_handler_uid;
         current_exec_size_                     = exec_q_.size();
@@ -515,7 +607,7 @@ private:
     */
     void doPostActorStop(ReactorContext& _rctx, const UniqueId& _completion_handler_uid) override
     {
-        exec_q_.push(ExecStubT(actorUid(_rctx)));
+        exec_q_.push(ExecStubT(execActorUid(_rctx)));
         exec_q_.back().exec_fnc_               = &stop_actor_repost;
         exec_q_.back().completion_handler_uid_ = _completion_handler_uid;
         current_exec_size_                     = exec_q_.size();
@@ -540,9 +632,17 @@ private:
                 if (rstub.actor_ptr_) [[unlikely]] {
                     ++actor_count_;
                     rstatistic_.actorCount(actor_count_);
-                    addActor(rstub.uid_, *rstub.pservice_, std::move(rstub.actor_ptr_));
+                    addActor(rstub.uid_, *rstub.pservice_, std::move(rstub.actor_ptr_), rstub.event_);
+                }
+                UniqueId     uid              = rstub.uid_;
+                ReactorBase* pforward_reactor = nullptr;
+
+                if (const auto exec_fnc = wakeExecFunction(uid, rstub.event_, pforward_reactor); exec_fnc != nullptr) [[likely]] {
+                    exec_q_.push(ExecStubT(uid, exec_fnc, _completion_handler_uid, std::move(rstub.event_)));
+                } else if (pforward_reactor != nullptr) {
+                    // the actor was moved onto another reactor
+                    pforward_reactor->wake(uid, std::move(rstub.event_));
                 }
-                exec_q_.push(ExecStubT(rstub.uid_, &call_actor_on_event, _completion_handler_uid, std::move(rstub.event_)));
                 --pending_wake_count_;
                 ++pop_wake_index_;
                 rstub.clear();
@@ -564,7 +664,7 @@ private:
         while ((sz--) != 0) {
             auto& rexec(exec_q_.front());
             solid_log(logger, Verbose, sz << " qsz = " << exec_q_.size());
-            if (isValid(rexec.actor_uid_, rexec.completion_handler_uid_)) {
+            if (popExec(rexec.actor_uid_, rexec.completion_handler_uid_)) {
                 ctx.clearError();
                 update(ctx, static_cast<size_t>(rexec.completion_handler_uid_.index), static_cast<size_t>(rexec.actor_uid_.index));
                 rexec.exec_fnc_(ctx, std::move(rexec.event_));
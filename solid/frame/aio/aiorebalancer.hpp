@@ -0,0 +1,143 @@
+// solid/frame/aio/aiorebalancer.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "solid/system/common.hpp"
+#include "solid/utility/common.hpp"
+
+namespace solid {
+namespace frame {
+namespace aio {
+
+struct RebalancerConfiguration {
+    std::chrono::milliseconds period = std::chrono::seconds(1);
+    //! Rebalance only when the busiest reactor is this many times busier than the least busy one
+    double imbalance_ratio = 1.5;
+    //! Rebalance only when the busiest reactor was busy at least this fraction of the period
+    double min_busy_fraction = 0.1;
+    //! At most this many actors moved on a pass
+    size_t max_actor_count = 4;
+};
+
+struct RebalancePlan {
+    size_t from_index_    = InvalidIndex();
+    size_t to_index_      = InvalidIndex();
+    double load_fraction_ = 0;
+
+    bool empty() const
+    {
+        return from_index_ == InvalidIndex();
+    }
+};
+
+//! Move from the busiest reactor onto the least busy one half of the difference in their busy times
+RebalancePlan rebalance_plan(
+    RebalancerConfiguration const& _rconfig,
+    std::vector<uint64_t> const&   _busy_time_ns_vec,
+    const std::chrono::nanoseconds _period);
+
+//! Periodically moves load from the busiest reactor of a Scheduler onto the least busy one
+/*!
+    Samples the busy time the reactors spend outside waiting for events
+    (ReactorStatistic::busy_time_ns_) and asks the busiest reactor to move
+    some of its busiest actors - only those which are aio::Actor::migratable.
+*/
+template <class Sch>
+class Rebalancer : NonCopyable {
+    Sch&                                  rsch_;
+    const RebalancerConfiguration         config_;
+    std::vector<uint64_t>                 last_busy_time_ns_vec_;
+    std::chrono::steady_clock::time_point last_time_;
+    std::thread                           thread_;
+    std::mutex                            mutex_;
+    std::condition_variable               cnd_;
+    bool                                  running_ = false;
+
+public:
+    Rebalancer(Sch& _rsch, RebalancerConfiguration const& _rconfig = RebalancerConfiguration())
+        : rsch_(_rsch)
+        , config_(_rconfig)
+    {
+    }
+
+    ~Rebalancer()
+    {
+        stop();
+    }
+
+    void start()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            running_ = true;
+            thread_  = std::thread(
+                [this]() {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    while (!cnd_.wait_for(lock, config_.period, [this]() { return !running_; })) {
+                        lock.unlock();
+                        run();
+                        lock.lock();
+                    }
+                });
+        }
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+        }
+        cnd_.notify_one();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    //! A sampling pass - returns true if a rebalance was requested
+    bool run()
+    {
+        const size_t worker_count = rsch_.workerCount();
+        const auto   now          = std::chrono::steady_clock::now();
+        bool         rv           = false;
+
+        std::vector<uint64_t> busy_time_ns_vec(worker_count);
+        for (size_t i = 0; i < worker_count; ++i) {
+            busy_time_ns_vec[i] = rsch_.statistic().reactorStatistic(i).busy_time_ns_.load(std::memory_order_relaxed);
+        }
+
+        if (last_busy_time_ns_vec_.size() == worker_count) {
+            std::vector<uint64_t> delta_vec(worker_count);
+            for (size_t i = 0; i < worker_count; ++i) {
+                delta_vec[i] = busy_time_ns_vec[i] - last_busy_time_ns_vec_[i];
+            }
+            const auto plan = rebalance_plan(config_, delta_vec, now - last_time_);
+            if (!plan.empty()) {
+                rv = rsch_.rebalanceWorkers(plan.from_index_, plan.to_index_, plan.load_fraction_, config_.max_actor_count);
+            }
+        }
+
+        last_busy_time_ns_vec_ = std::move(busy_time_ns_vec);
+        last_time_             = now;
+        return rv;
+    }
+};
+
+} // namespace aio
+} // namespace frame
+} // namespace solid
@@ -57,6 +57,17 @@ public:
         return rv;
     }
 
+    ssize_t sendv(ReactorContext& _rctx, const ConstBuffer* _pbufs, size_t _count, bool& _can_retry, ErrorCodeT& _rerr, const bool _zero_copy = false)
+    {
+        const ssize_t rv = device().sendv(_pbufs, _count, _can_retry, _rerr, _zero_copy);
+#if defined(SOLID_USE_WSAPOLL)
+        if (rv < 0 && _can_retry) {
+            modifyReactorRequestEvents(_rctx, ReactorWaitRequestE::Write);
+        }
+#endif
+        return rv;
+    }
+
     ssize_t recvFrom(ReactorContext& _rctx, char* _pb, size_t _bl, SocketAddress& _addr, bool& _can_retry, ErrorCodeT& _rerr)
     {
         const ssize_t rv = device().recv(_pb, _bl, _addr, _can_retry, _rerr);
@@ -75,6 +86,28 @@ public:
         if (rv < 0 && _can_retry) {
             modifyReactorRequestEvents(_rctx, ReactorWaitRequestE::Write);
         }
+#endif
+        return rv;
+    }
+
+    ssize_t recvFromMany(ReactorContext& _rctx, DatagramBuffer* _pbufs, size_t _count, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+        const ssize_t rv = device().recvMany(_pbufs, _count, _can_retry, _rerr);
+#if defined(SOLID_USE_WSAPOLL)
+        if (rv < 0 && _can_retry) {
+            modifyReactorRequestEvents(_rctx, ReactorWaitRequestE::Read);
+        }
+#endif
+        return rv;
+    }
+
+    ssize_t sendToMany(ReactorContext& _rctx, const DatagramBuffer* _pbufs, size_t _count, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+        const ssize_t rv = device().sendMany(_pbufs, _count, _can_retry, _rerr);
+#if defined(SOLID_USE_WSAPOLL)
+        if (rv < 0 && _can_retry) {
+            modifyReactorRequestEvents(_rctx, ReactorWaitRequestE::Write);
+        }
 #endif
         return rv;
     }
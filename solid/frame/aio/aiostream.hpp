@@ -29,6 +29,11 @@ class Stream : public CompletionHandler {
     using RecvFunctionT = solid_function_t(void(ThisT&, ReactorContext&));
     using SendFunctionT = solid_function_t(void(ThisT&, ReactorContext&));
 
+public:
+    using ZeroCopyFunctionT = void (*)(ReactorContext&, const uint32_t);
+
+private:
+
     static void on_init_completion(CompletionHandler& _rch, ReactorContext& _rctx)
     {
         ThisT& rthis = static_cast<ThisT&>(_rch);
@@ -60,7 +65,14 @@ class Stream : public CompletionHandler {
             break;
         case ReactorEventE::Hangup:
         case ReactorEventE::Error:
-            rthis.doError(_rctx);
+            if (rthis.zc_fnc != nullptr && rthis.doZeroCopyCompletion(_rctx)) {
+                // error queue notification - the socket may also be readable/writable
+                // a real socket error will be reported by the recv/send calls
+                rthis.doRecv(_rctx);
+                rthis.doSend(_rctx);
+            } else {
+                rthis.doError(_rctx);
+            }
             break;
         case ReactorEventE::Clear:
             rthis.doClear(_rctx);
@@ -274,6 +286,10 @@ public:
         , send_buf_sz(0)
         , send_buf_cp(0)
         , send_is_posted(false)
+        , send_vec(nullptr)
+        , send_vec_cnt(0)
+        , zc_fnc(nullptr)
+        , zc_send_count(0)
     {
     }
 
@@ -290,6 +306,10 @@ public:
         , send_buf_sz(0)
         , send_buf_cp(0)
         , send_is_posted(false)
+        , send_vec(nullptr)
+        , send_vec_cnt(0)
+        , zc_fnc(nullptr)
+        , zc_send_count(0)
     {
     }
 
@@ -304,6 +324,10 @@ public:
         , send_buf_sz(0)
         , send_buf_cp(0)
         , send_is_posted(false)
+        , send_vec(nullptr)
+        , send_vec_cnt(0)
+        , zc_fnc(nullptr)
+        , zc_send_count(0)
     {
     }
 
@@ -320,6 +344,10 @@ public:
         , send_buf_sz(0)
         , send_buf_cp(0)
         , send_is_posted(false)
+        , send_vec(nullptr)
+        , send_vec_cnt(0)
+        , zc_fnc(nullptr)
+        , zc_send_count(0)
     {
     }
 
@@ -461,6 +489,68 @@ public:
         return true;
     }
 
+    //! Send all the buffers with as few system calls as possible
+    /*!
+     * The _pbufs array is consumed in place: it and the data it points to
+     * must stay valid until the completion is called.
+     * With _zero_copy (see enableZeroCopy) the first, synchronous, write is
+     * done with MSG_ZEROCOPY and the kernel keeps referencing the sent data
+     * until the zero-copy completion; the remaining data, if any, is
+     * written normally.
+     */
+    template <typename F>
+    bool sendAllv(ReactorContext& _rctx, ConstBuffer* _pbufs, size_t _count, F&& _f, const bool _zero_copy = false)
+    {
+        if (solid_function_empty(send_fnc)) {
+            errorClear(_rctx);
+            contextBind(_rctx);
+
+            send_vec     = _pbufs;
+            send_vec_cnt = _count;
+            send_buf_cp  = 0;
+            send_buf_sz  = 0;
+            for (size_t i = 0; i < _count; ++i) {
+                send_buf_cp += _pbufs[i].size_;
+            }
+
+            if (doTrySend(_rctx, _zero_copy && zc_fnc != nullptr)) {
+                if (send_buf_sz == send_buf_cp) {
+                    send_vec     = nullptr;
+                    send_vec_cnt = 0;
+                    return true;
+                }
+            }
+            using RealF = typename std::decay<F>::type;
+            send_fnc    = SendAllFunctor<RealF>{std::forward<RealF>(_f)};
+            return false;
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
+    //! Allow MSG_ZEROCOPY writes (see sendAllv) on the socket
+    /*!
+     * Zero-copy writes are numbered from zero, in the order they were made
+     * (see zeroCopySendCount). _pf is called with the number of zero-copy
+     * writes the kernel has released when their completions are read from
+     * the socket error queue.
+     */
+    ErrorCodeT enableZeroCopy(ZeroCopyFunctionT _pf)
+    {
+        ErrorCodeT err = s.device().enableZeroCopy();
+        if (!err) {
+            zc_fnc = _pf;
+        }
+        return err;
+    }
+
+    //! The number of zero-copy writes made on the socket
+    uint32_t zeroCopySendCount() const
+    {
+        return zc_send_count;
+    }
+
     template <typename F>
     bool connect(ReactorContext& _rctx, SocketAddressStub const& _rsas, F&& _f)
     {
@@ -687,17 +777,30 @@ private:
         return true;
     }
 
-    bool doTrySend(ReactorContext& _rctx)
+    bool doTrySend(ReactorContext& _rctx, const bool _zero_copy = false)
     {
         bool       can_retry;
         ErrorCodeT err;
-        ssize_t    rv = s.send(_rctx, send_buf, send_buf_cp - send_buf_sz, can_retry, err);
+        ssize_t    rv = send_vec_cnt == 0 ? s.send(_rctx, send_buf, send_buf_cp - send_buf_sz, can_retry, err) : s.sendv(_rctx, send_vec, send_vec_cnt, can_retry, err, _zero_copy);
+
+        if (_zero_copy) {
+            if (rv > 0) {
+                ++zc_send_count;
+            } else if (rv < 0 && err == std::errc::no_buffer_space) {
+                // out of pinned memory (optmem) - fall back to a copying write
+                rv = s.sendv(_rctx, send_vec, send_vec_cnt, can_retry, err);
+            }
+        }
 
         solid_log(logger, Verbose, "send (" << (send_buf_cp - send_buf_sz) << ") = " << rv << ' ' << can_retry);
 
         if (rv > 0) {
             send_buf_sz += rv;
-            send_buf += rv;
+            if (send_vec_cnt == 0) {
+                send_buf += rv;
+            } else {
+                doAdvanceSendVector(rv);
+            }
         } else if (rv == 0) {
             error(_rctx, error_stream_shutdown);
             send_buf_sz = send_buf_cp = 0;
@@ -716,6 +819,39 @@ private:
         return true;
     }
 
+    void doAdvanceSendVector(size_t _sz)
+    {
+        while (send_vec_cnt != 0 && _sz >= send_vec->size_) {
+            _sz -= send_vec->size_;
+            ++send_vec;
+            --send_vec_cnt;
+        }
+        if (_sz != 0) {
+            send_vec->data_ += _sz;
+            send_vec->size_ -= _sz;
+        }
+    }
+
+    bool doZeroCopyCompletion(ReactorContext& _rctx)
+    {
+        uint32_t   lo;
+        uint32_t   hi;
+        uint32_t   last = 0;
+        ErrorCodeT err;
+        bool       rv = false;
+
+        while (s.device().recvZeroCopyCompletion(lo, hi, err)) {
+            solid_log(logger, Verbose, "zero-copy completion [" << lo << ", " << hi << "]");
+            last = hi;
+            rv   = true;
+        }
+        if (rv) {
+            // TCP reports the completions in order
+            zc_fnc(_rctx, last + 1);
+        }
+        return rv;
+    }
+
     void doCheckConnect(ReactorContext& _rctx)
     {
         ErrorCodeT err = s.checkConnect(_rctx);
@@ -752,8 +888,10 @@ private:
     {
         solid_function_clear(send_fnc);
         solid_assert_log(solid_function_empty(send_fnc), generic_logger);
-        send_buf    = nullptr;
-        send_buf_sz = send_buf_cp = 0;
+        send_buf     = nullptr;
+        send_buf_sz  = send_buf_cp = 0;
+        send_vec     = nullptr;
+        send_vec_cnt = 0;
     }
 
     void doClear(ReactorContext& _rctx)
@@ -774,11 +912,15 @@ private:
     RecvFunctionT recv_fnc;
     bool          recv_is_posted;
 
-    const char*   send_buf;
-    size_t        send_buf_sz;
-    size_t        send_buf_cp;
-    SendFunctionT send_fnc;
-    bool          send_is_posted;
+    const char*       send_buf;
+    size_t            send_buf_sz;
+    size_t            send_buf_cp;
+    SendFunctionT     send_fnc;
+    bool              send_is_posted;
+    ConstBuffer*      send_vec;
+    size_t            send_vec_cnt;
+    ZeroCopyFunctionT zc_fnc;
+    uint32_t          zc_send_count;
 };
 
 } // namespace aio
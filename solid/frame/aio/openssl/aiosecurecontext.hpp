@@ -72,6 +72,14 @@ public:
     ErrorCodeT loadPrivateKey(const unsigned char* _data, const size_t _data_size, const FileFormat _fformat = FileFormat::Pem);
     ErrorCodeT loadPrivateKey(const std::string& _str, const FileFormat _fformat = FileFormat::Pem);
 
+    //! Let the kernel encrypt/decrypt the records of the secured sockets (kTLS)
+    /*!
+     * Needs an OpenSSL built with kTLS support - otherwise an error is returned.
+     * Whether the kernel takes over is decided per connection, once secured - see
+     * Socket::isKernelTlsSend/Recv; when it does not, OpenSSL keeps doing the work.
+     */
+    ErrorCodeT enableKernelTls(const bool _enable = true);
+
     template <typename F>
     ErrorCodeT passwordCallback(F _f)
     {
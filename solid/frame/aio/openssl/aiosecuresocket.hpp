@@ -85,6 +85,18 @@ public:
     ssize_t recv(ReactorContext& _rctx, char* _pb, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr);
 
     ssize_t send(ReactorContext& _rctx, const char* _pb, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr);
+    //! Without kTLS the buffers are written one after another, each in its own TLS record(s)
+    /*!
+     * With the kernel encrypting the records (isKernelTlsSend) the buffers are
+     * gathered in a single writev, like on a plain socket.
+     * There is no zero-copy for TLS - _zero_copy is ignored.
+     */
+    ssize_t sendv(ReactorContext& _rctx, const ConstBuffer* _pbufs, size_t _count, bool& _can_retry, ErrorCodeT& _rerr, const bool _zero_copy = false);
+
+    //! The kernel encrypts the sent records - valid once secured
+    bool isKernelTlsSend() const;
+    //! The kernel decrypts the received records - valid once secured
+    bool isKernelTlsRecv() const;
 
     NativeHandleT nativeHandle() const;
 
@@ -123,6 +135,8 @@ private:
 
     ErrorCodeT doPrepareVerifyCallback(VerifyMaskT _verify_mask);
 
+    void doCheckKernelTls();
+
     static int on_verify(int preverify_ok, X509_STORE_CTX* x509_ctx);
 
 private:
@@ -133,6 +147,8 @@ private:
     bool            want_read_on_send;
     bool            want_write_on_recv;
     bool            want_write_on_send;
+    bool            ktls_send;
+    bool            ktls_recv;
     VerifyFunctionT verify_cbk;
 };
 
@@ -141,6 +157,16 @@ inline Socket::NativeHandleT Socket::nativeHandle() const
     return pssl;
 }
 
+inline bool Socket::isKernelTlsSend() const
+{
+    return ktls_send;
+}
+
+inline bool Socket::isKernelTlsRecv() const
+{
+    return ktls_recv;
+}
+
 } // namespace openssl
 } // namespace aio
 } // namespace frame
@@ -66,6 +66,7 @@ enum struct WrapperError : int {
     SetCheckHostName,
     SetCheckEmail,
     SetCheckIP,
+    KernelTls,
 };
 
 class ErrorCategory : public solid::ErrorCategoryT {
@@ -103,6 +104,9 @@ std::string ErrorCategory::message(int _ev) const
     case WrapperError::SetCheckIP:
         oss << "Setting IP used for verification";
         break;
+    case WrapperError::KernelTls:
+        oss << "Kernel TLS not supported by OpenSSL";
+        break;
     default:
         oss << "Unknown error";
         break;
@@ -399,6 +403,23 @@ ErrorCodeT Context::doSetPasswordCallback()
     return ErrorCodeT();
 }
 
+ErrorCodeT Context::enableKernelTls(const bool _enable)
+{
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+    if (_enable) {
+        SSL_CTX_set_options(pctx, SSL_OP_ENABLE_KTLS);
+    } else {
+        SSL_CTX_clear_options(pctx, SSL_OP_ENABLE_KTLS);
+    }
+    return ErrorCodeT();
+#else
+    if (_enable) {
+        return wrapper_category.makeError(WrapperError::KernelTls);
+    }
+    return ErrorCodeT();
+#endif
+}
+
 /*static*/ int Context::on_password_cb(char* buf, int size, int rwflag, void* u)
 {
     Context& rthis = *static_cast<Context*>(u);
@@ -442,6 +463,8 @@ Socket::Socket(
     , want_read_on_send(false)
     , want_write_on_recv(false)
     , want_write_on_send(false)
+    , ktls_send(false)
+    , ktls_recv(false)
 {
     pssl = SSL_new(_rctx.pctx);
     ::SSL_set_mode(pssl, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
@@ -457,6 +480,8 @@ Socket::Socket(const Context& _rctx)
     , want_read_on_send(false)
     , want_write_on_recv(false)
     , want_write_on_send(false)
+    , ktls_send(false)
+    , ktls_recv(false)
 {
     pssl = SSL_new(_rctx.pctx);
     ::SSL_set_mode(pssl, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
@@ -471,6 +496,7 @@ SocketDevice Socket::reset(ReactorContext& _rctx, SocketDevice&& _rsd)
 {
 
     SocketDevice sd = SocketBase::reset(_rctx, std::move(_rsd));
+    ktls_send = ktls_recv = false;
     if (device()) {
         SSL_set_fd(pssl, sd.descriptor());
     } else {
@@ -605,6 +631,13 @@ ssize_t Socket::send(ReactorContext& _rctx, const char* _pb, size_t _bl, bool& _
 {
     want_read_on_send = want_write_on_send = false;
 
+    if (ktls_send) {
+        // the kernel makes the records - the plain socket path
+        const ssize_t rv   = device().send(_pb, _bl, _can_retry, _rerr);
+        want_write_on_send = rv < 0 && _can_retry;
+        return rv;
+    }
+
     storeThisPointer();
     storeContextPointer(&_rctx);
 
@@ -661,6 +694,35 @@ ssize_t Socket::send(ReactorContext& _rctx, const char* _pb, size_t _bl, bool& _
     return -1;
 }
 
+ssize_t Socket::sendv(ReactorContext& _rctx, const ConstBuffer* _pbufs, size_t _count, bool& _can_retry, ErrorCodeT& _rerr, const bool /*_zero_copy*/)
+{
+    if (ktls_send) {
+        want_read_on_send  = false;
+        const ssize_t rv   = device().sendv(_pbufs, _count, _can_retry, _rerr, false);
+        want_write_on_send = rv < 0 && _can_retry;
+        return rv;
+    }
+
+    ssize_t total = 0;
+    for (size_t i = 0; i < _count; ++i) {
+        const ssize_t rv = send(_rctx, _pbufs[i].data_, _pbufs[i].size_, _can_retry, _rerr);
+        if (rv > 0) {
+            total += rv;
+            if (static_cast<size_t>(rv) < _pbufs[i].size_) {
+                break;
+            }
+        } else if (total != 0) {
+            // report the progress - the retry or the error will show up on the next call
+            _can_retry = false;
+            _rerr.clear();
+            break;
+        } else {
+            return rv;
+        }
+    }
+    return total;
+}
+
 bool Socket::secureAccept(ReactorContext& _rctx, bool& _can_retry, ErrorCodeT& _rerr)
 {
     want_read_on_recv = want_write_on_recv = false;
@@ -681,6 +743,7 @@ bool Socket::secureAccept(ReactorContext& _rctx, bool& _can_retry, ErrorCodeT& _
     switch (err_cond) {
     case SSL_ERROR_NONE:
         _can_retry = false;
+        doCheckKernelTls();
         return true;
     case SSL_ERROR_ZERO_RETURN:
         _can_retry = false;
@@ -743,6 +806,7 @@ bool Socket::secureConnect(ReactorContext& _rctx, bool& _can_retry, ErrorCodeT&
     switch (err_cond) {
     case SSL_ERROR_NONE:
         _can_retry = false;
+        doCheckKernelTls();
         return true;
     case SSL_ERROR_ZERO_RETURN:
         _can_retry = false;
@@ -895,6 +959,15 @@ static int convertMask(const VerifyMaskT _verify_mask)
     return rv;
 }
 
+void Socket::doCheckKernelTls()
+{
+#if defined(BIO_get_ktls_send)
+    ktls_send = BIO_get_ktls_send(SSL_get_wbio(pssl));
+    ktls_recv = BIO_get_ktls_recv(SSL_get_rbio(pssl));
+#endif
+    solid_log(logger, Verbose, this << " kernel tls send = " << ktls_send << " recv = " << ktls_recv);
+}
+
 ErrorCodeT Socket::doPrepareVerifyCallback(VerifyMaskT _verify_mask)
 {
     SSL_set_verify(pssl, convertMask(_verify_mask), on_verify);
@@ -16,6 +16,14 @@
 #include <sys/epoll.h>
 #include <sys/eventfd.h>
 
+#if defined(SOLID_USE_IO_URING)
+#include <csignal>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #elif defined(SOLID_USE_KQUEUE)
 
 #include <sys/event.h>
@@ -49,12 +57,14 @@
 
 #include "solid/utility/event.hpp"
 #include "solid/utility/queue.hpp"
+#include "solid/utility/sharedbuffer.hpp"
 #include "solid/utility/stack.hpp"
 
 #include "solid/frame/actor.hpp"
 #include "solid/frame/common.hpp"
 #include "solid/frame/service.hpp"
 #include "solid/frame/timestore.hpp"
+#include "solid/frame/timewheel.hpp"
 
 #include "solid/frame/aio/aioactor.hpp"
 #include "solid/frame/aio/aiocompletion.hpp"
@@ -90,10 +100,18 @@ inline size_t void_to_index(const void* _ptr)
 struct CompletionHandlerStub {
     CompletionHandler* pcompletion_handler_;
     size_t             actor_idx_;
-    UniqueT            unique_ = 0;
+    UniqueT            unique_        = 0;
+    int                device_fd_     = -1; // the device registered for events - needed for migration
+    uint32_t           device_events_ = 0;
+    bool               is_timer_      = false;
 #if defined(SOLID_USE_WSAPOLL)
     size_t connect_idx_ = InvalidIndex();
 #endif
+#if defined(SOLID_USE_IO_URING)
+    uint32_t poll_unique_ = 0;
+    uint32_t poll_events_ = 0; // 0 means no poll request armed
+    int      poll_fd_     = -1;
+#endif
 
     CompletionHandlerStub(
         CompletionHandler* _pch    = nullptr,
@@ -107,22 +125,312 @@ struct CompletionHandlerStub {
 //=============================================================================
 
 struct ActorStub {
-    UniqueT       unique_   = 0;
-    Service*      pservice_ = nullptr;
-    ActorPointerT actor_ptr_;
+    UniqueT         unique_      = 0;
+    Service*        pservice_    = nullptr;
+    size_t          exec_count_  = 0; // pending posts and events - the actor is moved only when none
+    uint64_t        event_count_ = 0; // since the last rebalance
+    ActorPointerT   actor_ptr_;
+    ReactorBasePtrT forward_reactor_ptr_; // the actor was moved onto this reactor
+    UniqueId        forward_uid_;
 
     void clear()
     {
         actor_ptr_.reset();
-        pservice_ = nullptr;
+        forward_reactor_ptr_.reset();
+        pservice_    = nullptr;
+        exec_count_  = 0;
+        event_count_ = 0;
         ++unique_;
     }
 };
 
+//=============================================================================
+/*NOTE:
+    Moving an actor between reactors:
+    * on the source reactor, between callbacks and only when no post or event
+      is pending for the actor, its completion handlers are detached: devices
+      are removed from the reactor, pending timers are removed from the time store;
+    * under the actor's mutex, the actor is pushed onto the target reactor
+      together with the detached handlers and the Manager is updated -
+      the same way as on registerActor;
+    * the target reactor attaches the handlers without calling Init on them;
+    * for forward_timeout, the source reactor keeps the actor's slot to forward
+      the events sent to it by notifiers which looked it up before the move.
+*/
+enum struct ReactorActionE : uintptr_t {
+    Migrate,
+    Attach,
+    Rebalance,
+    Broadcast,
+};
+
+const EventCategory<ReactorActionE> reactor_action_category{
+    "solid::frame::aio::reactor_action",
+    [](const ReactorActionE _evt) {
+        switch (_evt) {
+        case ReactorActionE::Migrate:
+            return "migrate";
+        case ReactorActionE::Attach:
+            return "attach";
+        case ReactorActionE::Rebalance:
+            return "rebalance";
+        case ReactorActionE::Broadcast:
+            return "broadcast";
+        default:
+            return "unknown";
+        }
+    }};
+
+const Event<> migrate_action_event   = make_event(reactor_action_category, ReactorActionE::Migrate);
+const Event<> attach_action_event    = make_event(reactor_action_category, ReactorActionE::Attach);
+const Event<> rebalance_action_event = make_event(reactor_action_category, ReactorActionE::Rebalance);
+const Event<> broadcast_action_event = make_event(reactor_action_category, ReactorActionE::Broadcast);
+
+constexpr auto   forward_timeout     = std::chrono::seconds(2);
+constexpr size_t migrate_retry_count = 64;
+
+//=============================================================================
+#if defined(SOLID_USE_IO_URING)
+/*NOTE:
+    Minimal io_uring wrapper used as a readiness source instead of epoll.
+    Every device registered on the reactor gets a multishot, edge-triggered
+    IORING_OP_POLL_ADD request. Poll (re)arming and removals are queued on
+    the submission ring and are submitted together with the wait for
+    completions - one io_uring_enter per reactor loop iteration instead of
+    one epoll_ctl per device change plus one epoll_pwait2.
+*/
+constexpr uint64_t ring_control_tag = uint64_t(1) << 63;
+
+inline uint64_t ring_poll_user_data(const size_t _chidx, const uint32_t _unique)
+{
+    return (static_cast<uint64_t>(_unique & 0x7fffffffU) << 32) | static_cast<uint32_t>(_chidx);
+}
+
+inline size_t ring_user_data_index(const uint64_t _user_data)
+{
+    return static_cast<uint32_t>(_user_data);
+}
+
+inline uint32_t ring_user_data_unique(const uint64_t _user_data)
+{
+    return static_cast<uint32_t>(_user_data >> 32) & 0x7fffffffU;
+}
+
+class IoUring : NonCopyable {
+    int           fd_          = -1;
+    void*         ring_ptr_    = MAP_FAILED;
+    size_t        ring_size_   = 0;
+    io_uring_sqe* sqes_        = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t        sqes_size_   = 0;
+    unsigned*     sq_head_     = nullptr;
+    unsigned*     sq_tail_     = nullptr;
+    unsigned*     sq_array_    = nullptr;
+    unsigned      sq_mask_     = 0;
+    unsigned      sq_entries_  = 0;
+    unsigned*     cq_head_     = nullptr;
+    unsigned*     cq_tail_     = nullptr;
+    io_uring_cqe* cqes_        = nullptr;
+    unsigned      cq_mask_     = 0;
+    unsigned      to_submit_   = 0;
+    unsigned      submit_tail_ = 0;
+
+public:
+    IoUring() = default;
+
+    ~IoUring()
+    {
+        close();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return fd_ >= 0;
+    }
+
+    bool init(const unsigned _entries)
+    {
+        static constexpr unsigned setup_flags[] = {
+            IORING_SETUP_CQSIZE | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN,
+            IORING_SETUP_CQSIZE | IORING_SETUP_COOP_TASKRUN,
+            IORING_SETUP_CQSIZE};
+
+        io_uring_params params;
+        for (const auto flags : setup_flags) {
+            memset(&params, 0, sizeof(params));
+            params.flags      = flags;
+            params.cq_entries = _entries * 4;
+            fd_               = static_cast<int>(syscall(__NR_io_uring_setup, _entries, &params));
+            if (fd_ >= 0 || errno != EINVAL) {
+                break;
+            }
+        }
+
+        if (fd_ < 0) {
+            solid_log(logger, Warning, "io_uring_setup: " << last_system_error().message());
+            return false;
+        }
+
+        // IORING_FEAT_RSRC_TAGS came with the same kernel (5.13) as multishot poll
+        constexpr unsigned required_features = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG | IORING_FEAT_RSRC_TAGS;
+
+        if ((params.features & required_features) != required_features) {
+            solid_log(logger, Warning, "io_uring missing features: " << std::hex << (required_features & ~params.features) << std::dec);
+            close();
+            return false;
+        }
+
+        ring_size_ = std::max(
+            params.sq_off.array + params.sq_entries * sizeof(unsigned),
+            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+        ring_ptr_ = mmap(nullptr, ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+
+        if (ring_ptr_ == MAP_FAILED) {
+            solid_log(logger, Warning, "io_uring mmap ring: " << last_system_error().message());
+            close();
+            return false;
+        }
+
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_      = static_cast<io_uring_sqe*>(mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES));
+
+        if (sqes_ == MAP_FAILED) {
+            solid_log(logger, Warning, "io_uring mmap sqes: " << last_system_error().message());
+            close();
+            return false;
+        }
+
+        auto* pbase  = static_cast<char*>(ring_ptr_);
+        sq_head_     = reinterpret_cast<unsigned*>(pbase + params.sq_off.head);
+        sq_tail_     = reinterpret_cast<unsigned*>(pbase + params.sq_off.tail);
+        sq_array_    = reinterpret_cast<unsigned*>(pbase + params.sq_off.array);
+        sq_mask_     = *reinterpret_cast<unsigned*>(pbase + params.sq_off.ring_mask);
+        sq_entries_  = params.sq_entries;
+        cq_head_     = reinterpret_cast<unsigned*>(pbase + params.cq_off.head);
+        cq_tail_     = reinterpret_cast<unsigned*>(pbase + params.cq_off.tail);
+        cqes_        = reinterpret_cast<io_uring_cqe*>(pbase + params.cq_off.cqes);
+        cq_mask_     = *reinterpret_cast<unsigned*>(pbase + params.cq_off.ring_mask);
+        submit_tail_ = *sq_tail_;
+        return true;
+    }
+
+    void close()
+    {
+        if (sqes_ != MAP_FAILED) {
+            munmap(sqes_, sqes_size_);
+            sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+        }
+        if (ring_ptr_ != MAP_FAILED) {
+            munmap(ring_ptr_, ring_size_);
+            ring_ptr_ = MAP_FAILED;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    void pollAdd(const int _fd, const uint32_t _events, const uint64_t _user_data)
+    {
+        io_uring_sqe& rsqe = nextSqe();
+        rsqe.opcode        = IORING_OP_POLL_ADD;
+        rsqe.fd            = _fd;
+        rsqe.poll32_events = _events;
+        rsqe.len           = IORING_POLL_ADD_MULTI;
+        rsqe.user_data     = _user_data;
+    }
+
+    void pollRemove(const uint64_t _target_user_data)
+    {
+        io_uring_sqe& rsqe = nextSqe();
+        rsqe.opcode        = IORING_OP_POLL_REMOVE;
+        rsqe.fd            = -1;
+        rsqe.addr          = _target_user_data;
+        rsqe.user_data     = ring_control_tag;
+    }
+
+    bool hasCompletions() const noexcept
+    {
+        return *cq_head_ != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    }
+
+    //! Submit all the queued requests and wait for at least one completion
+    /*!
+        _pwait == nullptr - wait indefinitely
+        *_pwait == zero   - do not wait at all
+    */
+    int submitAndWait(const NanoTime* _pwait)
+    {
+        const bool wait = _pwait == nullptr || _pwait->seconds() != 0 || _pwait->nanoSeconds() != 0;
+
+        if (!wait && to_submit_ == 0 && hasCompletions()) {
+            return 0;
+        }
+
+        io_uring_getevents_arg arg;
+        __kernel_timespec      ts;
+
+        memset(&arg, 0, sizeof(arg));
+        arg.sigmask_sz = _NSIG / 8;
+        if (_pwait != nullptr) {
+            ts.tv_sec  = _pwait->seconds();
+            ts.tv_nsec = _pwait->nanoSeconds();
+            arg.ts     = reinterpret_cast<uint64_t>(&ts);
+        }
+
+        const int rv = static_cast<int>(syscall(
+            __NR_io_uring_enter, fd_, to_submit_, (wait && !hasCompletions()) ? 1U : 0U,
+            IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg)));
+
+        if (rv >= 0) {
+            to_submit_ -= static_cast<unsigned>(rv);
+            return 0;
+        }
+        if (errno == ETIME || errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+            return 0;
+        }
+        return -1;
+    }
+
+    //! Visit completions while _f returns true
+    template <class F>
+    void reap(F _f)
+    {
+        unsigned       head = *cq_head_;
+        const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+
+        while (head != tail && _f(cqes_[head & cq_mask_])) {
+            ++head;
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    }
+
+private:
+    io_uring_sqe& nextSqe()
+    {
+        if ((submit_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE)) >= sq_entries_) {
+            // submission ring full - flush it without waiting
+            const NanoTime nowait;
+            submitAndWait(&nowait);
+        }
+        const unsigned index = submit_tail_ & sq_mask_;
+        io_uring_sqe&  rsqe  = sqes_[index];
+
+        memset(&rsqe, 0, sizeof(rsqe));
+        sq_array_[index] = index;
+        ++submit_tail_;
+        ++to_submit_;
+        __atomic_store_n(sq_tail_, submit_tail_, __ATOMIC_RELEASE);
+        return rsqe;
+    }
+};
+#endif
 //=============================================================================
 
 constexpr size_t min_event_capacity = 32;
 constexpr size_t max_event_capacity = 1024 * 64;
+#if defined(SOLID_USE_IO_URING)
+constexpr unsigned ring_entry_count = 1024;
+#endif
 
 //=============================================================================
 
@@ -156,8 +464,13 @@ using CompletionHandlerDequeT = std::deque<CompletionHandlerStub>;
 using UidVectorT              = std::vector<UniqueId>;
 using ActorDequeT             = std::deque<ActorStub>;
 using SizeStackT              = Stack<size_t>;
-using TimeStoreT              = TimeStore;
 using SizeTVectorT            = std::vector<size_t>;
+using ForwardDequeT           = std::deque<std::pair<NanoTime, size_t>>;
+#if defined(SOLID_FRAME_REACTOR_USE_TIME_WHEEL)
+using TimeStoreT = TimeWheel;
+#else
+using TimeStoreT = TimeStore;
+#endif
 
 } // namespace
 
@@ -238,9 +551,90 @@ struct impl::Reactor::Data {
     UidVectorT              freeuid_vec_;
     ActorDequeT             actor_dq_;
     SizeStackT              completion_handler_index_stk_;
+    ForwardDequeT           forward_dq_; // moved actors' slots, by release time
 #if defined(SOLID_USE_WSAPOLL)
     SizeTVectorT connect_vec_;
 #endif
+#if defined(SOLID_USE_IO_URING)
+    IoUring ring_;
+
+    void ringArmPoll(const size_t _chidx, const int _fd, const uint32_t _events)
+    {
+        CompletionHandlerStub& rch = completion_handler_dq_[_chidx];
+
+        ringDisarmPoll(_chidx);
+
+        rch.poll_fd_     = _fd;
+        rch.poll_events_ = _events;
+        if (_events != 0) {
+            ring_.pollAdd(_fd, _events, ring_poll_user_data(_chidx, rch.poll_unique_));
+        }
+    }
+
+    void ringDisarmPoll(const size_t _chidx)
+    {
+        CompletionHandlerStub& rch = completion_handler_dq_[_chidx];
+
+        if (rch.poll_events_ != 0) {
+            ring_.pollRemove(ring_poll_user_data(_chidx, rch.poll_unique_));
+        }
+        // completions already queued for the old request will be ignored
+        ++rch.poll_unique_;
+        rch.poll_events_ = 0;
+    }
+
+    //! Move ring completions into event_vec_ in epoll_event format
+    size_t ringReap()
+    {
+        size_t count = 0;
+        ring_.reap(
+            [this, &count](io_uring_cqe const& _rcqe) {
+                if (count == event_vec_.size()) {
+                    return false;
+                }
+                if ((_rcqe.user_data & ring_control_tag) != 0) {
+                    return true;
+                }
+
+                const size_t chidx = ring_user_data_index(_rcqe.user_data);
+
+                if (chidx >= completion_handler_dq_.size()) {
+                    return true;
+                }
+
+                CompletionHandlerStub& rch = completion_handler_dq_[chidx];
+
+                if (rch.poll_events_ == 0 || ring_user_data_unique(_rcqe.user_data) != (rch.poll_unique_ & 0x7fffffffU)) {
+                    return true; // stale completion
+                }
+
+                uint32_t events = EPOLLERR;
+
+                if (_rcqe.res >= 0) {
+                    events = static_cast<uint32_t>(_rcqe.res) & (EPOLLIN | EPOLLOUT | EPOLLPRI | EPOLLERR | EPOLLHUP | EPOLLRDHUP);
+                }
+
+                if ((_rcqe.flags & IORING_CQE_F_MORE) == 0) {
+                    // the multishot request was terminated by the kernel
+                    if (_rcqe.res >= 0) {
+                        ringArmPoll(chidx, rch.poll_fd_, rch.poll_events_);
+                    } else {
+                        ++rch.poll_unique_;
+                        rch.poll_events_ = 0;
+                    }
+                }
+
+                if (events != 0) {
+                    epoll_event& rev = event_vec_[count];
+                    rev.events       = events;
+                    rev.data.u64     = chidx;
+                    ++count;
+                }
+                return true;
+            });
+        return count;
+    }
+#endif
 
 #if defined(SOLID_USE_EPOLL2) || defined(SOLID_USE_KQUEUE)
     NanoTime computeWaitDuration(NanoTime const& _rcrt, const bool _can_wait) const
@@ -365,12 +759,23 @@ bool Reactor::start()
 
     doStoreSpecific();
 
+#if defined(SOLID_USE_IO_URING)
+    if (impl_->ring_.init(ring_entry_count)) {
+        solid_log(logger, Info, "reactor uses io_uring");
+    } else {
+        solid_log(logger, Warning, "io_uring not available - fallback to epoll");
+    }
+    if (!impl_->ring_) {
+#endif
 #if defined(SOLID_USE_EPOLL)
-    impl_->reactor_fd_ = epoll_create(min_event_capacity);
-    if (impl_->reactor_fd_ < 0) {
-        solid_log(logger, Error, "reactor create: " << last_system_error().message());
-        return false;
+        impl_->reactor_fd_ = epoll_create(min_event_capacity);
+        if (impl_->reactor_fd_ < 0) {
+            solid_log(logger, Error, "reactor create: " << last_system_error().message());
+            return false;
+        }
+#if defined(SOLID_USE_IO_URING)
     }
+#endif
 #elif defined(SOLID_USE_KQUEUE)
     impl_->reactor_fd_ = kqueue();
     if (impl_->reactor_fd_ < 0) {
@@ -439,9 +844,19 @@ void Reactor::run()
         crtload = actor_count_ + impl_->device_count_ + current_exec_size_;
 #if defined(SOLID_USE_EPOLL2)
         waittime = impl_->computeWaitDuration(impl_->current_time_, current_exec_size_ == 0 && pending_wake_count_.load() == 0);
-
-        solid_log(logger, Verbose, "epoll_wait wait = " << waittime << ' ' << impl_->reactor_fd_ << ' ' << impl_->event_vec_.size());
-        selcnt = epoll_pwait2(impl_->reactor_fd_, impl_->event_vec_.data(), static_cast<int>(impl_->event_vec_.size()), waittime != NanoTime::max() ? &waittime : nullptr, nullptr);
+#if defined(SOLID_USE_IO_URING)
+        if (impl_->ring_) {
+            solid_log(logger, Verbose, "io_uring wait = " << waittime << ' ' << impl_->event_vec_.size());
+            selcnt = impl_->ring_.submitAndWait(waittime != NanoTime::max() ? &waittime : nullptr);
+            if (selcnt == 0) {
+                selcnt = static_cast<long>(impl_->ringReap());
+            }
+        } else
+#endif
+        {
+            solid_log(logger, Verbose, "epoll_wait wait = " << waittime << ' ' << impl_->reactor_fd_ << ' ' << impl_->event_vec_.size());
+            selcnt = epoll_pwait2(impl_->reactor_fd_, impl_->event_vec_.data(), static_cast<int>(impl_->event_vec_.size()), waittime != NanoTime::max() ? &waittime : nullptr, nullptr);
+        }
         if (waittime.seconds() != 0 && waittime.nanoSeconds() != 0) {
             ++waitcnt;
         }
@@ -462,7 +877,8 @@ void Reactor::run()
         solid_log(logger, Verbose, "wsapoll wait msec = " << waitmsec);
         selcnt = WSAPoll(impl_->event_vec_.data(), impl_->event_vec_.size(), waitmsec);
 #endif
-        impl_->current_time_ = NanoTime::nowSteady();
+        impl_->current_time_   = NanoTime::nowSteady();
+        const auto busy_start = steady_clock::now();
 #ifdef SOLID_AIO_TRACE_DURATION
         const auto start = high_resolution_clock::now();
 #endif
@@ -502,10 +918,15 @@ void Reactor::run()
             solid_log(logger, Warning, "reactor loop duration: io " << elapsed_io << " timers " << elapsed_timer << " events " << elapsed_event << " total " << elapsed_total << " execnt " << execnt);
         }
 #endif
-        (void)execnt;
+        if (!impl_->forward_dq_.empty()) [[unlikely]] {
+            doReleaseForwards(impl_->current_time_);
+        }
+        rstatistic_.loop(duration_cast<nanoseconds>(steady_clock::now() - busy_start).count(), (selcnt > 0 ? selcnt : 0) + execnt);
+
         running = impl_->running_ || (actor_count_ != 0) || current_exec_size_ != 0;
     }
     solid_log(logger, Warning, "reactor waitcount = " << waitcnt);
+    solid_log(logger, Statistic, "reactor buffer pool:" << BufferManager::localStatistic());
 
     impl_->event_actor_ptr_->stop();
     doClearSpecific();
@@ -668,7 +1089,7 @@ UniqueId Reactor::actorUid(ReactorContext const& _rctx) const
     return UniqueId(_rctx.actor_index_, impl_->actor_dq_[_rctx.actor_index_].unique_);
 }
 //-----------------------------------------------------------------------------
-void Reactor::addActor(UniqueId const& _uid, Service& _rservice, ActorPointerT&& _actor_ptr)
+void Reactor::addActor(UniqueId const& _uid, Service& _rservice, ActorPointerT&& _actor_ptr, EventBase& _revent)
 {
     if (_uid.index >= impl_->actor_dq_.size()) {
         impl_->actor_dq_.resize(static_cast<size_t>(_uid.index + 1));
@@ -686,14 +1107,61 @@ void Reactor::addActor(UniqueId const& _uid, Service& _rservice, ActorPointerT&&
 
     rstub.actor_ptr_ = std::move(_actor_ptr);
     rstub.pservice_  = &_rservice;
-    rstub.actor_ptr_->registerCompletionHandlers();
+
+    if (_revent == attach_action_event) [[unlikely]] {
+        // moved from another reactor - its completion handlers are already initialized
+        doAttachActor(static_cast<size_t>(_uid.index), *_revent.cast<MigrateStub>());
+        rstatistic_.migrateIn();
+    } else {
+        rstub.actor_ptr_->registerCompletionHandlers();
+    }
+}
+//-----------------------------------------------------------------------------
+Reactor::ExecFunctionT Reactor::wakeExecFunction(UniqueId& _ruid, EventBase const& _revent, ReactorBase*& _rpforward_reactor)
+{
+    ActorStub& ras = impl_->actor_dq_[static_cast<size_t>(_ruid.index)];
+
+    if (ras.unique_ != _ruid.unique) [[unlikely]] {
+        return &call_actor_on_event; // dropped by popExec
+    }
+    if (ras.forward_reactor_ptr_) [[unlikely]] {
+        _ruid              = ras.forward_uid_;
+        _rpforward_reactor = ras.forward_reactor_ptr_.get();
+        return nullptr;
+    }
+    if (_revent == migrate_action_event) [[unlikely]] {
+        ++ras.exec_count_;
+        return &migrate_actor;
+    } else if (_revent == rebalance_action_event) [[unlikely]] {
+        ++ras.exec_count_;
+        return &rebalance_actors;
+    } else if (_revent == broadcast_action_event) [[unlikely]] {
+        ++ras.exec_count_;
+        return &broadcast_actors;
+    } else if (_revent == attach_action_event) [[unlikely]] {
+        return nullptr; // already done by addActor
+    }
+    ++ras.exec_count_;
+    ++ras.event_count_;
+    return &call_actor_on_event;
 }
 //-----------------------------------------------------------------------------
-bool Reactor::isValid(UniqueId const& _actor_uid, UniqueId const& _completion_handler_uid) const
+bool Reactor::popExec(UniqueId const& _actor_uid, UniqueId const& _completion_handler_uid)
 {
-    const ActorStub&             ras(impl_->actor_dq_[static_cast<size_t>(_actor_uid.index)]);
+    ActorStub&                   ras(impl_->actor_dq_[static_cast<size_t>(_actor_uid.index)]);
     const CompletionHandlerStub& rcs(impl_->completion_handler_dq_[static_cast<size_t>(_completion_handler_uid.index)]);
-    return ras.unique_ == _actor_uid.unique && rcs.unique_ == _completion_handler_uid.unique;
+    if (ras.unique_ != _actor_uid.unique) {
+        return false;
+    }
+    --ras.exec_count_;
+    return rcs.unique_ == _completion_handler_uid.unique;
+}
+//-----------------------------------------------------------------------------
+UniqueId Reactor::execActorUid(ReactorContext const& _rctx)
+{
+    ActorStub& ras = impl_->actor_dq_[_rctx.actor_index_];
+    ++ras.exec_count_;
+    return UniqueId(_rctx.actor_index_, ras.unique_);
 }
 //-----------------------------------------------------------------------------
 
@@ -796,6 +1264,343 @@ void Reactor::doStopActor(ReactorContext& _rctx)
 
 //-----------------------------------------------------------------------------
 
+struct impl::Reactor::MigrateStub {
+    struct HandlerStub {
+        CompletionHandler* pcompletion_handler_ = nullptr;
+        int                device_fd_           = -1;
+        uint32_t           device_events_       = 0;
+        bool               is_timer_            = false;
+        bool               timer_pending_       = false;
+    };
+    std::vector<HandlerStub> handler_vec_;
+};
+
+//-----------------------------------------------------------------------------
+
+/*static*/ Reactor::MigrateEventT Reactor::migrate_event(ReactorBasePtrT&& _reactor_ptr)
+{
+    return MigrateEventT(reactor_action_category, ReactorActionE::Migrate, MigrateRequest{std::move(_reactor_ptr)});
+}
+
+//-----------------------------------------------------------------------------
+
+void Reactor::rebalance(ReactorBasePtrT&& _reactor_ptr, const double _load_fraction, const size_t _max_actor_count)
+{
+    // handled by the event actor
+    wake(UniqueId(0, 0), make_event(reactor_action_category, ReactorActionE::Rebalance, RebalanceRequest{std::move(_reactor_ptr), _load_fraction, _max_actor_count}));
+}
+
+//-----------------------------------------------------------------------------
+
+void Reactor::wakeAll(std::vector<UniqueId>&& _ruid_vec, EventBase const& _revent)
+{
+    // handled by the event actor
+    wake(UniqueId(0, 0), make_event(reactor_action_category, ReactorActionE::Broadcast, BroadcastRequest{std::move(_ruid_vec), _revent}));
+}
+
+//-----------------------------------------------------------------------------
+
+/*static*/ void Reactor::migrate_actor(ReactorContext& _rctx, EventBase&& _uevent)
+{
+    Reactor&        rthis    = _rctx.reactor();
+    MigrateRequest* prequest = _uevent.cast<MigrateRequest>();
+
+    if (prequest == nullptr || !prequest->reactor_ptr_ || prequest->reactor_ptr_.get() == &rthis) {
+        return;
+    }
+
+    if (rthis.impl_->actor_dq_[_rctx.actor_index_].exec_count_ != 0 && prequest->retry_count_ < migrate_retry_count) {
+        // there are posts and events still to be delivered to the actor - retry after them
+        ++prequest->retry_count_;
+        rthis.doPost(_rctx, &migrate_actor, std::move(_uevent));
+        return;
+    }
+
+    if (!rthis.doMigrateActor(_rctx, static_cast<Reactor&>(*prequest->reactor_ptr_))) {
+        rthis.rstatistic_.migrateFail();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+/*static*/ void Reactor::rebalance_actors(ReactorContext& _rctx, EventBase&& _uevent)
+{
+    if (RebalanceRequest* prequest = _uevent.cast<RebalanceRequest>(); prequest != nullptr && prequest->reactor_ptr_) {
+        _rctx.reactor().doRebalance(_rctx, *prequest);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+/*static*/ void Reactor::broadcast_actors(ReactorContext& _rctx, EventBase&& _uevent)
+{
+    if (BroadcastRequest* prequest = _uevent.cast<BroadcastRequest>(); prequest != nullptr) {
+        _rctx.reactor().doBroadcast(*prequest);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Reactor::doBroadcast(BroadcastRequest& _rrequest)
+{
+    const UniqueId completion_handler_uid = impl_->dummyCompletionHandlerUid();
+
+    for (auto uid : _rrequest.uid_vec_) {
+        ReactorBase* pforward_reactor = nullptr;
+
+        if (const auto exec_fnc = wakeExecFunction(uid, _rrequest.event_, pforward_reactor); exec_fnc != nullptr) [[likely]] {
+            doPushExec(uid, exec_fnc, completion_handler_uid, _rrequest.event_);
+        } else if (pforward_reactor != nullptr) {
+            // the actor was moved onto another reactor
+            pforward_reactor->wake(uid, _rrequest.event_);
+        }
+    }
+    rstatistic_.broadcast(_rrequest.uid_vec_.size());
+}
+
+//-----------------------------------------------------------------------------
+
+bool Reactor::doMigrateActor(ReactorContext& _rctx, Reactor& _rreactor)
+{
+#if defined(SOLID_USE_EPOLL)
+    const size_t actor_index = _rctx.actor_index_;
+    ActorStub&   ras         = impl_->actor_dq_[actor_index];
+
+    if (!ras.actor_ptr_ || ras.forward_reactor_ptr_ || !ras.actor_ptr_->isMigratable() || ras.exec_count_ != 0 || !_rreactor.impl_->running_) {
+        return false;
+    }
+
+    Actor&      ract = *ras.actor_ptr_;
+    Service&    rsvc = *ras.pservice_;
+    MigrateStub stub;
+
+    doDetachActor(ract, stub);
+
+    UniqueId          new_uid;
+    ActorPointerT     actor_ptr = ras.actor_ptr_;
+    ScheduleFunctionT fct([&actor_ptr, &rsvc, &stub, &new_uid, &ract](ReactorBase& _rreactor) {
+        // called under the actor's mutex - notifications to the actor follow the attach event
+        if (static_cast<Reactor&>(_rreactor).doPushActor(std::move(actor_ptr), rsvc, make_event(reactor_action_category, ReactorActionE::Attach, std::move(stub)))) {
+            new_uid = ract.runId();
+            return true;
+        }
+        return false;
+    });
+
+    if (moveActor(ract, rsvc.manager(), _rreactor, fct)) {
+        solid_log(logger, Info, "actor " << &ract << " moved from " << this << " to " << &_rreactor << " as " << new_uid);
+        ras.forward_reactor_ptr_ = _rreactor.shared_from_this();
+        ras.forward_uid_         = new_uid;
+        ras.actor_ptr_.reset();
+        ras.pservice_ = nullptr;
+        --actor_count_;
+        rstatistic_.actorCount(actor_count_);
+        rstatistic_.migrateOut();
+        impl_->forward_dq_.emplace_back(_rctx.nanoTime() + forward_timeout, actor_index);
+        return true;
+    }
+
+    // the actor is stopping - it stays with us
+    doAttachActor(actor_index, stub);
+    return false;
+#else
+    (void)_rctx;
+    (void)_rreactor;
+    return false;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+/*NOTE:
+    Unlike unregisterCompletionHandler, the completion handlers are not notified -
+    they keep their devices and timers to be attached onto the target reactor.
+*/
+void Reactor::doDetachActor(Actor& _ract, MigrateStub& _rstub)
+{
+#if defined(SOLID_USE_EPOLL)
+    for (CompletionHandler* pch = _ract.pnext; pch != nullptr; pch = pch->pnext) {
+        if (!pch->isActive()) {
+            continue;
+        }
+        const size_t           chidx = pch->idxreactor;
+        CompletionHandlerStub& rcs   = impl_->completion_handler_dq_[chidx];
+        auto&                  rhs   = _rstub.handler_vec_.emplace_back();
+
+        rhs.pcompletion_handler_ = pch;
+        rhs.device_fd_           = rcs.device_fd_;
+        rhs.device_events_       = rcs.device_events_;
+        rhs.is_timer_            = rcs.is_timer_;
+
+        if (rcs.device_fd_ != -1) {
+#if defined(SOLID_USE_IO_URING)
+            if (impl_->ring_) {
+                impl_->ringDisarmPoll(chidx);
+            } else
+#endif
+            {
+                epoll_event ev;
+                if (epoll_ctl(impl_->reactor_fd_, EPOLL_CTL_DEL, rcs.device_fd_, &ev) != 0) {
+                    solid_log(logger, Error, "epoll_ctl: " << last_system_error().message());
+                }
+            }
+            --impl_->device_count_;
+        }
+
+        if (rcs.is_timer_) {
+            SteadyTimer& rtimer = *static_cast<SteadyTimer*>(pch);
+            if (rtimer.storeidx_ != InvalidIndex()) {
+                impl_->time_store_.pop(rtimer.storeidx_);
+                rtimer.storeidx_   = InvalidIndex();
+                rhs.timer_pending_ = true;
+            }
+        }
+
+        impl_->completion_handler_index_stk_.push(chidx);
+        rcs.pcompletion_handler_ = &impl_->event_actor_ptr_->dummy_handler_;
+        rcs.actor_idx_           = 0;
+        rcs.device_fd_           = -1;
+        rcs.device_events_       = 0;
+        rcs.is_timer_            = false;
+        ++rcs.unique_;
+        pch->idxreactor = InvalidIndex();
+    }
+#else
+    (void)_ract;
+    (void)_rstub;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+void Reactor::doAttachActor(const size_t _actor_index, MigrateStub& _rstub)
+{
+#if defined(SOLID_USE_EPOLL)
+    for (auto& rhs : _rstub.handler_vec_) {
+        size_t chidx;
+
+        if (!impl_->completion_handler_index_stk_.empty()) {
+            chidx = impl_->completion_handler_index_stk_.top();
+            impl_->completion_handler_index_stk_.pop();
+        } else {
+            chidx = impl_->completion_handler_dq_.size();
+            impl_->completion_handler_dq_.push_back(CompletionHandlerStub());
+        }
+
+        CompletionHandlerStub& rcs = impl_->completion_handler_dq_[chidx];
+
+        rcs.actor_idx_           = _actor_index;
+        rcs.pcompletion_handler_ = rhs.pcompletion_handler_;
+        rcs.is_timer_            = rhs.is_timer_;
+        rcs.device_fd_           = rhs.device_fd_;
+        rcs.device_events_       = rhs.device_events_;
+
+        rhs.pcompletion_handler_->idxreactor = chidx;
+
+        if (rhs.device_fd_ != -1) {
+#if defined(SOLID_USE_IO_URING)
+            if (impl_->ring_) {
+                impl_->ringArmPoll(chidx, rhs.device_fd_, rhs.device_events_ & ~EPOLLET);
+            } else
+#endif
+            {
+                epoll_event ev;
+                ev.data.u64 = chidx;
+                ev.events   = rhs.device_events_;
+                if (epoll_ctl(impl_->reactor_fd_, EPOLL_CTL_ADD, rhs.device_fd_, &ev) != 0) {
+                    solid_log(logger, Error, "epoll_ctl: " << last_system_error().message());
+                }
+            }
+            ++impl_->device_count_;
+            if (impl_->device_count_ > impl_->event_vec_.size()) {
+                impl_->event_vec_.resize(impl_->device_count_);
+                impl_->event_vec_.resize(impl_->event_vec_.capacity());
+            }
+        }
+
+        if (rhs.timer_pending_) {
+            SteadyTimer& rtimer = *static_cast<SteadyTimer*>(rhs.pcompletion_handler_);
+            rtimer.storeidx_    = impl_->time_store_.push(impl_->current_time_, rtimer.expiry_, chidx);
+        }
+    }
+#else
+    (void)_actor_index;
+    (void)_rstub;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+/*NOTE:
+    The load of an actor is the number of events and posts it got since
+    the previous rebalance. The busiest actors fitting the requested
+    fraction of the reactor's load are moved.
+*/
+void Reactor::doRebalance(ReactorContext& _rctx, RebalanceRequest& _rrequest)
+{
+    if (_rrequest.reactor_ptr_.get() == this) {
+        return;
+    }
+    uint64_t                                 total_count = 0;
+    std::vector<std::pair<uint64_t, size_t>> candidate_vec;
+
+    for (size_t i = 1; i < impl_->actor_dq_.size(); ++i) {
+        ActorStub& ras = impl_->actor_dq_[i];
+        if (!ras.actor_ptr_) {
+            continue;
+        }
+        total_count += ras.event_count_;
+        if (ras.actor_ptr_->isMigratable() && ras.exec_count_ == 0 && ras.event_count_ != 0) {
+            candidate_vec.emplace_back(ras.event_count_, i);
+        }
+        ras.event_count_ = 0;
+    }
+
+    std::sort(
+        candidate_vec.begin(), candidate_vec.end(),
+        [](const auto& _a, const auto& _b) {
+            return _a.first > _b.first;
+        });
+
+    auto&        rreactor        = static_cast<Reactor&>(*_rrequest.reactor_ptr_);
+    uint64_t     remaining_count = static_cast<uint64_t>(static_cast<double>(total_count) * _rrequest.load_fraction_);
+    size_t       moved_count     = 0;
+    const size_t event_actor_idx = _rctx.actor_index_;
+
+    for (const auto& candidate : candidate_vec) {
+        if (moved_count >= _rrequest.max_actor_count_ || remaining_count == 0) {
+            break;
+        }
+        if (candidate.first > remaining_count) {
+            continue;
+        }
+        _rctx.actor_index_ = candidate.second;
+        if (doMigrateActor(_rctx, rreactor)) {
+            remaining_count -= candidate.first;
+            ++moved_count;
+        } else {
+            rstatistic_.migrateFail();
+        }
+    }
+    _rctx.actor_index_ = event_actor_idx;
+    solid_log(logger, Info, "moved " << moved_count << " actors out of " << candidate_vec.size() << " onto " << &rreactor);
+}
+
+//-----------------------------------------------------------------------------
+
+void Reactor::doReleaseForwards(NanoTime const& _rcrttime)
+{
+    while (!impl_->forward_dq_.empty() && impl_->forward_dq_.front().first <= _rcrttime) {
+        const size_t actor_index = impl_->forward_dq_.front().second;
+        ActorStub&   ras         = impl_->actor_dq_[actor_index];
+
+        impl_->forward_dq_.pop_front();
+
+        ras.clear();
+        impl_->freeuid_vec_.push_back(UniqueId(actor_index, ras.unique_));
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 void Reactor::doCompleteIo(NanoTime const& _rcrttime, const size_t _sz)
 {
     ReactorContext ctx(*this, _rcrttime);
@@ -837,6 +1642,7 @@ void Reactor::doCompleteIo(NanoTime const& _rcrttime, const size_t _sz)
         }
 #endif
         ctx.actor_index_ = rch.actor_idx_;
+        ++impl_->actor_dq_[rch.actor_idx_].event_count_;
 
         rch.pcompletion_handler_->handleCompletion(ctx);
         ctx.clearError();
@@ -948,7 +1754,20 @@ bool Reactor::addDevice(ReactorContext& _rctx, Device const& _rsd, const Reactor
     solid_log(logger, Info, _rsd.descriptor());
 
     // solid_assert(_rctx.channel_index_ == _rch.idxreactor);
-
+#if defined(SOLID_USE_EPOLL)
+    impl_->completion_handler_dq_[_rctx.completion_heandler_index_].device_fd_     = _rsd.Device::descriptor();
+    impl_->completion_handler_dq_[_rctx.completion_heandler_index_].device_events_ = reactorRequestsToSystemEvents(_req);
+#endif
+#if defined(SOLID_USE_IO_URING)
+    if (impl_->ring_) {
+        impl_->ringArmPoll(_rctx.completion_heandler_index_, _rsd.Device::descriptor(), reactorRequestsToSystemEvents(_req) & ~EPOLLET);
+        ++impl_->device_count_;
+        if (impl_->device_count_ == (impl_->event_vec_.size() + 1)) {
+            impl_->event_actor_ptr_->post(_rctx, &Reactor::increase_event_vector_size);
+        }
+        return true;
+    }
+#endif
 #if defined(SOLID_USE_EPOLL)
     epoll_event ev;
     ev.data.u64 = _rctx.completion_heandler_index_;
@@ -1031,6 +1850,15 @@ bool Reactor::addDevice(ReactorContext& _rctx, Device const& _rsd, const Reactor
 bool Reactor::modDevice(ReactorContext& _rctx, Device const& _rsd, const ReactorWaitRequestE _req)
 {
     solid_log(logger, Info, _rsd.descriptor());
+#if defined(SOLID_USE_EPOLL)
+    impl_->completion_handler_dq_[_rctx.completion_heandler_index_].device_events_ = reactorRequestsToSystemEvents(_req);
+#endif
+#if defined(SOLID_USE_IO_URING)
+    if (impl_->ring_) {
+        impl_->ringArmPoll(_rctx.completion_heandler_index_, _rsd.Device::descriptor(), reactorRequestsToSystemEvents(_req) & ~EPOLLET);
+        return true;
+    }
+#endif
 #if defined(SOLID_USE_EPOLL)
     epoll_event ev;
 
@@ -1113,6 +1941,22 @@ bool Reactor::modDevice(ReactorContext& _rctx, Device const& _rsd, const Reactor
 bool Reactor::remDevice(CompletionHandler const& _rch, Device const& _rsd)
 {
     solid_log(logger, Info, _rsd.descriptor());
+#if defined(SOLID_USE_EPOLL)
+    if (_rch.isActive()) {
+        impl_->completion_handler_dq_[_rch.idxreactor].device_fd_     = -1;
+        impl_->completion_handler_dq_[_rch.idxreactor].device_events_ = 0;
+    }
+#endif
+#if defined(SOLID_USE_IO_URING)
+    if (impl_->ring_) {
+        if (!_rsd) {
+            return false;
+        }
+        impl_->ringDisarmPoll(_rch.idxreactor);
+        --impl_->device_count_;
+        return true;
+    }
+#endif
 #if defined(SOLID_USE_EPOLL)
     epoll_event ev;
 
@@ -1162,6 +2006,7 @@ bool Reactor::remDevice(CompletionHandler const& _rch, Device const& _rsd)
 
 bool Reactor::addTimer(CompletionHandler const& _rch, NanoTime const& _rt, size_t& _rstoreidx)
 {
+    impl_->completion_handler_dq_[_rch.idxreactor].is_timer_ = true;
     if (_rstoreidx != InvalidIndex()) {
         impl_->time_store_.update(_rstoreidx, impl_->current_time_, _rt);
     } else {
@@ -1242,10 +2087,20 @@ void Reactor::unregisterCompletionHandler(CompletionHandler& _rch)
 
         _rch.handleCompletion(ctx);
     }
+#if defined(SOLID_USE_IO_URING)
+    if (impl_->ring_ && rcs.poll_events_ != 0) {
+        // the poll request holds a reference to the file - make sure it goes away
+        impl_->ringDisarmPoll(_rch.idxreactor);
+        --impl_->device_count_;
+    }
+#endif
 
     impl_->completion_handler_index_stk_.push(_rch.idxreactor);
     rcs.pcompletion_handler_ = &impl_->event_actor_ptr_->dummy_handler_;
     rcs.actor_idx_           = 0;
+    rcs.device_fd_           = -1;
+    rcs.device_events_       = 0;
+    rcs.is_timer_            = false;
     ++rcs.unique_;
 }
 
@@ -1442,21 +2297,35 @@ std::ostream& ReactorStatistic::print(std::ostream& _ros) const
     _ros << " max_exec_size = " << max_exec_size_;
     _ros << " actor_count = " << actor_count_;
     _ros << " max_actor_count = " << max_actor_count_;
+    _ros << " event_count = " << event_count_;
+    _ros << " busy_time_ns = " << busy_time_ns_;
+    _ros << " migrate_in_count = " << migrate_in_count_;
+    _ros << " migrate_out_count = " << migrate_out_count_;
+    _ros << " migrate_fail_count = " << migrate_fail_count_;
+    _ros << " broadcast_count = " << broadcast_count_;
+    _ros << " broadcast_actor_count = " << broadcast_actor_count_;
     return _ros;
 }
 
 void ReactorStatistic::clear()
 {
     ReactorStatisticBase::clear();
-    push_notify_count_ = 0;
-    push_count_        = 0;
-    wake_notify_count_ = 0;
-    wake_count_        = 0;
-    post_count_        = 0;
-    post_stop_count_   = 0;
-    max_exec_size_     = 0;
-    actor_count_       = 0;
-    max_actor_count_   = 0;
+    push_notify_count_     = 0;
+    push_count_            = 0;
+    wake_notify_count_     = 0;
+    wake_count_            = 0;
+    post_count_            = 0;
+    post_stop_count_       = 0;
+    max_exec_size_         = 0;
+    actor_count_           = 0;
+    max_actor_count_       = 0;
+    event_count_           = 0;
+    busy_time_ns_          = 0;
+    migrate_in_count_      = 0;
+    migrate_out_count_     = 0;
+    migrate_fail_count_    = 0;
+    broadcast_count_       = 0;
+    broadcast_actor_count_ = 0;
 }
 
 } // namespace aio
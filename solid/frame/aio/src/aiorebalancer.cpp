@@ -0,0 +1,55 @@
+// solid/frame/aio/src/aiorebalancer.cpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#include "solid/frame/aio/aiorebalancer.hpp"
+
+namespace solid {
+namespace frame {
+namespace aio {
+
+RebalancePlan rebalance_plan(
+    RebalancerConfiguration const& _rconfig,
+    std::vector<uint64_t> const&   _busy_time_ns_vec,
+    const std::chrono::nanoseconds _period)
+{
+    RebalancePlan plan;
+
+    if (_busy_time_ns_vec.size() < 2 || _period.count() <= 0) {
+        return plan;
+    }
+
+    size_t hot_index  = 0;
+    size_t cold_index = 0;
+
+    for (size_t i = 1; i < _busy_time_ns_vec.size(); ++i) {
+        if (_busy_time_ns_vec[i] > _busy_time_ns_vec[hot_index]) {
+            hot_index = i;
+        }
+        if (_busy_time_ns_vec[i] < _busy_time_ns_vec[cold_index]) {
+            cold_index = i;
+        }
+    }
+
+    const double hot  = static_cast<double>(_busy_time_ns_vec[hot_index]);
+    const double cold = static_cast<double>(_busy_time_ns_vec[cold_index]);
+
+    if (hot < _rconfig.min_busy_fraction * static_cast<double>(_period.count()) || hot < _rconfig.imbalance_ratio * cold) {
+        return plan;
+    }
+
+    plan.from_index_    = hot_index;
+    plan.to_index_      = cold_index;
+    plan.load_fraction_ = (hot - cold) / (2 * hot);
+    return plan;
+}
+
+} // namespace aio
+} // namespace frame
+} // namespace solid
@@ -0,0 +1,298 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aiorebalancer.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <optional>
+#include <thread>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::ReactorT>;
+
+namespace {
+
+const solid::LoggerT logger("test");
+
+// Echoes the bytes received on its socket, ticks a timer and reports the thread of its events
+class Mover final : public frame::aio::Actor {
+    using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
+
+    frame::aio::SteadyTimer  timer_;
+    optional<StreamSocketT>  sock_;
+    char                     buf_[256];
+    atomic<size_t>           tick_count_{0};
+    atomic<std::thread::id>  thread_id_;
+    promise<std::thread::id> wake_prom_;
+
+public:
+    Mover(const bool _migratable, SocketDevice&& _rsd = SocketDevice())
+        : timer_(this->proxy())
+    {
+        if (_rsd) {
+            sock_.emplace(this->proxy(), std::move(_rsd));
+        }
+        migratable(_migratable);
+    }
+
+    size_t tickCount() const
+    {
+        return tick_count_;
+    }
+
+    std::thread::id threadId() const
+    {
+        return thread_id_;
+    }
+
+    future<std::thread::id> expectWake()
+    {
+        wake_prom_ = promise<std::thread::id>();
+        return wake_prom_.get_future();
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, EventBase&& _revent) override
+    {
+        thread_id_ = this_thread::get_id();
+        if (_revent == generic_event<GenericEventE::Start>) {
+            startTimer(_rctx);
+            if (sock_) {
+                sock_->postRecvSome(_rctx, buf_, sizeof(buf_), Mover::onRecv);
+            }
+        } else if (_revent == generic_event<GenericEventE::Wake>) {
+            wake_prom_.set_value(this_thread::get_id());
+        } else if (_revent == generic_event<GenericEventE::Kill>) {
+            postStop(_rctx);
+        }
+    }
+
+    void startTimer(frame::aio::ReactorContext& _rctx)
+    {
+        timer_.waitFor(_rctx, std::chrono::milliseconds(20), [this](frame::aio::ReactorContext& _rctx) {
+            thread_id_ = this_thread::get_id();
+            ++tick_count_;
+            startTimer(_rctx);
+        });
+    }
+
+    static void onRecv(frame::aio::ReactorContext& _rctx, size_t _sz)
+    {
+        Mover& rthis = static_cast<Mover&>(_rctx.actor());
+        if (_rctx.error() || _sz == 0) {
+            rthis.postStop(_rctx);
+            return;
+        }
+        rthis.thread_id_ = this_thread::get_id();
+        rthis.sock_->postSendAll(_rctx, rthis.buf_, _sz, Mover::onSend);
+    }
+
+    static void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        Mover& rthis = static_cast<Mover&>(_rctx.actor());
+        if (!_rctx.error()) {
+            rthis.sock_->postRecvSome(_rctx, rthis.buf_, sizeof(rthis.buf_), Mover::onRecv);
+        }
+    }
+};
+
+template <class Fnc>
+void wait_until(Fnc&& _fnc, const char* _what)
+{
+    for (int i = 0; i < 1000 && !_fnc(); ++i) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    solid_check(_fnc(), "timeout waiting for: " << _what);
+}
+
+// A connected pair: the first end for the actor, the second, blocking, for the test
+pair<SocketDevice, SocketDevice> make_connection()
+{
+    ResolveData   rd = synchronous_resolve("127.0.0.1", "0", 0, SocketInfo::Inet4, SocketInfo::Stream);
+    SocketDevice  lsd;
+    SocketDevice  csd;
+    SocketDevice  ssd;
+    SocketAddress local_address;
+
+    solid_check(!lsd.create(rd.begin()));
+    solid_check(!lsd.prepareAccept(rd.begin(), 1));
+    solid_check(!lsd.localAddress(local_address));
+    solid_check(!csd.create(rd.begin()));
+    solid_check(!csd.connect(local_address));
+    solid_check(!lsd.accept(ssd));
+    solid_check(!ssd.makeNonBlocking());
+    solid_check(!csd.makeBlocking(10 * 1000));
+    return {std::move(ssd), std::move(csd)};
+}
+
+void echo(SocketDevice& _rsd, const string& _msg)
+{
+    bool       can_retry = false;
+    ErrorCodeT err;
+    solid_check(_rsd.send(_msg.data(), _msg.size(), can_retry, err) == static_cast<ssize_t>(_msg.size()), "send: " << err.message());
+
+    string reply;
+    char   buf[256];
+    while (reply.size() < _msg.size()) {
+        const ssize_t rv = _rsd.recv(buf, sizeof(buf), can_retry, err);
+        solid_check(rv > 0, "recv: " << err.message());
+        reply.append(buf, rv);
+    }
+    solid_check(reply == _msg, "echo mismatch");
+}
+
+std::thread::id wake(frame::Manager& _rmanager, frame::ActorIdT const& _id, Mover& _ract)
+{
+    auto fut = _ract.expectWake();
+    solid_check(_rmanager.notify(_id, make_event(GenericEventE::Wake)));
+    solid_check(fut.wait_for(chrono::seconds(10)) == future_status::ready, "wake not delivered");
+    return fut.get();
+}
+
+void test_plan()
+{
+    frame::aio::RebalancerConfiguration config;
+    config.imbalance_ratio   = 1.5;
+    config.min_busy_fraction = 0.1;
+
+    const auto period = chrono::nanoseconds(1000);
+
+    solid_check(frame::aio::rebalance_plan(config, {500, 500}, period).empty());   // balanced
+    solid_check(frame::aio::rebalance_plan(config, {90, 10}, period).empty());     // not busy enough
+    solid_check(frame::aio::rebalance_plan(config, {600}, period).empty());        // a single reactor
+    const auto plan = frame::aio::rebalance_plan(config, {200, 800, 400}, period); // 1 -> 0
+    solid_check(plan.from_index_ == 1 && plan.to_index_ == 0);
+    solid_check(plan.load_fraction_ > 0.37 && plan.load_fraction_ < 0.38);
+}
+
+} // namespace
+
+// Moves actors, with their timers and sockets, between the reactors of a scheduler.
+int test_actor_migration(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWX"});
+
+    size_t actor_count = 20;
+    if (argc > 1) {
+        actor_count = atoi(argv[1]);
+    }
+
+    test_plan();
+
+    AioSchedulerT   sch;
+    frame::Manager  manager;
+    frame::ServiceT service{manager};
+
+    sch.start(2);
+
+    auto& rstat0 = sch.statistic().reactorStatistic(0);
+    auto& rstat1 = sch.statistic().reactorStatistic(1);
+
+    { // a timer and a socket follow the actor
+        auto [actor_sd, test_sd] = make_connection();
+        ErrorConditionT err;
+        auto            actor_ptr = make_shared<Mover>(true, std::move(actor_sd));
+        auto&           ract      = *actor_ptr;
+        const auto      id        = sch.startActor(std::move(actor_ptr), service, 0, make_event(GenericEventE::Start), err);
+        solid_check(!err, "start actor: " << err.message());
+
+        echo(test_sd, "before the move");
+        wait_until([&ract]() { return ract.tickCount() >= 2; }, "timer before the move");
+        const auto thread0 = wake(manager, id, ract);
+
+        solid_check(sch.migrateActor(manager, id, 1));
+        wait_until([&rstat1]() { return rstat1.migrate_in_count_ == 1; }, "the move");
+        solid_check(rstat0.migrate_out_count_ == 1);
+
+        const auto thread1 = wake(manager, id, ract);
+        solid_check(thread0 != thread1, "the actor did not move");
+
+        const size_t tick_count = ract.tickCount();
+        wait_until([&ract, tick_count]() { return ract.tickCount() >= tick_count + 2; }, "timer after the move");
+        solid_check(ract.threadId() == thread1);
+
+        echo(test_sd, "after the move - a longer message");
+        solid_check(ract.threadId() == thread1);
+
+        // and back
+        solid_check(sch.migrateActor(manager, id, 0));
+        wait_until([&rstat0]() { return rstat0.migrate_in_count_ == 1; }, "the move back");
+        solid_check(wake(manager, id, ract) == thread0);
+        echo(test_sd, "back home");
+
+        manager.notify(id, make_event(GenericEventE::Kill));
+    }
+
+    { // not migratable - stays where it is
+        ErrorConditionT err;
+        auto            actor_ptr = make_shared<Mover>(false);
+        auto&           ract      = *actor_ptr;
+        const auto      id        = sch.startActor(std::move(actor_ptr), service, 0, make_event(GenericEventE::Start), err);
+        solid_check(!err, "start actor: " << err.message());
+
+        const auto   thread0    = wake(manager, id, ract);
+        const size_t fail_count = rstat0.migrate_fail_count_;
+        solid_check(sch.migrateActor(manager, id, 1));
+        wait_until([&rstat0, fail_count]() { return rstat0.migrate_fail_count_ == fail_count + 1; }, "the refused move");
+        solid_check(wake(manager, id, ract) == thread0);
+
+        manager.notify(id, make_event(GenericEventE::Kill));
+    }
+
+    { // rebalance: the busy actors of reactor 0 are moved onto reactor 1
+        vector<frame::ActorIdT> id_vec;
+        vector<Mover*>          actor_vec;
+        for (size_t i = 0; i < actor_count; ++i) {
+            ErrorConditionT err;
+            auto            actor_ptr = make_shared<Mover>(true);
+            actor_vec.emplace_back(actor_ptr.get());
+            id_vec.emplace_back(sch.startActor(std::move(actor_ptr), service, 0, make_event(GenericEventE::Start), err));
+            solid_check(!err, "start actor: " << err.message());
+        }
+        for (size_t i = 0; i < actor_count; ++i) {
+            wake(manager, id_vec[i], *actor_vec[i]);
+        }
+
+        const size_t out_count = rstat0.migrate_out_count_;
+        solid_check(sch.rebalanceWorkers(0, 1, 0.5, actor_count));
+        wait_until([&rstat0, out_count]() { return rstat0.migrate_out_count_ > out_count; }, "the rebalance");
+        solid_check(rstat0.migrate_out_count_ - out_count < actor_count, "moved more than the requested load");
+
+        // the Rebalancer thread runs without disturbing the actors
+        frame::aio::RebalancerConfiguration config;
+        config.period = chrono::milliseconds(20);
+        frame::aio::Rebalancer<AioSchedulerT> rebalancer(sch, config);
+        rebalancer.start();
+
+        for (size_t i = 0; i < actor_count; ++i) {
+            wake(manager, id_vec[i], *actor_vec[i]);
+        }
+        this_thread::sleep_for(chrono::milliseconds(100));
+        rebalancer.stop();
+
+        for (size_t i = 0; i < actor_count; ++i) {
+            wake(manager, id_vec[i], *actor_vec[i]);
+            manager.notify(id_vec[i], make_event(GenericEventE::Kill));
+        }
+    }
+
+    solid_log(logger, Statistic, "scheduler statistic: " << sch.statistic());
+    sch.stop();
+    return 0;
+}
@@ -0,0 +1,406 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiodatagram.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+//-----------------------------------------------------------------------------
+namespace {
+using AioSchedulerT = frame::Scheduler<frame::aio::ReactorT>;
+using DatagramT     = frame::aio::Datagram<frame::aio::Socket>;
+
+enum struct ModeE {
+    Single,  // one recvfrom/sendto per datagram
+    Batch,   // recvmmsg/sendmmsg
+    Segment, // recvmmsg/sendmmsg with UDP_GRO/UDP_SEGMENT
+};
+
+constexpr size_t batch_capacity        = 64;
+constexpr size_t payload_size          = 64;
+constexpr size_t segment_buf_capacity  = 64 * 1024;
+constexpr size_t datagram_buf_capacity = 2 * 1024;
+
+ModeE              mode                   = ModeE::Single;
+size_t             window_size            = batch_capacity;
+size_t             round_count            = 10000;
+unsigned           wait_seconds           = 100;
+mutex              mtx;
+condition_variable cnd;
+bool               client_done            = false;
+size_t             client_recv_call_count = 0;
+
+size_t datagram_count(const DatagramBuffer& _rbuf)
+{
+    if (_rbuf.segment_size_ == 0) {
+        return 1;
+    }
+    return (_rbuf.size_ + _rbuf.segment_size_ - 1) / _rbuf.segment_size_;
+}
+
+// Receives batches of datagrams and echoes them back to their sources.
+class Server final : public frame::aio::Actor {
+public:
+    Server(SocketDevice&& _rsd)
+        : sock_(this->proxy(), std::move(_rsd))
+        , data_(batch_capacity * (mode == ModeE::Segment ? segment_buf_capacity : datagram_buf_capacity))
+    {
+        const size_t capacity = data_.size() / batch_capacity;
+        for (size_t i = 0; i < batch_capacity; ++i) {
+            buf_vec_.emplace_back(data_.data() + i * capacity, capacity);
+        }
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, EventBase&& _revent) override
+    {
+        if (generic_event<GenericEventE::Start> == _revent) {
+            doRecv(_rctx);
+        } else if (generic_event<GenericEventE::Kill> == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void doRecv(frame::aio::ReactorContext& _rctx)
+    {
+        while (true) {
+            size_t recv_count = 0;
+            if (mode == ModeE::Single) {
+                DatagramBuffer& rbuf = buf_vec_.front();
+                if (!sock_.recvFrom(
+                        _rctx, rbuf.data_, rbuf.capacity_,
+                        [this](frame::aio::ReactorContext& _rctx, SocketAddress& _raddr, size_t _sz) {
+                            buf_vec_.front().address_ = _raddr;
+                            buf_vec_.front().size_    = _sz;
+                            if (onRecv(_rctx, 1)) {
+                                doRecv(_rctx);
+                            }
+                        },
+                        rbuf.address_, rbuf.size_)) {
+                    return;
+                }
+                recv_count = 1;
+            } else if (!sock_.recvFromMany(
+                           _rctx, buf_vec_.data(), buf_vec_.size(),
+                           [this](frame::aio::ReactorContext& _rctx, size_t _count) {
+                               if (onRecv(_rctx, _count)) {
+                                   doRecv(_rctx);
+                               }
+                           },
+                           recv_count)) {
+                return;
+            }
+
+            if (!onRecv(_rctx, recv_count)) {
+                return;
+            }
+        }
+    }
+
+    // returns true if the echo was sent and we can receive again
+    bool onRecv(frame::aio::ReactorContext& _rctx, size_t _count)
+    {
+        if (_rctx.error()) {
+            solid_log(generic_logger, Error, "server recv error: " << _rctx.error().message() << " " << _rctx.systemError().message());
+            postStop(_rctx);
+            return false;
+        }
+
+        auto on_send = [this](frame::aio::ReactorContext& _rctx) {
+            if (onSend(_rctx)) {
+                doRecv(_rctx);
+            }
+        };
+
+        if (mode == ModeE::Single) {
+            const DatagramBuffer& rbuf = buf_vec_.front();
+            if (!sock_.sendTo(_rctx, rbuf.data_, rbuf.size_, rbuf.address_, on_send)) {
+                return false;
+            }
+        } else if (!sock_.sendToMany(_rctx, buf_vec_.data(), _count, on_send)) {
+            return false;
+        }
+        return onSend(_rctx);
+    }
+
+    bool onSend(frame::aio::ReactorContext& _rctx)
+    {
+        if (_rctx.error()) {
+            solid_log(generic_logger, Error, "server send error: " << _rctx.error().message() << " " << _rctx.systemError().message());
+            postStop(_rctx);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    DatagramT              sock_;
+    vector<char>           data_;
+    vector<DatagramBuffer> buf_vec_;
+};
+
+// Sends windows of window_size datagrams and waits for all of them to be echoed back.
+class Client final : public frame::aio::Actor {
+public:
+    Client(SocketDevice&& _rsd, const SocketAddress& _server_addr)
+        : sock_(this->proxy(), std::move(_rsd))
+        , payload_(mode == ModeE::Segment ? window_size * payload_size : payload_size, 'a')
+        , data_(batch_capacity * (mode == ModeE::Segment ? segment_buf_capacity : datagram_buf_capacity))
+        , server_addr_(_server_addr)
+    {
+        const size_t capacity = data_.size() / batch_capacity;
+        for (size_t i = 0; i < batch_capacity; ++i) {
+            recv_buf_vec_.emplace_back(data_.data() + i * capacity, capacity);
+        }
+        if (mode == ModeE::Segment) {
+            // one GSO buffer carrying the whole window
+            send_buf_vec_.emplace_back(payload_.data(), payload_.size());
+            send_buf_vec_.back().size_         = payload_.size();
+            send_buf_vec_.back().segment_size_ = payload_size;
+            send_buf_vec_.back().address_      = server_addr_;
+        } else {
+            for (size_t i = 0; i < window_size; ++i) {
+                send_buf_vec_.emplace_back(payload_.data(), payload_.size());
+                send_buf_vec_.back().size_    = payload_.size();
+                send_buf_vec_.back().address_ = server_addr_;
+            }
+        }
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, EventBase&& _revent) override
+    {
+        if (generic_event<GenericEventE::Start> == _revent) {
+            doSend(_rctx);
+            doRecv(_rctx);
+        } else if (generic_event<GenericEventE::Kill> == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void doSend(frame::aio::ReactorContext& _rctx)
+    {
+        auto on_send = [this](frame::aio::ReactorContext& _rctx) {
+            if (onSend(_rctx)) {
+                ++send_index_;
+                doSend(_rctx);
+            }
+        };
+
+        if (mode == ModeE::Single) {
+            while (send_index_ < window_size) {
+                if (!sock_.sendTo(_rctx, payload_.data(), payload_.size(), server_addr_, on_send)) {
+                    return;
+                }
+                if (!onSend(_rctx)) {
+                    return;
+                }
+                ++send_index_;
+            }
+        } else if (send_index_ == 0) {
+            if (sock_.sendToMany(_rctx, send_buf_vec_.data(), send_buf_vec_.size(), on_send) && onSend(_rctx)) {
+                send_index_ = window_size;
+            }
+        }
+    }
+
+    bool onSend(frame::aio::ReactorContext& _rctx)
+    {
+        if (_rctx.error()) {
+            solid_log(generic_logger, Error, "client send error: " << _rctx.error().message() << " " << _rctx.systemError().message());
+            postStop(_rctx);
+            return false;
+        }
+        return true;
+    }
+
+    void doRecv(frame::aio::ReactorContext& _rctx)
+    {
+        while (true) {
+            size_t recv_count = 0;
+            if (mode == ModeE::Single) {
+                DatagramBuffer& rbuf = recv_buf_vec_.front();
+                if (!sock_.recvFrom(
+                        _rctx, rbuf.data_, rbuf.capacity_,
+                        [this](frame::aio::ReactorContext& _rctx, SocketAddress& /*_raddr*/, size_t _sz) {
+                            recv_buf_vec_.front().size_ = _sz;
+                            if (onRecv(_rctx, 1)) {
+                                doRecv(_rctx);
+                            }
+                        },
+                        rbuf.address_, rbuf.size_)) {
+                    return;
+                }
+                recv_count = 1;
+            } else if (!sock_.recvFromMany(
+                           _rctx, recv_buf_vec_.data(), recv_buf_vec_.size(),
+                           [this](frame::aio::ReactorContext& _rctx, size_t _count) {
+                               if (onRecv(_rctx, _count)) {
+                                   doRecv(_rctx);
+                               }
+                           },
+                           recv_count)) {
+                return;
+            }
+
+            if (!onRecv(_rctx, recv_count)) {
+                return;
+            }
+        }
+    }
+
+    bool onRecv(frame::aio::ReactorContext& _rctx, size_t _count)
+    {
+        if (_rctx.error()) {
+            solid_log(generic_logger, Error, "client recv error: " << _rctx.error().message() << " " << _rctx.systemError().message());
+            postStop(_rctx);
+            return false;
+        }
+
+        for (size_t i = 0; i < _count; ++i) {
+            window_recv_count_ += datagram_count(recv_buf_vec_[i]);
+        }
+        ++recv_call_count_;
+
+        if (window_recv_count_ >= window_size) {
+            solid_check(window_recv_count_ == window_size, "received " << window_recv_count_ << " of " << window_size);
+            window_recv_count_ = 0;
+            send_index_        = 0;
+            ++round_;
+
+            if (round_ == round_count) {
+                lock_guard<mutex> lock(mtx);
+                client_done            = true;
+                client_recv_call_count = recv_call_count_;
+                cnd.notify_one();
+                return false;
+            }
+            doSend(_rctx);
+        }
+        return true;
+    }
+
+private:
+    DatagramT              sock_;
+    string                 payload_;
+    vector<char>           data_;
+    vector<DatagramBuffer> recv_buf_vec_;
+    vector<DatagramBuffer> send_buf_vec_;
+    SocketAddress          server_addr_;
+    size_t                 send_index_        = 0;
+    size_t                 window_recv_count_ = 0;
+    size_t                 recv_call_count_   = 0;
+    size_t                 round_             = 0;
+};
+
+SocketDevice create_datagram_socket(SocketAddress& _raddr)
+{
+    ResolveData  rd = synchronous_resolve("127.0.0.1", "0", 0, SocketInfo::Inet4, SocketInfo::Datagram);
+    SocketDevice sd;
+
+    sd.create(rd.begin());
+    sd.bind(rd.begin());
+    sd.makeNonBlocking();
+    sd.localAddress(_raddr);
+
+    if (mode == ModeE::Segment) {
+        const auto err = sd.enableUdpGro();
+        if (err) {
+            solid_log(generic_logger, Warning, "enableUdpGro: " << err.message());
+            sd.close();
+        }
+    }
+    return sd;
+}
+
+} // namespace
+
+// UDP echo over loopback: a client sends round_count windows of window_size datagrams
+// and a server echoes them back. Reports the number of datagrams per second, one way.
+// arguments: [s(ingle)|b(atch)|g(so/gro)] [window_size] [round_count]
+int test_datagram_stress(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EWX", "\\*:VEWX"});
+
+    if (argc > 1) {
+        if (*argv[1] == 'b' || *argv[1] == 'B') {
+            mode = ModeE::Batch;
+        }
+        if (*argv[1] == 'g' || *argv[1] == 'G') {
+            mode = ModeE::Segment;
+        }
+    }
+    if (argc > 2) {
+        window_size = atoi(argv[2]);
+        if (window_size == 0 || window_size > batch_capacity) {
+            window_size = batch_capacity;
+        }
+    }
+    if (argc > 3) {
+        round_count = atoi(argv[3]);
+    }
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+
+    sch.start(2);
+
+    SocketAddress server_addr;
+    SocketAddress client_addr;
+    SocketDevice  server_sd = create_datagram_socket(server_addr);
+    SocketDevice  client_sd = create_datagram_socket(client_addr);
+
+    if (!server_sd || !client_sd) {
+        cout << "UDP GSO/GRO not available - skipping" << endl;
+        return 0;
+    }
+
+    const auto start_time = chrono::steady_clock::now();
+    {
+        ErrorConditionT err;
+        sch.startActor(make_shared<Server>(std::move(server_sd)), svc, 0, make_event(GenericEventE::Start), err);
+        solid_check(!err, "starting server: " << err.message());
+        sch.startActor(make_shared<Client>(std::move(client_sd), server_addr), svc, 1, make_event(GenericEventE::Start), err);
+        solid_check(!err, "starting client: " << err.message());
+    }
+
+    {
+        unique_lock<mutex> lock(mtx);
+
+        if (!cnd.wait_for(lock, std::chrono::seconds(wait_seconds), []() { return client_done; })) {
+            solid_throw("Process is taking too long.");
+        }
+    }
+
+    const auto   duration       = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time);
+    const size_t datagram_total = window_size * round_count;
+
+    svc.stop();
+    sch.stop();
+
+    static const char* mode_names[] = {"single", "batch", "gso/gro"};
+
+    cout << mode_names[static_cast<size_t>(mode)] << ": " << round_count << " rounds of " << window_size << " datagrams of " << payload_size << " bytes in " << duration.count() << "us" << endl;
+    cout << "echoed " << (datagram_total * 1000000.0 / duration.count()) << " datagrams/s with " << client_recv_call_count << " client receive calls" << endl;
+    return 0;
+}
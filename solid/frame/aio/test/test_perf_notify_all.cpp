@@ -0,0 +1,118 @@
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+#include "solid/utility/event.hpp"
+
+using namespace solid;
+using namespace std;
+namespace {
+const LoggerT logger("test");
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor<Event<32>>>;
+
+atomic<size_t> started_count{0};
+atomic<size_t> received_count{0};
+promise<void>  start_prom;
+promise<void>  receive_prom;
+
+class Actor final : public frame::aio::Actor {
+    const size_t actor_count_;
+
+    void onEvent(frame::aio::ReactorContext& _rctx, EventBase&& _revent) override
+    {
+        if (generic_event<GenericEventE::Start> == _revent) {
+            if (started_count.fetch_add(1) + 1 == actor_count_) {
+                start_prom.set_value();
+            }
+        } else if (generic_event<GenericEventE::Update> == _revent) {
+            if (received_count.fetch_add(1) + 1 == actor_count_) {
+                receive_prom.set_value();
+            }
+        } else if (generic_event<GenericEventE::Kill> == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+public:
+    Actor(const size_t _actor_count)
+        : actor_count_(_actor_count)
+    {
+    }
+};
+
+} // namespace
+
+// Broadcasts an event to many actors with Service::notifyAll ('b') or,
+// for comparison, with one Manager::notify per actor ('o').
+int test_perf_notify_all(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWXS", "test:VIEWS"});
+
+    const int wait_seconds = 600;
+
+    size_t actor_count{100000};
+    size_t thread_count{2};
+    bool   batched{true};
+
+    if (argc > 1) {
+        actor_count = stoul(argv[1]);
+    }
+    if (argc > 2) {
+        thread_count = stoul(argv[2]);
+    }
+    if (argc > 3) {
+        batched = *argv[3] != 'o';
+    }
+
+    AioSchedulerT           scheduler;
+    frame::Manager          manager{1024, actor_count + 1024};
+    frame::ServiceT         service{manager};
+    vector<frame::ActorIdT> actors;
+
+    scheduler.start(thread_count);
+
+    actors.reserve(actor_count);
+    for (size_t i = 0; i < actor_count; ++i) {
+        ErrorConditionT err;
+        actors.emplace_back(scheduler.startActor(make_shared<Actor>(actor_count), service, make_event(GenericEventE::Start), err));
+        solid_check(!err, "start actor: " << err.message());
+    }
+    {
+        auto fut = start_prom.get_future();
+        solid_check(fut.wait_for(chrono::seconds(wait_seconds)) == future_status::ready, "actors not started");
+    }
+
+    const auto start_time = chrono::steady_clock::now();
+
+    if (batched) {
+        service.notifyAll(make_event(GenericEventE::Update));
+    } else {
+        for (const auto& id : actors) {
+            manager.notify(id, make_event(GenericEventE::Update));
+        }
+    }
+
+    const auto notify_duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time);
+    {
+        auto fut = receive_prom.get_future();
+        solid_check(fut.wait_for(chrono::seconds(wait_seconds)) == future_status::ready, "event not delivered: " << received_count << " of " << actor_count);
+    }
+    const auto deliver_duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time);
+
+    cout << actor_count << " actors on " << thread_count << " reactors, " << (batched ? "notifyAll" : "notify one by one") << endl;
+    cout << "notify: " << notify_duration.count() << "us delivered: " << deliver_duration.count() << "us" << endl;
+
+    solid_log(logger, Statistic, "scheduler statistic: " << scheduler.statistic());
+
+    service.stop();
+    scheduler.stop();
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <atomic>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "solid/system/crashhandler.hpp"
+#include "solid/system/exception.hpp"
+#include "solid/utility/event.hpp"
+#include "solid/utility/threadpool.hpp"
+
+using namespace solid;
+using namespace std;
+namespace {
+const LoggerT logger("test");
+
+using ThreadPoolT = ThreadPool<Event<128>, size_t>;
+atomic<size_t> received_events{0};
+atomic<size_t> accumulate_value{0};
+
+const char* mode_name(const ThreadPoolModeE _mode)
+{
+    return _mode == ThreadPoolModeE::Shared ? "shared" : "work_stealing";
+}
+
+// external producer: all tasks are pushed from a non-worker thread
+uint64_t run_external(const ThreadPoolModeE _mode, const size_t _thread_count, const size_t _event_count)
+{
+    const auto start = std::chrono::steady_clock::now();
+    {
+        ThreadPoolT wp{
+            ThreadPoolConfiguration{_thread_count, 10000, 0}.mode(_mode), [](const size_t) {}, [](const size_t) {},
+            [&](EventBase& _event) {
+                if (_event == generic_event<GenericEventE::Wake>) {
+                    ++received_events;
+                    accumulate_value += *_event.cast<size_t>();
+                }
+            },
+            [](const size_t) {}};
+        for (size_t i = 0; i < _event_count; ++i) {
+            wp.pushOne(make_event(GenericEventE::Wake, i));
+        }
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// recursive fan-out: every task pushes two more from within the worker
+// NOTE: the shared ring is consumed breadth-first so it must be able
+//  to hold a whole level of the tree, otherwise the workers block on pushOne
+uint64_t run_fan_out(const ThreadPoolModeE _mode, const size_t _thread_count, const size_t _depth)
+{
+    const size_t              leaf_count = size_t(1) << _depth;
+    std::atomic<ThreadPoolT*> pwp{nullptr};
+    std::atomic<size_t>       leafs{0};
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+        ThreadPoolT wp{
+            ThreadPoolConfiguration{_thread_count, std::max(size_t(10000), leaf_count * 2), 0}.mode(_mode), [](const size_t) {}, [](const size_t) {},
+            [&](EventBase& _event) {
+                const size_t depth = *_event.cast<size_t>();
+                if (depth == 0) {
+                    ++leafs;
+                    return;
+                }
+                pwp.load()->pushOne(make_event(GenericEventE::Wake, depth - 1));
+                pwp.load()->pushOne(make_event(GenericEventE::Wake, depth - 1));
+            },
+            [](const size_t) {}};
+        pwp = &wp;
+        wp.pushOne(make_event(GenericEventE::Wake, _depth));
+
+        while (leafs.load() != leaf_count) {
+            std::this_thread::yield();
+        }
+        solid_log(logger, Verbose, mode_name(_mode) << " " << _thread_count << " statistic: " << wp.statistic());
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int test_perf_threadpool_work_stealing(int argc, char* argv[])
+{
+
+    solid::log_start(std::cerr, {".*:EWXS", "test:VIEWS"});
+
+#ifdef SOLID_SANITIZE_THREAD
+    const int wait_seconds = 1500;
+#else
+    const int wait_seconds = 10000;
+#endif
+
+    size_t max_thread_count{64};
+    size_t event_count{200000};
+    size_t depth{17};
+
+    if (argc > 1) {
+        max_thread_count = stoul(argv[1]);
+    }
+    if (argc > 2) {
+        event_count = stoul(argv[2]);
+    }
+    if (argc > 3) {
+        depth = stoul(argv[3]);
+    }
+
+    auto lambda = [&]() {
+        for (size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2) {
+            for (const auto mode : {ThreadPoolModeE::Shared, ThreadPoolModeE::WorkStealing}) {
+                const auto external_us = run_external(mode, thread_count, event_count);
+                const auto fan_out_us  = run_fan_out(mode, thread_count, depth);
+
+                solid_log(logger, Statistic, "threads = " << thread_count << " mode = " << mode_name(mode) << " external = " << external_us << "us fan_out = " << fan_out_us << "us");
+            }
+        }
+    };
+
+    auto fut = async(launch::async, lambda);
+    if (fut.wait_for(chrono::seconds(wait_seconds)) != future_status::ready) {
+
+        solid_throw(" Test is taking too long - waited " << wait_seconds << " secs");
+    }
+    fut.get();
+
+    solid_log(logger, Verbose, "after async wait " << received_events << " " << accumulate_value);
+
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "solid/frame/timestore.hpp"
+#include "solid/frame/timewheel.hpp"
 #include "solid/system/exception.hpp"
 #include "solid/system/log.hpp"
 #include <chrono>
@@ -20,85 +21,172 @@ std::vector<chrono::microseconds> pattern{
     20min, 20s, 20ms, 19min, 19s, 19ms, 18min, 18s, 18ms, 17min, 17s, 17ms, 16min, 16s, 16ms,
     15min, 15s, 15ms, 14min, 14s, 14ms, 13min, 13s, 13ms, 12min, 12s, 12ms, 11min, 11s, 11s};
 
-} // namespace
-
-int test_perf_timestore(int argc, char* argv[])
+template <class Store>
+void test_pattern(const size_t _repeat_count, const size_t _timer_count, const size_t _add_update_count)
 {
-    solid::log_start(std::cerr, {".*:EWXS", "test:EWS"});
-
-    size_t repeat_count     = 100;
-    size_t timer_count      = 10000;
-    size_t add_update_count = 100;
+    chrono::nanoseconds max_duration(0);
+    chrono::nanoseconds total_duration(0);
+    size_t              count = 0;
 
-    int version = 1;
+    std::deque<std::tuple<NanoTime, size_t>> timers;
+    Store                                    time_store;
+    NanoTime                                 now = NanoTime::nowSteady();
 
-    if (argc > 1) {
-        version = atoi(argv[1]);
+    for (size_t i = 0; i < _timer_count; ++i) {
+        timers.emplace_back(NanoTime::max(), InvalidIndex{});
     }
+    size_t index = 0;
+    for (size_t r = 0; r < _repeat_count; ++r) {
+        for (size_t i = 0; i < _add_update_count; ++i) {
+            const auto idx = index % _timer_count;
+            auto&      rt  = timers[idx];
+
+            if (get<0>(rt) == NanoTime::max()) {
+                get<0>(rt) = now + pattern[index % pattern.size()];
+                get<1>(rt) = time_store.push(now, get<0>(rt), idx);
+                solid_log(logger, Verbose, "push " << now << " " << get<0>(rt) << " " << i << " now+" << pattern[index % pattern.size()]);
+            } else {
+                const auto oldexp = get<0>(rt);
+                get<0>(rt)        = get<0>(rt) + pattern[index % pattern.size()];
+                time_store.update(get<1>(rt), now, get<0>(rt));
+                solid_log(logger, Verbose, "update " << now << " from " << oldexp << " to " << get<0>(rt) << " " << idx << " now+" << pattern[index % pattern.size()]);
+            }
+            ++index;
+        }
 
-    chrono::nanoseconds max_duration(0);
-    chrono::nanoseconds total_duration(0);
-    size_t              count = 0;
+        now = time_store.expiry() + 10ms;
 
-    if (version == 1) {
+        const auto start = chrono::steady_clock::now();
 
-        std::deque<std::tuple<NanoTime, size_t>> timers;
-        frame::TimeStore                         time_store;
-        NanoTime                                 now = NanoTime::nowSteady();
+        time_store.pop(now, [&](const size_t _i, const NanoTime& _expiry, const size_t _proxy_index) {
+            auto& rt = timers[_i];
+            solid_check(get<1>(rt) == _proxy_index && get<0>(rt) == _expiry && now >= get<0>(rt));
+            get<0>(rt) = NanoTime::max();
+        });
 
-        for (size_t i = 0; i < timer_count; ++i) {
-            timers.emplace_back(NanoTime::max(), InvalidIndex{});
+        const auto duration = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+        if (duration > max_duration) {
+            max_duration = duration;
         }
-        size_t index = 0;
-        for (size_t r = 0; r < repeat_count; ++r) {
-            for (size_t i = 0; i < add_update_count; ++i) {
-                const auto idx = index % timer_count;
-                auto&      rt  = timers[idx];
+        ++count;
+        total_duration += duration;
+    }
 
-                if (get<0>(rt) == NanoTime::max()) {
-                    get<0>(rt) = now + pattern[index % pattern.size()];
-                    get<1>(rt) = time_store.push(now, get<0>(rt), idx);
-                    solid_log(logger, Verbose, "push " << now << " " << get<0>(rt) << " " << i << " now+" << pattern[index % pattern.size()]);
-                } else {
-                    const auto oldexp = get<0>(rt);
-                    get<0>(rt)        = get<0>(rt) + pattern[index % pattern.size()];
-                    time_store.update(get<1>(rt), now, get<0>(rt));
-                    solid_log(logger, Verbose, "update " << now << " from " << oldexp << " to " << get<0>(rt) << " " << idx << " now+" << pattern[index % pattern.size()]);
-                }
-                ++index;
-            }
+    while (!time_store.empty()) {
+        now = time_store.expiry();
+        time_store.pop(now, [&](const size_t _i, const NanoTime& _expiry, const size_t _proxy_index) {
+            auto& rt = timers[_i];
+            solid_check(get<1>(rt) == _proxy_index && get<0>(rt) == _expiry && now >= get<0>(rt));
+            get<0>(rt) = NanoTime::max();
+        });
+    }
 
-            now = time_store.expiry() + 10ms;
+    cout << "max duration: " << max_duration << endl;
+    if (count) {
+        cout << "avg duration: " << total_duration / count << endl;
+    }
+}
+
+//! Reactor like load: _timer_count connection timers spread over a minute
+/*!
+    The clock advances with _step, _update_count timers are re-armed per step
+    (activity) and the fired ones are re-armed from within the callback (keepalive).
+*/
+template <class Store>
+void test_load(const char* _name, const size_t _step_count, const chrono::milliseconds _step, const size_t _timer_count, const size_t _update_count)
+{
+    std::vector<std::tuple<NanoTime, size_t>> timers(_timer_count, std::make_tuple(NanoTime::max(), InvalidIndex{}));
+    Store                                     time_store(_timer_count);
+    NanoTime                                  now = NanoTime::nowSteady();
+    chrono::nanoseconds                       push_duration(0);
+    chrono::nanoseconds                       update_duration(0);
+    chrono::nanoseconds                       pop_duration(0);
+    chrono::nanoseconds                       max_pop_duration(0);
+    size_t                                    fired_count = 0;
+    size_t                                    index       = 0;
+
+    const auto expiry = [&now](const size_t _i) {
+        return now + chrono::milliseconds((_i * 7919) % 60000) + chrono::microseconds(_i % 997);
+    };
+
+    {
+        const auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < _timer_count; ++i) {
+            get<0>(timers[i]) = expiry(i);
+            get<1>(timers[i]) = time_store.push(now, get<0>(timers[i]), i);
+        }
+        push_duration = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+    }
 
+    for (size_t s = 0; s < _step_count; ++s) {
+        {
             const auto start = chrono::steady_clock::now();
+            for (size_t i = 0; i < _update_count; ++i, ++index) {
+                const auto idx = (index * 104729) % _timer_count;
+                auto&      rt  = timers[idx];
+                get<0>(rt)     = expiry(index) + 10s;
+                time_store.update(get<1>(rt), now, get<0>(rt));
+            }
+            update_duration += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+        }
 
+        now = now + _step;
+        {
+            const auto start    = chrono::steady_clock::now();
             time_store.pop(now, [&](const size_t _i, const NanoTime& _expiry, const size_t _proxy_index) {
                 auto& rt = timers[_i];
                 solid_check(get<1>(rt) == _proxy_index && get<0>(rt) == _expiry && now >= get<0>(rt));
-                get<0>(rt) = NanoTime::max();
+                get<0>(rt) = expiry(_i + fired_count) + 10s;
+                get<1>(rt) = time_store.push(now, get<0>(rt), _i);
+                ++fired_count;
             });
-
             const auto duration = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
-            if (duration > max_duration) {
-                max_duration = duration;
+            pop_duration += duration;
+            if (duration > max_pop_duration) {
+                max_pop_duration = duration;
             }
-            ++count;
-            total_duration += duration;
         }
+    }
 
-        while (!time_store.empty()) {
-            now = time_store.expiry();
-            time_store.pop(now, [&](const size_t _i, const NanoTime& _expiry, const size_t _proxy_index) {
-                auto& rt = timers[_i];
-                solid_check(get<1>(rt) == _proxy_index && get<0>(rt) == _expiry && now >= get<0>(rt));
-                get<0>(rt) = NanoTime::max();
-            });
-        }
+    solid_check(time_store.size() == _timer_count);
+
+    for (const auto& rt : timers) {
+        solid_check(now < get<0>(rt) + _step);
     }
 
-    cout << "max duration: " << max_duration << endl;
-    if (count) {
-        cout << "avg duration: " << total_duration / count << endl;
+    cout << _name << ": timers = " << _timer_count << " steps = " << _step_count << " fired = " << fired_count << endl;
+    cout << "    push: " << push_duration / _timer_count << "/timer" << endl;
+    cout << "    update: " << update_duration / (_step_count * _update_count) << "/timer" << endl;
+    cout << "    pop: avg " << pop_duration / _step_count << " max " << max_pop_duration << endl;
+}
+
+} // namespace
+
+int test_perf_timestore(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWXS", "test:EWS"});
+
+    size_t repeat_count     = 100;
+    size_t timer_count      = 10000;
+    size_t add_update_count = 100;
+
+    int version = 1;
+
+    if (argc > 1) {
+        version = atoi(argv[1]);
+    }
+
+    if (version == 1) {
+        test_pattern<frame::TimeStore>(repeat_count, timer_count, add_update_count);
+    } else if (version == 2) {
+        test_pattern<frame::TimeWheel>(repeat_count, timer_count, add_update_count);
+    } else if (version == 3) {
+        timer_count = 1000 * 1000;
+        if (argc > 2) {
+            timer_count = atoi(argv[2]);
+        }
+        test_load<frame::TimeStore>("TimeStore", 1000, 5ms, timer_count, timer_count / 1000);
+        test_load<frame::TimeWheel>("TimeWheel", 1000, 5ms, timer_count, timer_count / 1000);
     }
     return 0;
-}
\ No newline at end of file
+}
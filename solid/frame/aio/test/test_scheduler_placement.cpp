@@ -0,0 +1,157 @@
+#include "solid/frame/actor.hpp"
+#include "solid/frame/manager.hpp"
+#include "solid/frame/reactor.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/system/cpu.hpp"
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include <atomic>
+#include <future>
+#include <iostream>
+
+#ifdef SOLID_ON_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+using namespace solid;
+
+using SchedulerT = frame::Scheduler<frame::ReactorT>;
+
+namespace {
+
+const solid::LoggerT logger("test");
+
+// the cpus the calling thread may run on
+CpuVectorT thread_cpus()
+{
+    CpuVectorT cpu_vec;
+#ifdef SOLID_ON_LINUX
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == 0) {
+        for (int i = 0; i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET(i, &cpuset)) {
+                cpu_vec.emplace_back(i);
+            }
+        }
+    }
+#endif
+    return cpu_vec;
+}
+
+class Probe final : public frame::Actor {
+    const int      cpu_;
+    atomic<size_t>& rcount_;
+    promise<void>&  rprom_;
+
+public:
+    Probe(const int _cpu, atomic<size_t>& _rcount, promise<void>& _rprom)
+        : cpu_(_cpu)
+        , rcount_(_rcount)
+        , rprom_(_rprom)
+    {
+    }
+
+    void onEvent(frame::ReactorContext& _rctx, EventBase&& _revent) override
+    {
+        if (_revent == generic_event<GenericEventE::Start>) {
+            if (cpu_ >= 0) {
+#ifdef SOLID_ON_LINUX
+                // started near cpu_ - must run on a reactor pinned on cpu_
+                solid_check(thread_cpus() == CpuVectorT{cpu_}, "reactor not pinned on " << cpu_);
+                solid_check(cpu_current() == cpu_, "running on " << cpu_current() << " expected " << cpu_);
+#endif
+            }
+            postStop(_rctx);
+            if (rcount_.fetch_sub(1) == 1) {
+                rprom_.set_value();
+            }
+        }
+    }
+};
+
+void test_parse()
+{
+    solid_check(cpu_list_parse("0-3,8,10-11\n") == (CpuVectorT{0, 1, 2, 3, 8, 10, 11}));
+    solid_check(cpu_list_parse("5") == CpuVectorT{5});
+    solid_check(cpu_list_parse("2,1,2") == (CpuVectorT{1, 2}));
+    solid_check(cpu_list_parse("").empty());
+}
+
+} // namespace
+
+// Starts reactors pinned by a SchedulerPlacement and actors near given cpus.
+int test_scheduler_placement(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWX"});
+
+    size_t actor_count = 1000;
+    if (argc > 1) {
+        actor_count = atoi(argv[1]);
+    }
+
+    test_parse();
+
+    solid_check(numa_node_count() >= 1);
+    solid_check(!numa_node_cpus(0).empty() || numa_node_count() > 1);
+
+    const CpuVectorT allowed_cpus = thread_cpus();
+
+    { // without a placement - as before
+        SchedulerT sch;
+        sch.start(2);
+        solid_check(sch.workerNumaNode(0) == -1 && sch.workerNumaNode(1) == -1);
+        sch.stop();
+    }
+
+    const frame::SchedulerPlacement numa_placement = frame::SchedulerPlacement::numa(4);
+    solid_check(numa_placement.size() == 4);
+    for (const auto& cpu_vec : numa_placement.reactor_cpu_vec) {
+        solid_check(cpu_vec.size() == 1);
+    }
+
+    // pin on the cpus we are allowed to run on - a reactor per cpu, at most 8
+    CpuVectorT cpu_vec = allowed_cpus;
+    if (cpu_vec.size() > 8) {
+        cpu_vec.resize(8);
+    }
+    if (cpu_vec.empty()) {
+        cpu_vec.emplace_back(-1); // unknown affinity - reactors not pinned
+    }
+    const frame::SchedulerPlacement placement = frame::SchedulerPlacement::cpus(cpu_vec.front() >= 0 ? cpu_vec : CpuVectorT{});
+
+    frame::Manager  manager;
+    frame::ServiceT service{manager};
+    SchedulerT      sch;
+    atomic<size_t>  count{actor_count};
+    promise<void>   prom;
+
+    if (placement.empty()) {
+        sch.start(2);
+    } else {
+        sch.start(placement);
+        solid_check(sch.workerCount() == cpu_vec.size());
+        for (size_t i = 0; i < cpu_vec.size(); ++i) {
+            solid_check(sch.workerNumaNode(i) == cpu_numa_node(cpu_vec[i]));
+        }
+    }
+
+    for (size_t i = 0; i < actor_count; ++i) {
+        ErrorConditionT err;
+        const int       cpu = (i % 5 == 0) ? -1 : cpu_vec[i % cpu_vec.size()];
+        sch.startActorNearCpu(make_shared<Probe>(placement.empty() ? -1 : cpu, count, prom), service, cpu, make_event(GenericEventE::Start), err);
+        solid_check(!err, "failed starting actor: " << err.message());
+    }
+
+    auto fut = prom.get_future();
+    solid_check(fut.wait_for(chrono::seconds(60)) == future_status::ready, "probes not done");
+    fut.get();
+
+    sch.stop();
+    return 0;
+}
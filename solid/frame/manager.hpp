@@ -155,6 +155,11 @@ private:
         ScheduleFunctionT& _rfct,
         ErrorConditionT&   _rerr);
 
+    bool moveActor(
+        ActorBase&         _ractor,
+        ReactorBase&       _rreactor,
+        ScheduleFunctionT& _rfct);
+
     size_t notifyAll(const Service& _rservice, EventBase const& _revent);
 
     template <typename F>
@@ -168,6 +173,7 @@ private:
     size_t doForEachServiceActor(const Service& _rservice, const ActorVisitFunctionT& _rvisit_fnc);
     size_t doForEachServiceActor(const size_t _chkidx, const ActorVisitFunctionT& _rvisit_fnc);
     bool   doVisit(ActorIdT const& _actor_id, const ActorVisitFunctionT& _rvisit_fnc);
+    size_t doNotifyAll(const size_t _first_actor_chunk, EventBase const& _revent);
 
     bool doStopService(const size_t _service_index, const bool _wait);
     void doCleanupService(const size_t _service_index, Service& _rservice);
@@ -0,0 +1,160 @@
+// solid/frame/mprpc/mprpccompression_lz4.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "lz4.h"
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol.hpp"
+
+namespace solid {
+namespace frame {
+namespace mprpc {
+namespace lz4 {
+
+constexpr uint8_t engine_id = 2;
+
+//! A dictionary shared by all the connections - the peers must use the same content
+/*!
+    Only the last 64KB of the content are used. Good dictionaries are
+    concatenated samples of the small messages exchanged or a dictionary
+    trained with zstd::train.
+*/
+class Dictionary {
+    std::string  data_;
+    LZ4_stream_t stream_; // with data_ loaded - copied before every compression
+
+public:
+    using PointerT = std::shared_ptr<const Dictionary>;
+
+    static PointerT create(std::string _data)
+    {
+        return std::make_shared<const Dictionary>(std::move(_data));
+    }
+
+    explicit Dictionary(std::string _data)
+        : data_(std::move(_data))
+    {
+        if (data_.size() > 64 * 1024) {
+            data_.erase(0, data_.size() - 64 * 1024);
+        }
+        LZ4_initStream(&stream_, sizeof(stream_));
+        LZ4_loadDict(&stream_, data_.data(), static_cast<int>(data_.size()));
+    }
+
+    Dictionary(const Dictionary&)            = delete;
+    Dictionary& operator=(const Dictionary&) = delete;
+
+    const std::string& data() const
+    {
+        return data_;
+    }
+
+    const LZ4_stream_t& stream() const
+    {
+        return stream_;
+    }
+};
+
+//! Per thread compression state and buffer - reused by all the connections on the thread
+struct ThreadContext {
+    LZ4_stream_t stream;
+    char         buffer[Protocol::MaxPacketDataSize];
+
+    static ThreadContext& get()
+    {
+        static thread_local std::unique_ptr<ThreadContext> ctx_ptr(new ThreadContext);
+        return *ctx_ptr;
+    }
+};
+
+struct Engine {
+    const size_t               buff_threshold;
+    const size_t               diff_threshold;
+    const int                  acceleration;
+    const Dictionary::PointerT dict_ptr;
+
+    Engine(size_t _buff_threshold, size_t _diff_threshold, int _acceleration, Dictionary::PointerT _dict_ptr)
+        : buff_threshold(_buff_threshold)
+        , diff_threshold(_diff_threshold)
+        , acceleration(_acceleration)
+        , dict_ptr(std::move(_dict_ptr))
+    {
+    }
+
+    // compression:
+    size_t operator()(char* _piobuf, size_t _bufsz, ErrorConditionT&) const
+    {
+        if (_bufsz <= buff_threshold || _bufsz <= diff_threshold) {
+            // buffer too small to compress
+            return 0;
+        }
+
+        ThreadContext& rctx = ThreadContext::get();
+        // anything bigger is not worth sending compressed - lz4 stops early
+        const int capacity = static_cast<int>(_bufsz - diff_threshold);
+        int       len      = 0;
+
+        if (dict_ptr) {
+            memcpy(&rctx.stream, &dict_ptr->stream(), sizeof(LZ4_stream_t));
+            len = LZ4_compress_fast_continue(&rctx.stream, _piobuf, rctx.buffer, static_cast<int>(_bufsz), capacity, acceleration);
+        } else {
+            len = LZ4_compress_fast_extState(&rctx.stream, _piobuf, rctx.buffer, static_cast<int>(_bufsz), capacity, acceleration);
+        }
+
+        if (len <= 0) {
+            return 0; // compression not eficient
+        }
+
+        memcpy(_piobuf, rctx.buffer, len);
+        return len;
+    }
+
+    // decompression:
+    size_t operator()(char* _pto, const char* _pfrom, size_t _from_sz, ErrorConditionT& _rerror) const
+    {
+        int len = 0;
+        if (dict_ptr) {
+            len = LZ4_decompress_safe_usingDict(_pfrom, _pto, static_cast<int>(_from_sz), Protocol::MaxPacketDataSize, dict_ptr->data().data(), static_cast<int>(dict_ptr->data().size()));
+        } else {
+            len = LZ4_decompress_safe(_pfrom, _pto, static_cast<int>(_from_sz), Protocol::MaxPacketDataSize);
+        }
+
+        if (len < 0) {
+            _rerror = error_compression_engine;
+            return 0;
+        }
+        return len;
+    }
+};
+
+//! Add lz4 to the compression engines negotiated per connection
+/*!
+    Register every dictionary under its own id, the same on all peers.
+*/
+inline void registerEngine(
+    mprpc::Configuration& _rcfg,
+    Dictionary::PointerT  _dict_ptr       = nullptr,
+    const uint8_t         _id             = engine_id,
+    int                   _acceleration   = 1,
+    size_t                _buff_threshold = 64,
+    size_t                _diff_threshold = 16)
+{
+    _rcfg.registerCompressionEngine(_id, Engine(_buff_threshold, _diff_threshold, _acceleration, _dict_ptr), Engine(_buff_threshold, _diff_threshold, _acceleration, _dict_ptr));
+}
+
+} // namespace lz4
+} // namespace mprpc
+} // namespace frame
+} // namespace solid
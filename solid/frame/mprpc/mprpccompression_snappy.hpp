@@ -11,6 +11,7 @@
 #pragma once
 
 #include <cstring>
+#include <memory>
 
 #include "snappy.h"
 #include "solid/frame/mprpc/mprpcconfiguration.hpp"
@@ -21,6 +22,15 @@ namespace frame {
 namespace mprpc {
 namespace snappy {
 
+constexpr uint8_t engine_id = 1;
+
+//! Per thread buffer for the compressed data - avoids a big stack buffer per call
+inline char* compress_buffer()
+{
+    static thread_local std::unique_ptr<char[]> buf_ptr(new char[::snappy::MaxCompressedLength(Protocol::MaxPacketDataSize)]);
+    return buf_ptr.get();
+}
+
 struct Engine {
     const size_t buff_threshold;
     const size_t diff_threshold;
@@ -37,7 +47,7 @@ struct Engine {
 
         if (_bufsz > buff_threshold) {
 
-            char tmpbuf[Protocol::MaxPacketDataSize];
+            char* tmpbuf = compress_buffer();
 
             size_t len = 0;
 
@@ -59,7 +69,7 @@ struct Engine {
     size_t operator()(char* _pto, const char* _pfrom, size_t _from_sz, ErrorConditionT& _rerror)
     {
         size_t newlen = 0;
-        if (::snappy::GetUncompressedLength(_pfrom, _from_sz, &newlen)) {
+        if (::snappy::GetUncompressedLength(_pfrom, _from_sz, &newlen) && newlen <= Protocol::MaxPacketDataSize) {
         } else {
             _rerror = error_compression_engine;
             return 0;
@@ -74,12 +84,19 @@ struct Engine {
     }
 };
 
+//! Compress all packets with snappy - the peers must use it too
 inline void setup(mprpc::Configuration& _rcfg, size_t _buff_threshold = 1024, size_t _diff_threshold = 32)
 {
     _rcfg.reader.decompress_fnc       = Engine(_buff_threshold, _diff_threshold);
     _rcfg.writer.inplace_compress_fnc = Engine(_buff_threshold, _diff_threshold);
 }
 
+//! Add snappy to the compression engines negotiated per connection
+inline void registerEngine(mprpc::Configuration& _rcfg, const uint8_t _id = engine_id, size_t _buff_threshold = 1024, size_t _diff_threshold = 32)
+{
+    _rcfg.registerCompressionEngine(_id, Engine(_buff_threshold, _diff_threshold), Engine(_buff_threshold, _diff_threshold));
+}
+
 } // namespace snappy
 } // namespace mprpc
 } // namespace frame
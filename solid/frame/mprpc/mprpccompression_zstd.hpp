@@ -0,0 +1,190 @@
+// solid/frame/mprpc/mprpccompression_zstd.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol.hpp"
+#include "zdict.h"
+#include "zstd.h"
+
+namespace solid {
+namespace frame {
+namespace mprpc {
+namespace zstd {
+
+constexpr uint8_t engine_id = 3;
+
+//! A dictionary shared by all the connections - the peers must use the same content
+/*!
+    Digested once, with the compression level, and used read-only from any thread.
+*/
+class Dictionary {
+    ZSTD_CDict* pcdict_ = nullptr;
+    ZSTD_DDict* pddict_ = nullptr;
+
+public:
+    using PointerT = std::shared_ptr<const Dictionary>;
+
+    static PointerT create(const std::string& _data, const int _level = 1)
+    {
+        return std::make_shared<const Dictionary>(_data, _level);
+    }
+
+    Dictionary(const std::string& _data, const int _level)
+        : pcdict_(ZSTD_createCDict(_data.data(), _data.size(), _level))
+        , pddict_(ZSTD_createDDict(_data.data(), _data.size()))
+    {
+    }
+
+    ~Dictionary()
+    {
+        ZSTD_freeCDict(pcdict_);
+        ZSTD_freeDDict(pddict_);
+    }
+
+    Dictionary(const Dictionary&)            = delete;
+    Dictionary& operator=(const Dictionary&) = delete;
+
+    const ZSTD_CDict* compressionDictionary() const
+    {
+        return pcdict_;
+    }
+
+    const ZSTD_DDict* decompressionDictionary() const
+    {
+        return pddict_;
+    }
+};
+
+//! Train a dictionary, of at most _capacity bytes, from samples of the messages exchanged
+/*!
+    Returns an empty string if training failed - usually too few samples.
+*/
+inline std::string train(const std::vector<std::string>& _samples, const size_t _capacity = 16 * 1024)
+{
+    std::string         samples;
+    std::vector<size_t> sizes;
+
+    sizes.reserve(_samples.size());
+    for (const auto& sample : _samples) {
+        samples += sample;
+        sizes.emplace_back(sample.size());
+    }
+
+    std::string  dict(_capacity, '\0');
+    const size_t rv = ZDICT_trainFromBuffer(dict.data(), dict.size(), samples.data(), sizes.data(), static_cast<unsigned>(sizes.size()));
+
+    if (ZDICT_isError(rv)) {
+        return std::string();
+    }
+    dict.resize(rv);
+    return dict;
+}
+
+//! Per thread compression contexts and buffer - reused by all the connections on the thread
+struct ThreadContext {
+    std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx_ptr{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx_ptr{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+    char                                                 buffer[Protocol::MaxPacketDataSize];
+
+    static ThreadContext& get()
+    {
+        static thread_local std::unique_ptr<ThreadContext> ctx_ptr(new ThreadContext);
+        return *ctx_ptr;
+    }
+};
+
+struct Engine {
+    const size_t               buff_threshold;
+    const size_t               diff_threshold;
+    const int                  level;
+    const Dictionary::PointerT dict_ptr;
+
+    Engine(size_t _buff_threshold, size_t _diff_threshold, int _level, Dictionary::PointerT _dict_ptr)
+        : buff_threshold(_buff_threshold)
+        , diff_threshold(_diff_threshold)
+        , level(_level)
+        , dict_ptr(std::move(_dict_ptr))
+    {
+    }
+
+    // compression:
+    size_t operator()(char* _piobuf, size_t _bufsz, ErrorConditionT&) const
+    {
+        if (_bufsz <= buff_threshold || _bufsz <= diff_threshold) {
+            // buffer too small to compress
+            return 0;
+        }
+
+        ThreadContext& rctx = ThreadContext::get();
+        // anything bigger is not worth sending compressed - zstd stops early
+        const size_t capacity = _bufsz - diff_threshold;
+        size_t       len      = 0;
+
+        if (dict_ptr) {
+            len = ZSTD_compress_usingCDict(rctx.cctx_ptr.get(), rctx.buffer, capacity, _piobuf, _bufsz, dict_ptr->compressionDictionary());
+        } else {
+            len = ZSTD_compressCCtx(rctx.cctx_ptr.get(), rctx.buffer, capacity, _piobuf, _bufsz, level);
+        }
+
+        if (ZSTD_isError(len)) {
+            return 0; // compression not eficient
+        }
+
+        memcpy(_piobuf, rctx.buffer, len);
+        return len;
+    }
+
+    // decompression:
+    size_t operator()(char* _pto, const char* _pfrom, size_t _from_sz, ErrorConditionT& _rerror) const
+    {
+        ThreadContext& rctx = ThreadContext::get();
+        size_t         len  = 0;
+
+        if (dict_ptr) {
+            len = ZSTD_decompress_usingDDict(rctx.dctx_ptr.get(), _pto, Protocol::MaxPacketDataSize, _pfrom, _from_sz, dict_ptr->decompressionDictionary());
+        } else {
+            len = ZSTD_decompressDCtx(rctx.dctx_ptr.get(), _pto, Protocol::MaxPacketDataSize, _pfrom, _from_sz);
+        }
+
+        if (ZSTD_isError(len)) {
+            _rerror = error_compression_engine;
+            return 0;
+        }
+        return len;
+    }
+};
+
+//! Add zstd to the compression engines negotiated per connection
+/*!
+    Register every dictionary under its own id, the same on all peers.
+    With a dictionary, _level is the one the dictionary was created with.
+*/
+inline void registerEngine(
+    mprpc::Configuration& _rcfg,
+    Dictionary::PointerT  _dict_ptr       = nullptr,
+    const uint8_t         _id             = engine_id,
+    int                   _level          = 1,
+    size_t                _buff_threshold = 64,
+    size_t                _diff_threshold = 16)
+{
+    _rcfg.registerCompressionEngine(_id, Engine(_buff_threshold, _diff_threshold, _level, _dict_ptr), Engine(_buff_threshold, _diff_threshold, _level, _dict_ptr));
+}
+
+} // namespace zstd
+} // namespace mprpc
+} // namespace frame
+} // namespace solid
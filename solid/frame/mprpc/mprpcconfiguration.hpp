@@ -70,6 +70,7 @@ struct RelayData {
     RelayDataFlagsT       flags_;
     MessageHeader::FlagsT message_flags_   = 0;
     MessageHeader*        pmessage_header_ = nullptr;
+    ActorIdT              connection_id_; // the connection that received buffer_
 
     RelayData() = default;
 
@@ -82,6 +83,7 @@ struct RelayData {
         , flags_(_rrelmsg.flags_)
         , message_flags_(_rrelmsg.message_flags_)
         , pmessage_header_(_rrelmsg.pmessage_header_)
+        , connection_id_(_rrelmsg.connection_id_)
     {
     }
 
@@ -94,6 +96,7 @@ struct RelayData {
         flags_           = _rrelmsg.flags_;
         message_flags_   = _rrelmsg.message_flags_;
         pmessage_header_ = _rrelmsg.pmessage_header_;
+        connection_id_   = _rrelmsg.connection_id_;
         return *this;
     }
 
@@ -104,7 +107,7 @@ struct RelayData {
     {
         pdata_     = nullptr;
         data_size_ = 0;
-        // connection_id_.clear();
+        connection_id_.clear();
         buffer_.reset();
         pnext_ = nullptr;
         flags_.reset();
@@ -143,10 +146,12 @@ private:
         const SharedBuffer& _buffer,
         const char*         _pdata,
         size_t              _data_size,
+        const ActorIdT&     _rconnection_id,
         const bool          _is_last)
         : buffer_(_buffer)
         , pdata_(_pdata)
         , data_size_(_data_size)
+        , connection_id_(_rconnection_id)
     {
         if (_is_last) {
             flags_.set(RelayDataFlagsE::Last);
@@ -298,6 +303,9 @@ using ConnectionRecvRawDataCompleteFunctionT    = solid_function_t(void(Connecti
 using ConnectionOnEventFunctionT                = solid_function_t(void(ConnectionContext&, EventBase&));
 using PoolOnEventFunctionT                      = solid_function_t(void(ConnectionContext&, EventBase&&, const ErrorConditionT&));
 using ActorCreateFunctionT                      = solid_function_t(ActorIdT(aio::ActorPointerT&&, frame::Service&, EventBase&&, ErrorConditionT&));
+using ActorCreateOnFunctionT                    = solid_function_t(ActorIdT(aio::ActorPointerT&&, frame::Service&, const size_t, EventBase&&, ErrorConditionT&));
+using ActorCreateNearFunctionT                  = solid_function_t(ActorIdT(aio::ActorPointerT&&, frame::Service&, const int, EventBase&&, ErrorConditionT&));
+using ReactorCountFunctionT                     = solid_function_t(size_t());
 
 enum struct ConnectionState {
     Raw,
@@ -319,6 +327,90 @@ struct WriterConfiguration {
     size_t            max_message_count_response_wait;
     size_t            max_message_continuous_packet_count;
     CompressFunctionT inplace_compress_fnc;
+    // Send relayed payloads directly from the relay buffers (scatter/gather) instead of copying them.
+    // Packets carrying such payloads are not compressed.
+    bool              relay_by_reference;
+    // Send with MSG_ZEROCOPY the writes referencing at least this many relayed bytes (0 - disabled).
+    // Needs relay_by_reference and a plain (not secure) socket on Linux.
+    size_t            relay_zero_copy_min_size;
+    // On jumbo packets, multiplexed messages are interleaved every message_quantum_size bytes (at most 65535).
+    size_t            message_quantum_size;
+    // Compression is bypassed after compression_bypass_fail_count consecutive packets that did not
+    // compress well (0 - never bypass) for compression_bypass_packet_count packets - doubled
+    // on every failed retry, up to 64 times.
+    size_t            compression_bypass_fail_count;
+    size_t            compression_bypass_packet_count;
+};
+
+//! A compression engine negotiated per connection
+/*!
+    Peers advertise the ids of the engines they have and every writer uses
+    the first engine, in configuration order, also known by the peer.
+    Peers must register the same engine (and dictionary) under the same id.
+*/
+struct CompressionEngine {
+    uint8_t             id = 0; // 1 to Protocol::MaxCompressionEngineId
+    CompressFunctionT   compress_fnc;
+    UncompressFunctionT decompress_fnc;
+};
+
+using CompressionEngineVectorT = std::vector<CompressionEngine>;
+
+//! Receive buffer sizing state of a connection - updated by the RecvBufferPolicy
+struct RecvBufferStatus {
+    uint32_t full_count_  = 0; // consecutive reads that filled the offered space
+    uint32_t light_count_ = 0; // consecutive reads using less than a quarter of the buffer
+};
+
+//! Decides the receive buffer capacity of a connection
+/*!
+ * The connection keeps the capacity between connection_recv_buffer_start_capacity_kb
+ * (it must fit a whole packet) and connection_recv_buffer_max_capacity_kb.
+ */
+class RecvBufferPolicy {
+public:
+    using PointerT = std::shared_ptr<RecvBufferPolicy>;
+
+    virtual ~RecvBufferPolicy();
+
+    //! Capacity wanted after a read of _read_size bytes in _offered_size bytes of a _capacity bytes buffer
+    /*!
+     * Returning another value than _capacity makes the connection move the
+     * unconsumed data to a new buffer of the returned capacity.
+     */
+    virtual size_t onRead(RecvBufferStatus& _rstatus, const size_t _capacity, const size_t _read_size, const size_t _offered_size) const = 0;
+
+    //! The number of reads done on a receive notification before letting other actors run
+    virtual size_t readRepeatCount(const RecvBufferStatus& _rstatus, const size_t _capacity) const = 0;
+
+    //! Connections receiving nothing for this long release their receive buffer - zero disables releasing
+    virtual std::chrono::milliseconds idleReleaseTimeout() const = 0;
+};
+
+//! Grows the receive buffer of connections receiving bulk data and shrinks it back
+/*!
+ * The capacity doubles after grow_full_count consecutive reads filling the
+ * offered space and halves after shrink_light_count consecutive reads using
+ * less than a quarter of the buffer.
+ * Every receive notification reads up to read_budget bytes (at least
+ * min_read_repeat_count reads) before letting the connection write.
+ * Raise connection_recv_buffer_max_capacity_kb (and read_budget) for
+ * bulk transfer connections.
+ */
+class AdaptiveRecvBufferPolicy : public RecvBufferPolicy {
+public:
+    uint32_t                  grow_full_count       = 2;
+    uint32_t                  shrink_light_count    = 64;
+    size_t                    read_budget           = 64 * 1024;
+    size_t                    min_read_repeat_count = 1;
+    size_t                    max_read_repeat_count = 64;
+    std::chrono::milliseconds idle_release_timeout  = std::chrono::seconds(10);
+
+    size_t onRead(RecvBufferStatus& _rstatus, const size_t _capacity, const size_t _read_size, const size_t _offered_size) const override;
+
+    size_t readRepeatCount(const RecvBufferStatus& _rstatus, const size_t _capacity) const override;
+
+    std::chrono::milliseconds idleReleaseTimeout() const override;
 };
 
 class Configuration {
@@ -340,24 +432,34 @@ public:
     size_t pool_mutex_count;
     bool   relay_enabled;
 
-    ReaderConfiguration reader;
-    WriterConfiguration writer;
+    ReaderConfiguration      reader;
+    WriterConfiguration      writer;
+    CompressionEngineVectorT compression_engine_vec; // in order of preference
 
     std::chrono::milliseconds          connection_timeout_recv                  = std::chrono::minutes(10);
     std::chrono::milliseconds          connection_timeout_send_soft             = std::chrono::seconds(10);
     std::chrono::milliseconds          connection_timeout_send_hard             = std::chrono::minutes(5);
-    uint8_t                            connection_recv_buffer_start_capacity_kb = 0;
-    uint8_t                            connection_recv_buffer_max_capacity_kb   = 64;
+    uint32_t                           connection_recv_buffer_start_capacity_kb = 0;
+    uint32_t                           connection_recv_buffer_max_capacity_kb   = 64;
     uint8_t                            connection_send_buffer_start_capacity_kb = 0;
     uint8_t                            connection_send_buffer_max_capacity_kb   = 64;
     uint16_t                           connection_relay_buffer_count            = 8;
+    // Biggest packet sent to and accepted from peers also configured with jumbo packets (0 - disabled).
+    // It is negotiated on every connection - peers not supporting it keep using 64KB packets.
+    uint32_t                           connection_jumbo_packet_max_size_kb      = 0;
+    // Allow the scheduler to move connections between its reactors - see frame::aio::Rebalancer.
+    bool                               connection_migratable                    = false;
     ConnectionStopFunctionT            connection_stop_fnc;
     ConnectionOnEventFunctionT         connection_on_event_fnc;
     ConnectionSendTimeoutSoftFunctionT connection_on_send_timeout_soft_ = [](ConnectionContext&) {};
     RecvAllocateBufferFunctionT        connection_recv_buffer_allocate_fnc;
+    RecvBufferPolicy::PointerT         connection_recv_buffer_policy_ptr;
     SendAllocateBufferFunctionT        connection_send_buffer_allocate_fnc;
     Protocol::PointerT                 protocol_ptr;
     ActorCreateFunctionT               actor_create_fnc;
+    ActorCreateOnFunctionT             actor_create_on_fnc; // start the actor on a given reactor
+    ActorCreateNearFunctionT           actor_create_near_fnc; // start the actor on a reactor local to a given cpu
+    ReactorCountFunctionT              reactor_count_fnc;
 
     struct Server {
         using ConnectionCreateSocketFunctionT    = solid_function_t(SocketStubPtrT(Configuration const&, frame::aio::ActorProxy const&, SocketDevice&&, char*));
@@ -375,6 +477,11 @@ public:
         ServerSetupSocketDeviceFunctionT   socket_device_setup_fnc;
         std::string                        listener_address_str;
         std::string                        listener_service_str;
+        // One SO_REUSEPORT listener per reactor; accepted connections stay on the accepting reactor.
+        bool                               listener_reuse_port = false;
+        // Start accepted connections on a reactor local to the cpu handling their NIC receive queue (SO_INCOMING_CPU).
+        // Needs a scheduler started with a SchedulerPlacement.
+        bool                               connection_near_incoming_cpu = false;
         Any<>                              secure_any;
 
         Server()
@@ -448,6 +555,15 @@ public:
         actor_create_fnc = [&_rsch](aio::ActorPointerT&& _actor_ptr, frame::Service& _rsvc, EventBase&& _event, ErrorConditionT& _rerror) {
             return _rsch.startActor(std::move(_actor_ptr), _rsvc, std::move(_event), _rerror);
         };
+        actor_create_on_fnc = [&_rsch](aio::ActorPointerT&& _actor_ptr, frame::Service& _rsvc, const size_t _reactor_index, EventBase&& _event, ErrorConditionT& _rerror) {
+            return _rsch.startActor(std::move(_actor_ptr), _rsvc, _reactor_index, std::move(_event), _rerror);
+        };
+        actor_create_near_fnc = [&_rsch](aio::ActorPointerT&& _actor_ptr, frame::Service& _rsvc, const int _cpu, EventBase&& _event, ErrorConditionT& _rerror) {
+            return _rsch.startActorNearCpu(std::move(_actor_ptr), _rsvc, _cpu, std::move(_event), _rerror);
+        };
+        reactor_count_fnc = [&_rsch]() {
+            return _rsch.workerCount();
+        };
         init();
     }
 
@@ -464,6 +580,15 @@ public:
         actor_create_fnc = [&_rsch](aio::ActorPointerT&& _actor_ptr, frame::Service& _rsvc, EventBase&& _event, ErrorConditionT& _rerror) {
             return _rsch.startActor(std::move(_actor_ptr), _rsvc, std::move(_event), _rerror);
         };
+        actor_create_on_fnc = [&_rsch](aio::ActorPointerT&& _actor_ptr, frame::Service& _rsvc, const size_t _reactor_index, EventBase&& _event, ErrorConditionT& _rerror) {
+            return _rsch.startActor(std::move(_actor_ptr), _rsvc, _reactor_index, std::move(_event), _rerror);
+        };
+        actor_create_near_fnc = [&_rsch](aio::ActorPointerT&& _actor_ptr, frame::Service& _rsvc, const int _cpu, EventBase&& _event, ErrorConditionT& _rerror) {
+            return _rsch.startActorNearCpu(std::move(_actor_ptr), _rsvc, _cpu, std::move(_event), _rerror);
+        };
+        reactor_count_fnc = [&_rsch]() {
+            return _rsch.workerCount();
+        };
         init();
     }
 
@@ -513,8 +638,63 @@ public:
 
     SharedBuffer allocateRecvBuffer() const;
 
+    SharedBuffer allocateRecvBuffer(const size_t _capacity) const;
+
+    size_t recvBufferStartCapacity() const
+    {
+        return connection_recv_buffer_start_capacity_kb * 1024;
+    }
+
+    size_t recvBufferMaxCapacity() const
+    {
+        return connection_recv_buffer_max_capacity_kb * 1024;
+    }
+
+    const RecvBufferPolicy& recvBufferPolicy() const
+    {
+        return *connection_recv_buffer_policy_ptr;
+    }
+
     SharedBuffer allocateSendBuffer() const;
 
+    SharedBuffer allocateSendBuffer(const size_t _capacity) const;
+
+    bool hasJumboPackets() const
+    {
+        return connection_jumbo_packet_max_size_kb != 0;
+    }
+
+    size_t jumboPacketMaxSize() const
+    {
+        return connection_jumbo_packet_max_size_kb * 1024;
+    }
+
+    void registerCompressionEngine(const uint8_t _id, CompressFunctionT&& _compress_fnc, UncompressFunctionT&& _decompress_fnc)
+    {
+        compression_engine_vec.emplace_back(CompressionEngine{_id, std::move(_compress_fnc), std::move(_decompress_fnc)});
+    }
+
+    //! Bit i is set for the registered engine with id i
+    uint32_t compressionEngineMask() const
+    {
+        uint32_t mask = 0;
+        for (const auto& engine : compression_engine_vec) {
+            mask |= (1u << engine.id);
+        }
+        return mask;
+    }
+
+    //! The index of the first engine the peer also has, InvalidIndex() if none
+    size_t compressionEngineIndex(const uint32_t _peer_mask) const
+    {
+        for (size_t i = 0; i < compression_engine_vec.size(); ++i) {
+            if ((_peer_mask & (1u << compression_engine_vec[i].id)) != 0) {
+                return i;
+            }
+        }
+        return InvalidIndex();
+    }
+
     void check() const;
 
     Protocol& protocol()
@@ -163,6 +163,10 @@ class Protocol : NonCopyable {
 
 public:
     static constexpr size_t MaxPacketDataSize = 1024 * 64;
+    // biggest packet accepted from peers that negotiated jumbo packets - 22 bits of packet size
+    static constexpr size_t MaxJumboPacketDataSize = 1024 * 1024 * 4 - 1;
+    // negotiated compression engines are identified on the wire by 5 bits
+    static constexpr uint8_t MaxCompressionEngineId = 31;
 
     using PointerT = std::shared_ptr<Protocol>;
 
@@ -9,7 +9,9 @@
 //
 
 #pragma once
+#include <functional>
 #include <optional>
+#include <vector>
 
 #include "solid/system/exception.hpp"
 #include "solid/system/statistic.hpp"
@@ -78,6 +80,8 @@ struct ServiceStatistic : solid::Statistic {
     std::atomic<uint64_t> send_message_context_count_;
     std::atomic<uint64_t> send_message_to_connection_count_;
     std::atomic<uint64_t> send_message_to_pool_count_;
+    std::atomic<uint64_t> send_message_batch_count_;
+    std::atomic<uint64_t> send_message_name_lookup_count_;
     std::atomic<uint64_t> reject_new_pool_message_count_;
     std::atomic<uint64_t> connection_new_pool_message_count_;
     std::atomic<uint64_t> connection_do_send_count_;
@@ -96,6 +100,7 @@ struct ServiceStatistic : solid::Statistic {
     std::atomic<uint64_t> connection_recv_buff_size_count_03_;
     std::atomic<uint64_t> connection_recv_buff_size_count_04_;
     std::atomic<uint64_t> connection_send_posted_;
+    std::atomic<uint64_t> connection_send_zero_copy_count_;
     std::atomic<uint64_t> max_fetch_size_;
     std::atomic<uint64_t> min_fetch_size_;
 
@@ -173,9 +178,15 @@ class RecipientUrl final {
     using ImplOptionalRelayT = std::optional<MessageRelayHeader>;
     using ImplURLDataT       = std::optional<std::variant<RecipientId, std::string_view>>;
     const ImplURLDataT       url_var_opt_;
-    ConnectionContext* const pctx_ = nullptr;
+    const size_t             url_hash_ = 0; // precomputed for the lock-free name lookup
+    ConnectionContext* const pctx_     = nullptr;
     const ImplOptionalRelayT relay_;
 
+    static size_t hash(const std::string_view& _url)
+    {
+        return std::hash<std::string_view>{}(_url);
+    }
+
     bool hasRecipientId() const
     {
         return url_var_opt_.has_value() && std::get_if<RecipientId>(&url_var_opt_.value());
@@ -229,6 +240,7 @@ public:
     RecipientUrl(
         const std::string_view& _url)
         : url_var_opt_(_url)
+        , url_hash_(hash(_url))
     {
     }
 
@@ -248,6 +260,7 @@ public:
     RecipientUrl(
         const std::string_view& _url, const RelayT& _relay)
         : url_var_opt_(_url)
+        , url_hash_(hash(_url))
         , relay_(_relay)
     {
     }
@@ -267,6 +280,66 @@ private:
     }
 };
 
+//! A group of messages for a single recipient
+/*!
+    Sent with Service::sendMessages: all the messages are enqueued under
+    a single pool lock and every connection is notified at most once.
+    On return, the batch only keeps the messages that were not enqueued.
+*/
+class MessageBatch final {
+    friend class Service;
+    struct Stub {
+        MessagePointerT<>        message_ptr_;
+        MessageCompleteFunctionT complete_fnc_;
+        MessageFlagsT            flags_;
+        size_t                   type_index_ = 0;
+    };
+    using StubVectorT = std::vector<Stub>;
+
+    StubVectorT stub_vec_;
+
+public:
+    MessageBatch() = default;
+
+    explicit MessageBatch(const size_t _capacity)
+    {
+        stub_vec_.reserve(_capacity);
+    }
+
+    template <class T>
+    MessageBatch& add(MessagePointerT<T> const& _rmsgptr, const MessageFlagsT& _flags = 0)
+    {
+        stub_vec_.emplace_back(Stub{solid::static_pointer_cast<Message>(_rmsgptr), MessageCompleteFunctionT{}, _flags});
+        return *this;
+    }
+
+    template <class T, class Fnc>
+    MessageBatch& add(MessagePointerT<T> const& _rmsgptr, Fnc _complete_fnc, const MessageFlagsT& _flags = 0)
+    {
+        using CompleteHandlerT = CompleteHandler<Fnc,
+            typename message_complete_traits<decltype(_complete_fnc)>::send_type,
+            typename message_complete_traits<decltype(_complete_fnc)>::recv_type>;
+
+        stub_vec_.emplace_back(Stub{solid::static_pointer_cast<Message>(_rmsgptr), MessageCompleteFunctionT{CompleteHandlerT(std::forward<Fnc>(_complete_fnc))}, _flags});
+        return *this;
+    }
+
+    size_t size() const
+    {
+        return stub_vec_.size();
+    }
+
+    bool empty() const
+    {
+        return stub_vec_.empty();
+    }
+
+    void clear()
+    {
+        stub_vec_.clear();
+    }
+};
+
 //! Message Passing Remote Procedure Call Service
 /*!
     Allows exchanging ipc::Messages between processes.
@@ -355,6 +428,16 @@ public:
         MessageId&                _rmsg_id,
         const MessageFlagsT&      _flags = 0);
 
+    // send a batch of messages to the same recipient ------------------------
+    ErrorConditionT sendMessages(
+        const RecipientUrl& _recipient_url,
+        MessageBatch&       _rbatch);
+
+    ErrorConditionT sendMessages(
+        const RecipientUrl& _recipient_url,
+        MessageBatch&       _rbatch,
+        RecipientId&        _rrecipient_id);
+
     // send request using recipient name --------------------------------------
 
     template <class T, class Fnc>
@@ -570,8 +653,9 @@ private:
 
     void doFinalizeStart(ServiceStartStatus& _status, Configuration&& _ucfg, SocketDevice&& _usd, std::unique_lock<std::mutex>& _lock);
     void doFinalizeStart(ServiceStartStatus& _status, std::unique_lock<std::mutex>& _lock);
+    void doStartListeners(ServiceStartStatus& _status, SocketDevice& _rsd, std::unique_lock<std::mutex>& _lock);
 
-    void acceptIncomingConnection(SocketDevice& _rsd);
+    void acceptIncomingConnection(SocketDevice& _rsd, const size_t _reactor_index);
 
     ErrorConditionT activateConnection(ConnectionContext& _rconctx, ActorIdT const& _ractui);
 
@@ -621,6 +705,10 @@ private:
         RecipientId*              _precipient_id_out,
         MessageId*                _pmsg_id_out,
         const MessageFlagsT&      _flags);
+    ErrorConditionT doSendMessages(
+        const RecipientUrl& _recipient_url,
+        MessageBatch&       _rbatch,
+        RecipientId*        _precipient_id_out);
     ErrorConditionT doSendMessageUsingConnectionContext(
         const RecipientUrl&       _recipient_url,
         MessagePointerT<>&        _rmsgptr,
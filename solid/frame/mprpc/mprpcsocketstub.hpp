@@ -30,6 +30,7 @@ public:
     typedef void (*OnSendF)(frame::aio::ReactorContext&);
     typedef void (*OnSecureAcceptF)(frame::aio::ReactorContext&);
     typedef void (*OnSecureConnectF)(frame::aio::ReactorContext&);
+    typedef void (*OnZeroCopyF)(frame::aio::ReactorContext&, const uint32_t);
 
     static void emplace_deleter(SocketStub* _pss)
     {
@@ -76,6 +77,13 @@ public:
         frame::aio::ReactorContext& _rctx, OnSendF _pf, char* _buf, size_t _bufcp)
         = 0;
 
+    virtual bool sendAllv(
+        frame::aio::ReactorContext& _rctx, OnSendF _pf, ConstBuffer* _pbufs, size_t _count, const bool _zero_copy)
+        = 0;
+
+    virtual ErrorCodeT enableZeroCopy(frame::aio::ReactorContext& _rctx, OnZeroCopyF _pf);
+    virtual uint32_t   zeroCopySendCount() const;
+
     virtual void prepareSocket(
         frame::aio::ReactorContext& _rctx)
         = 0;
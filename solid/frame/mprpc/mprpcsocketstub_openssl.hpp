@@ -177,6 +177,12 @@ private:
         return sock.sendAll(_rctx, _buf, _bufcp, _pf);
     }
 
+    bool sendAllv(
+        frame::aio::ReactorContext& _rctx, OnSendF _pf, ConstBuffer* _pbufs, size_t _count, const bool _zero_copy) override final
+    {
+        return sock.sendAllv(_rctx, _pbufs, _count, _pf, _zero_copy);
+    }
+
     void prepareSocket(
         frame::aio::ReactorContext& _rctx) override final
     {
@@ -16,6 +16,7 @@
 #include "solid/system/exception.hpp"
 #include "solid/system/memory.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 namespace solid {
@@ -47,7 +48,7 @@ SharedBuffer default_allocate_recv_buffer(const uint32_t _cp)
 
 SharedBuffer default_allocate_send_buffer(const uint32_t _cp)
 {
-    return make_shared_buffer(_cp);
+    return BufferManager::make(_cp);
 }
 
 // void empty_reset_serializer_limits(ConnectionContext &, serialization::binary::Limits&){}
@@ -103,6 +104,48 @@ WriterConfiguration::WriterConfiguration()
     max_message_continuous_packet_count = 4;
     max_message_count_response_wait     = 128;
     inplace_compress_fnc                = &default_compress;
+    relay_by_reference                  = true;
+    relay_zero_copy_min_size            = 0;
+    message_quantum_size                = 32 * 1024;
+    compression_bypass_fail_count       = 16;
+    compression_bypass_packet_count     = 32;
+}
+//-----------------------------------------------------------------------------
+/*virtual*/ RecvBufferPolicy::~RecvBufferPolicy()
+{
+}
+//-----------------------------------------------------------------------------
+size_t AdaptiveRecvBufferPolicy::onRead(RecvBufferStatus& _rstatus, const size_t _capacity, const size_t _read_size, const size_t _offered_size) const
+{
+    if (_read_size != 0 && _read_size == _offered_size) {
+        // more data is probably waiting in the socket
+        _rstatus.light_count_ = 0;
+        if (++_rstatus.full_count_ >= grow_full_count) {
+            _rstatus.full_count_ = 0;
+            return _capacity * 2;
+        }
+    } else if (_read_size < _capacity / 4) {
+        _rstatus.full_count_ = 0;
+        if (++_rstatus.light_count_ >= shrink_light_count) {
+            _rstatus.light_count_ = 0;
+            return _capacity / 2;
+        }
+    } else {
+        _rstatus.full_count_  = 0;
+        _rstatus.light_count_ = 0;
+    }
+    return _capacity;
+}
+//-----------------------------------------------------------------------------
+size_t AdaptiveRecvBufferPolicy::readRepeatCount(const RecvBufferStatus& /*_rstatus*/, const size_t _capacity) const
+{
+    const size_t count = _capacity != 0 ? read_budget / _capacity : max_read_repeat_count;
+    return std::max(min_read_repeat_count, std::min(count, max_read_repeat_count));
+}
+//-----------------------------------------------------------------------------
+std::chrono::milliseconds AdaptiveRecvBufferPolicy::idleReleaseTimeout() const
+{
+    return idle_release_timeout;
 }
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -194,6 +237,7 @@ void Configuration::init()
     connection_recv_buffer_max_capacity_kb = connection_send_buffer_max_capacity_kb = 64;
 
     connection_recv_buffer_allocate_fnc = &default_allocate_recv_buffer;
+    connection_recv_buffer_policy_ptr   = std::make_shared<AdaptiveRecvBufferPolicy>();
     connection_send_buffer_allocate_fnc = &default_allocate_send_buffer;
 
     connection_stop_fnc = &empty_connection_stop;
@@ -300,14 +344,28 @@ void Configuration::prepare()
         pool_max_pending_connection_count = 1;
     }
 
-    if (connection_recv_buffer_max_capacity_kb > 64) {
-        connection_recv_buffer_max_capacity_kb = 64;
-    }
-
     if (connection_send_buffer_max_capacity_kb > 64) {
         connection_send_buffer_max_capacity_kb = 64;
     }
 
+    if (jumboPacketMaxSize() <= Protocol::MaxPacketDataSize) {
+        connection_jumbo_packet_max_size_kb = 0;
+    } else if (jumboPacketMaxSize() > Protocol::MaxJumboPacketDataSize) {
+        connection_jumbo_packet_max_size_kb = Protocol::MaxJumboPacketDataSize / 1024;
+    }
+
+    if (hasJumboPackets() && connection_recv_buffer_max_capacity_kb <= connection_jumbo_packet_max_size_kb) {
+        // the receive buffer must fit a whole packet
+        connection_recv_buffer_max_capacity_kb = connection_jumbo_packet_max_size_kb + 1;
+    }
+
+    writer.message_quantum_size = std::clamp(writer.message_quantum_size, static_cast<size_t>(1024), static_cast<size_t>(0xffff));
+
+    for (auto it = compression_engine_vec.begin(); it != compression_engine_vec.end(); ++it) {
+        solid_check_log(it->id != 0 && it->id <= Protocol::MaxCompressionEngineId, service_logger(), "invalid compression engine id " << static_cast<int>(it->id));
+        solid_check_log(std::none_of(compression_engine_vec.begin(), it, [id = it->id](const CompressionEngine& _engine) { return _engine.id == id; }), service_logger(), "duplicate compression engine id " << static_cast<int>(it->id));
+    }
+
     if (connection_recv_buffer_start_capacity_kb > connection_recv_buffer_max_capacity_kb) {
         connection_recv_buffer_start_capacity_kb = connection_recv_buffer_max_capacity_kb;
     }
@@ -354,6 +412,12 @@ void Configuration::createListenerDevice(SocketDevice& _rsd) const
         for (auto it = rd.begin(); it != rd.end(); ++it) {
             SocketDevice sd;
             sd.create(it);
+            if (server.listener_reuse_port) {
+                const auto err = sd.enableReusePort();
+                if (err) {
+                    solid_log(service_logger(), Warning, "failed to enable SO_REUSEPORT: " << err.message());
+                }
+            }
             const auto err = sd.prepareAccept(it, SocketInfo::max_listen_backlog_size());
             if (!err) {
                 _rsd = std::move(sd);
@@ -368,7 +432,12 @@ void Configuration::createListenerDevice(SocketDevice& _rsd) const
 //-----------------------------------------------------------------------------
 SharedBuffer Configuration::allocateRecvBuffer() const
 {
-    return connection_recv_buffer_allocate_fnc(connection_recv_buffer_start_capacity_kb * 1024);
+    return connection_recv_buffer_allocate_fnc(recvBufferStartCapacity());
+}
+//-----------------------------------------------------------------------------
+SharedBuffer Configuration::allocateRecvBuffer(const size_t _capacity) const
+{
+    return connection_recv_buffer_allocate_fnc(static_cast<uint32_t>(std::max(_capacity, recvBufferStartCapacity())));
 }
 //-----------------------------------------------------------------------------
 SharedBuffer Configuration::allocateSendBuffer() const
@@ -376,6 +445,11 @@ SharedBuffer Configuration::allocateSendBuffer() const
     return connection_send_buffer_allocate_fnc(connection_send_buffer_start_capacity_kb * 1024);
 }
 //-----------------------------------------------------------------------------
+SharedBuffer Configuration::allocateSendBuffer(const size_t _capacity) const
+{
+    return connection_send_buffer_allocate_fnc(static_cast<uint32_t>(_capacity));
+}
+//-----------------------------------------------------------------------------
 } // namespace mprpc
 } // namespace frame
 } // namespace solid
@@ -13,6 +13,7 @@
 #include "solid/frame/mprpc/mprpcerror.hpp"
 #include "solid/frame/mprpc/mprpcservice.hpp"
 #include "solid/utility/event.hpp"
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
 
@@ -39,6 +40,7 @@ enum class ConnectionEvents {
     Stopping,
     RelayNew,
     RelayDone,
+    RelayBuffer,
     Post,
     Invalid,
 };
@@ -77,6 +79,8 @@ const EventCategory<ConnectionEvents> connection_event_category{
             return "RelayNew";
         case ConnectionEvents::RelayDone:
             return "RelayDone";
+        case ConnectionEvents::RelayBuffer:
+            return "RelayBuffer";
         case ConnectionEvents::Post:
             return "Post";
         case ConnectionEvents::Invalid:
@@ -253,6 +257,24 @@ inline void Connection::doOptimizeRecvBufferForced()
     recv_buf_.resize(remaining_size);
 }
 //-----------------------------------------------------------------------------
+// Let the RecvBufferPolicy resize the receive buffer after a read of _sz bytes.
+void Connection::doAdaptRecvBuffer(Configuration const& _rconfig, const size_t _sz)
+{
+    const size_t capacity       = std::max(std::clamp(_rconfig.recvBufferPolicy().onRead(recv_buf_status_, recv_buf_.capacity(), _sz, recv_buf_offered_size_), _rconfig.recvBufferStartCapacity(), _rconfig.recvBufferMaxCapacity()), msg_reader_.pendingPacketSize());
+    const size_t remaining_size = recv_buf_.size() - cons_buf_off_;
+
+    if (capacity != recv_buf_.capacity() && remaining_size <= capacity) {
+        solid_log(logger, Verbose, this << " recv buffer capacity " << recv_buf_.capacity() << " -> " << capacity);
+        SharedBuffer new_buf = _rconfig.allocateRecvBuffer(capacity);
+
+        memcpy(new_buf.data(), recv_buf_.data() + cons_buf_off_, remaining_size);
+        new_buf.resize(remaining_size);
+        cons_buf_off_ = 0;
+        recv_buf_     = std::move(new_buf);
+        recv_buf_vec_.clear(); // buffers returned by the relay engine have the old capacity
+    }
+}
+//-----------------------------------------------------------------------------
 Connection::Connection(
     Configuration const&    _rconfiguration,
     ConnectionPoolId const& _rpool_id,
@@ -264,6 +286,7 @@ Connection::Connection(
     , sock_ptr_(_rconfiguration.client.connection_create_socket_fnc(_rconfiguration, this->proxy(), this->socket_emplace_buf_))
 {
     solid_log(logger, Info, this);
+    migratable(_rconfiguration.connection_migratable);
 }
 //-----------------------------------------------------------------------------
 Connection::Connection(
@@ -278,6 +301,7 @@ Connection::Connection(
     , sock_ptr_(_rconfiguration.server.connection_create_socket_fnc(_rconfiguration, this->proxy(), std::move(_rsd), this->socket_emplace_buf_))
 {
     solid_log(logger, Info, this << " (" << local_endpoint(sock_ptr_->device()) << ") -> (" << remote_endpoint(sock_ptr_->device()) << ')');
+    migratable(_rconfiguration.connection_migratable);
 }
 //-----------------------------------------------------------------------------
 Connection::~Connection()
@@ -306,15 +330,23 @@ void Connection::doPrepare(frame::aio::ReactorContext& _rctx)
     recv_buf_count_ = 1;
     msg_reader_.prepare(service(_rctx).configuration().reader);
     msg_writer_.prepare(service(_rctx).configuration().writer);
+    if (config.hasJumboPackets()) {
+        msg_reader_.maxPacketDataSize(config.jumboPacketMaxSize());
+    }
+    msg_reader_.compressionEngines(config.compression_engine_vec);
     const auto crt_time      = _rctx.steadyTime();
     recv_keepalive_boundary_ = crt_time + config.server.connection_inactivity_keepalive_interval;
 }
 //-----------------------------------------------------------------------------
-void Connection::doUnprepare(frame::aio::ReactorContext& /*_rctx*/)
+void Connection::doUnprepare(frame::aio::ReactorContext& _rctx)
 {
     solid_log(logger, Verbose, this << ' ' << this->id());
     msg_reader_.unprepare();
     msg_writer_.unprepare();
+    if (!zero_copy_dq_.empty()) {
+        // NOTE: no more completions will be read - give the relay buffers back to their connections
+        doReleaseZeroCopy(_rctx, sock_ptr_->zeroCopySendCount());
+    }
 }
 //-----------------------------------------------------------------------------
 template <class Ctx>
@@ -327,9 +359,24 @@ void Connection::doStart(frame::aio::ReactorContext& _rctx, const bool _is_incom
     doPrepare(_rctx);
     prepareSocket(_rctx);
 
+    if (config.relay_enabled && config.writer.relay_by_reference && config.writer.relay_zero_copy_min_size != 0) {
+        const ErrorCodeT err = sock_ptr_->enableZeroCopy(_rctx, Connection::onZeroCopy);
+        if (!err) {
+            flags_.set(FlagsE::ZeroCopy);
+        } else {
+            solid_log(logger, Info, this << " zero-copy not available: " << err.message());
+        }
+    }
+
     const ConnectionState start_state  = _is_incoming ? config.server.connection_start_state : config.client.connection_start_state;
     const bool            start_secure = _is_incoming ? config.server.connection_start_secure : config.client.connection_start_secure;
 
+    if (!_is_incoming && (config.hasJumboPackets() || !config.compression_engine_vec.empty())) {
+        // the server answers with its own advertisement if it has jumbo packets or compression engines
+        flags_.set(FlagsE::Advertised);
+        msg_writer_.advertisePeerCapabilities(static_cast<uint32_t>(config.jumboPacketMaxSize()), config.compressionEngineMask());
+    }
+
     if (_is_incoming) {
         flags_.set(FlagsE::Server);
         if (!start_secure) {
@@ -1080,6 +1127,9 @@ void Connection::doHandleEventRecvRaw(frame::aio::ReactorContext& _rctx, EventBa
     solid_log(logger, Info, this);
 
     if (this->isRawState() && pdata != nullptr) {
+        if (!recv_buf_) {
+            recv_buf_ = service(_rctx).configuration().allocateRecvBuffer();
+        }
         if (recv_buf_.size() == cons_buf_off_) {
             if (this->postRecvSome(_rctx, recv_buf_.data(), recv_buf_.capacity(), _revent)) {
 
@@ -1124,6 +1174,36 @@ void Connection::doResetTimer(frame::aio::ReactorContext& _rctx)
     timer_.waitUntil(_rctx, min_timeout, onTimer<Ctx>);
 }
 //-----------------------------------------------------------------------------
+// Give back the receive buffer of a connection with nothing received for idleReleaseTimeout.
+// The pending read is replaced by one into recv_idle_buf_ and onRecv allocates
+// a new buffer when data arrives.
+template <class Ctx>
+void Connection::doReleaseIdleRecvBuffer(frame::aio::ReactorContext& _rctx)
+{
+    Configuration const& rconfig       = service(_rctx).configuration();
+    const auto           idle_boundary = recv_last_time_ + rconfig.recvBufferPolicy().idleReleaseTimeout();
+
+    if (_rctx.nanoTime() < idle_boundary) {
+        timeout_recv_idle_ = idle_boundary;
+        return;
+    }
+
+    if (!recv_buf_ || recv_buf_.size() != 0 || isStopping() || isRawState() || flags_.isSet(FlagsE::PauseRecv)) {
+        return;
+    }
+    solid_log(logger, Verbose, this << " release idle recv buffer of capacity " << recv_buf_.capacity());
+
+    sock_ptr_->cancelRecv(_rctx);
+    recv_buf_.reset();
+    recv_buf_vec_.clear();
+    cons_buf_off_    = 0;
+    recv_buf_status_ = RecvBufferStatus{};
+
+    const bool rv = postRecvSome<Ctx>(_rctx, recv_idle_buf_, sizeof(recv_idle_buf_)); // fully asynchronous call
+    solid_assert_log(!rv, logger);
+    (void)rv;
+}
+//-----------------------------------------------------------------------------
 template <class Ctx>
 /*static*/ void Connection::onTimer(frame::aio::ReactorContext& _rctx)
 {
@@ -1172,6 +1252,11 @@ template <class Ctx>
         rconfig.connection_on_send_timeout_soft_(conctx);
     }
 
+    if (crt_time >= rthis.timeout_recv_idle_) {
+        rthis.timeout_recv_idle_ = NanoTime::max();
+        rthis.doReleaseIdleRecvBuffer<Ctx>(_rctx);
+    }
+
     if (crt_time >= rthis.timeout_keepalive_) {
         solid_log(logger, Info, &rthis << " " << rthis.flags_.toString() << " keep alive timeout = " << rthis.timeout_keepalive_ << " crt_time = " << crt_time);
         solid_assert(!rthis.isServer());
@@ -1255,11 +1340,15 @@ void Connection::doResetRecvBuffer(frame::aio::ReactorContext& _rctx, const uint
     } else if (recv_buf_.useCount() > 1) {
         solid_log(logger, Verbose, this << " buffer used for relay - try replace it. vec_size = " << recv_buf_vec_.size() << " count = " << recv_buf_count_);
         SharedBuffer new_buf;
-        if (!recv_buf_vec_.empty()) {
-            new_buf = std::move(recv_buf_vec_.back());
+        while (!recv_buf_vec_.empty() && !new_buf) {
+            if (recv_buf_vec_.back().capacity() == recv_buf_.capacity()) {
+                new_buf = std::move(recv_buf_vec_.back());
+            }
             recv_buf_vec_.pop_back();
+        }
+        if (new_buf) {
         } else if (recv_buf_count_ < service(_rctx).configuration().connection_relay_buffer_count) {
-            new_buf = service(_rctx).configuration().allocateRecvBuffer();
+            new_buf = service(_rctx).configuration().allocateRecvBuffer(recv_buf_.capacity());
         } else {
             recv_buf_.reset();
             _rerr         = error_connection_too_many_recv_buffers;
@@ -1326,6 +1415,11 @@ struct ConnectionReceiver : MessageReaderReceiver {
         rcon_.doCompleteKeepalive<Ctx>(rctx_);
     }
 
+    void receivePeerCapabilities(const uint32_t _max_packet_size, const uint32_t _compression_engine_mask) override
+    {
+        rcon_.doCompletePeerCapabilities<Ctx>(rctx_, _max_packet_size, _compression_engine_mask);
+    }
+
     void receiveAckCount(uint8_t _count) override
     {
         rcon_.doCompleteAckCount<Ctx>(rctx_, _count);
@@ -1361,10 +1455,9 @@ template <class Ctx>
     Connection&             rthis = static_cast<Connection&>(_rctx.actor());
     ConnectionContext       conctx(_rctx, rthis.service(_rctx), rthis);
     const Configuration&    rconfig   = rthis.service(_rctx).configuration();
-    unsigned                repeatcnt = 4;
+    size_t                  repeatcnt = rconfig.recvBufferPolicy().readRepeatCount(rthis.recv_buf_status_, rthis.recv_buf_.capacity());
     char*                   pbuf      = nullptr;
     size_t                  bufsz     = 0;
-    const uint32_t          recvbufcp = rthis.recv_buf_.capacity();
     typename Ctx::ReceiverT rcvr(rthis, _rctx, rconfig.reader, rconfig.protocol(), conctx);
     ErrorConditionT         error;
 
@@ -1372,7 +1465,14 @@ template <class Ctx>
         solid_log(logger, Verbose, &rthis << " received size " << _sz);
         rthis.service(_rctx).wstatistic().connectionRecvBufferSize(_sz, rthis.recv_buf_.capacity());
 
+        const bool idle_wake = !rthis.recv_buf_;
+
         if (!_rctx.error()) {
+            if (idle_wake) {
+                // the recv buffer was released while idle - the data is in recv_idle_buf_
+                rthis.recv_buf_ = rconfig.allocateRecvBuffer();
+                memcpy(rthis.recv_buf_.data(), rthis.recv_idle_buf_, _sz);
+            }
             rthis.recv_buf_.append(_sz);
             pbuf  = rthis.recv_buf_.data() + rthis.cons_buf_off_;
             bufsz = rthis.recv_buf_.size() - rthis.cons_buf_off_;
@@ -1405,11 +1505,21 @@ template <class Ctx>
 
         solid_assert_log(rthis.recv_buf_, logger);
 
+        if (!idle_wake) {
+            rthis.doAdaptRecvBuffer(rconfig, _sz);
+        }
+
         pbuf = rthis.recv_buf_.data() + rthis.recv_buf_.size();
 
-        bufsz = recvbufcp - rthis.recv_buf_.size();
+        bufsz = rthis.recv_buf_.capacity() - rthis.recv_buf_.size();
         // solid_log(logger, Info, &rthis<<" buffer size "<<bufsz);
-    } while (repeatcnt != 0u && !rthis.flags_.isSet(FlagsE::PauseRecv) && rthis.recvSome<Ctx>(_rctx, pbuf, bufsz, _sz));
+    } while (repeatcnt != 0u && !rthis.flags_.isSet(FlagsE::PauseRecv) && !rthis.isStopping() && rthis.recvSome<Ctx>(_rctx, pbuf, bufsz, _sz));
+
+    rthis.recv_last_time_ = _rctx.nanoTime();
+    if (rthis.timeout_recv_idle_ == NanoTime::max() && rconfig.recvBufferPolicy().idleReleaseTimeout().count() != 0) {
+        rthis.timeout_recv_idle_ = rthis.recv_last_time_ + rconfig.recvBufferPolicy().idleReleaseTimeout();
+        rthis.doResetTimer<Ctx>(_rctx);
+    }
 
     if (rconfig.hasConnectionTimeoutRecv()) {
         rthis.timeout_recv_ = _rctx.nanoTime() + rconfig.connection_timeout_recv;
@@ -1468,7 +1578,21 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
                 write_flags.set(MessageWriter::WriteFlagsE::ShouldSendKeepAlive);
             }
 
-            WriteBuffer buffer{send_buf_.data(), send_buf_.capacity()};
+            if (send_buf_.useCount() != 1) {
+                // the kernel still references the buffer from a zero-copy write
+                if (!send_buf_free_vec_.empty()) {
+                    send_buf_ = std::move(send_buf_free_vec_.back());
+                    send_buf_free_vec_.pop_back();
+                } else {
+                    send_buf_ = rconfig.allocateSendBuffer();
+                }
+            }
+
+            if (msg_writer_.isJumbo() && send_buf_.capacity() < (PacketHeader::size_of_header + msg_writer_.maxPacketDataSize())) {
+                send_buf_ = rconfig.allocateSendBuffer(PacketHeader::size_of_header + msg_writer_.maxPacketDataSize());
+            }
+
+            WriteBuffer buffer{send_buf_.data(), send_buf_.capacity(), rconfig.writer.relay_by_reference ? &send_ref_vec_ : nullptr};
 
             error = msg_writer_.write(
                 buffer, write_flags, ackd_buf_count_, cancel_remote_msg_vec_, send_relay_free_count_, sender);
@@ -1477,7 +1601,7 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
 
             if (!error) {
                 service(_rctx).wstatistic().connectionSendBufferSize(buffer.size(), send_buf_.capacity());
-                if (!buffer.empty() && this->sendAll<Ctx>(_rctx, buffer.data(), buffer.size())) {
+                if (!buffer.empty() && this->sendAllv<Ctx>(_rctx, buffer, sender)) {
                     sent_something = true;
                     if (_rctx.error()) {
                         solid_log(logger, Error, this << ' ' << id() << " sending " << buffer.size() << ": " << _rctx.error().message());
@@ -1503,7 +1627,7 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
                 solid_log(logger, Error, this << ' ' << id() << " size to send " << buffer.size() << " error " << error.message());
 
                 if (!buffer.empty()) {
-                    this->sendAll<Ctx>(_rctx, buffer.data(), buffer.size());
+                    this->sendAllv<Ctx>(_rctx, buffer, sender);
                 }
 
                 doStop<Ctx>(_rctx, error);
@@ -1702,6 +1826,41 @@ void Connection::doCompleteMessage(
     return false;
 }
 //-----------------------------------------------------------------------------
+/*static*/ bool Connection::notify(Manager& _rm, const ActorIdT& _conuid, SharedBuffer&& _ubuf)
+{
+    return _rm.notify(_conuid, make_event(connection_event_category, ConnectionEvents::RelayBuffer, std::move(_ubuf)));
+}
+//-----------------------------------------------------------------------------
+// The peer accepts packets up to _max_packet_size and knows the compression engines in _compression_engine_mask:
+// use jumbo packets and the preferred common compression engine if we are configured for them too.
+template <class Ctx>
+void Connection::doCompletePeerCapabilities(frame::aio::ReactorContext& _rctx, const uint32_t _max_packet_size, const uint32_t _compression_engine_mask)
+{
+    Configuration const& config = service(_rctx).configuration();
+
+    if (config.hasJumboPackets() && _max_packet_size > Protocol::MaxPacketDataSize && !msg_writer_.isJumbo()) {
+        msg_writer_.maxPacketDataSize(std::min(config.jumboPacketMaxSize(), static_cast<size_t>(_max_packet_size)));
+
+        solid_log(logger, Info, this << " jumbo packets of " << msg_writer_.maxPacketDataSize() << " bytes");
+    }
+
+    if (msg_writer_.compressionEngine() == nullptr) {
+        const size_t engine_index = config.compressionEngineIndex(_compression_engine_mask);
+
+        if (engine_index != InvalidIndex()) {
+            msg_writer_.compressionEngine(&config.compression_engine_vec[engine_index]);
+
+            solid_log(logger, Info, this << " compression engine " << static_cast<int>(config.compression_engine_vec[engine_index].id));
+        }
+    }
+
+    if (isServer() && !flags_.has(FlagsE::Advertised) && (config.hasJumboPackets() || !config.compression_engine_vec.empty())) {
+        flags_.set(FlagsE::Advertised);
+        msg_writer_.advertisePeerCapabilities(static_cast<uint32_t>(config.jumboPacketMaxSize()), config.compressionEngineMask());
+        this->post(_rctx, [this](frame::aio::ReactorContext& _rctx, EventBase const& /*_revent*/) { this->doSend<Ctx>(_rctx); });
+    }
+}
+//-----------------------------------------------------------------------------
 template <class Ctx>
 void Connection::doCompleteKeepalive(frame::aio::ReactorContext& _rctx)
 {
@@ -1807,12 +1966,14 @@ bool Connection::postSendAll(frame::aio::ReactorContext& _rctx, const char* _pbu
 //-----------------------------------------------------------------------------
 bool Connection::postRecvSome(frame::aio::ReactorContext& _rctx, char* _pbuf, size_t _bufcp, EventBase& _revent)
 {
+    recv_buf_offered_size_ = _bufcp;
     return sock_ptr_->postRecvSome(_rctx, Connection::onRecvSomeRaw, _pbuf, _bufcp, _revent);
 }
 //-----------------------------------------------------------------------------
 template <class Ctx>
 bool Connection::postRecvSome(frame::aio::ReactorContext& _rctx, char* _pbuf, size_t _bufcp)
 {
+    recv_buf_offered_size_ = _bufcp;
     return sock_ptr_->postRecvSome(_rctx, Connection::onRecv<Ctx>, _pbuf, _bufcp);
 }
 //-----------------------------------------------------------------------------
@@ -1825,6 +1986,7 @@ bool Connection::connect(frame::aio::ReactorContext& _rctx, const SocketAddressI
 template <class Ctx>
 bool Connection::recvSome(frame::aio::ReactorContext& _rctx, char* _buf, size_t _bufcp, size_t& _sz)
 {
+    recv_buf_offered_size_ = _bufcp;
     return sock_ptr_->recvSome(_rctx, Connection::onRecv<Ctx>, _buf, _bufcp, _sz);
 }
 //-----------------------------------------------------------------------------
@@ -1835,6 +1997,96 @@ bool Connection::sendAll(frame::aio::ReactorContext& _rctx, char* _buf, size_t _
     return sock_ptr_->sendAll(_rctx, Connection::onSend<Ctx>, _buf, _bufcp);
 }
 //-----------------------------------------------------------------------------
+// The WriteBuffer may have holes for the relayed payloads sent by reference.
+// The relay buffers cannot be kept past this call so, if the send does not
+// complete synchronously, the payloads are copied into their holes before
+// completing the relay data.
+// With zero-copy, the kernel keeps referencing the written buffers after the
+// call - they are pinned until the completion (see doReleaseZeroCopy).
+template <class Ctx>
+bool Connection::sendAllv(frame::aio::ReactorContext& _rctx, WriteBuffer& _rbuffer, MessageWriterSender& _rsender)
+{
+    solid_check(!isStopping());
+    if (send_ref_vec_.empty()) {
+        return sock_ptr_->sendAll(_rctx, Connection::onSend<Ctx>, _rbuffer.data(), _rbuffer.size());
+    }
+
+    send_buf_vec_.clear();
+    size_t offset   = 0;
+    size_t ref_size = 0;
+    for (const auto& ref : send_ref_vec_) {
+        if (ref.offset_ != offset) {
+            send_buf_vec_.emplace_back(_rbuffer.data() + offset, ref.offset_ - offset);
+        }
+        if (ref.size_ != 0) {
+            send_buf_vec_.emplace_back(ref.data_, ref.size_);
+        }
+        offset = ref.offset_ + ref.size_;
+        ref_size += ref.size_;
+    }
+    if (offset != _rbuffer.size()) {
+        send_buf_vec_.emplace_back(_rbuffer.data() + offset, _rbuffer.size() - offset);
+    }
+
+    const size_t   zero_copy_min_size = configuration(_rctx).writer.relay_zero_copy_min_size;
+    const bool     zero_copy          = flags_.isSet(FlagsE::ZeroCopy) && ref_size >= zero_copy_min_size;
+    const uint32_t zero_copy_count    = sock_ptr_->zeroCopySendCount();
+    const bool     done               = sock_ptr_->sendAllv(_rctx, Connection::onSend<Ctx>, send_buf_vec_.data(), send_buf_vec_.size(), zero_copy);
+
+    if (zero_copy && sock_ptr_->zeroCopySendCount() != zero_copy_count) {
+        zero_copy_dq_.emplace_back(zero_copy_count, send_buf_, ActorIdT());
+        for (const auto& ref : send_ref_vec_) {
+            zero_copy_dq_.emplace_back(zero_copy_count, ref.prelay_data_->buffer_, ref.prelay_data_->connection_id_);
+        }
+        solid_statistic_inc(service(_rctx).wstatistic().connection_send_zero_copy_count_);
+    }
+
+    if (!done) {
+        for (const auto& ref : send_ref_vec_) {
+            char* pdest = _rbuffer.data() + ref.offset_;
+            memcpy(pdest, ref.data_, ref.size_);
+            // the pending vector may have been advanced inside the relayed payload
+            for (auto& buf : send_buf_vec_) {
+                if (buf.data_ >= ref.data_ && buf.data_ < (ref.data_ + ref.size_)) {
+                    buf.data_ = pdest + (buf.data_ - ref.data_);
+                }
+            }
+        }
+    }
+
+    for (const auto& ref : send_ref_vec_) {
+        if (ref.complete_) {
+            _rsender.completeRelayed(ref.prelay_data_, ref.relay_msg_id_);
+        }
+    }
+    send_ref_vec_.clear();
+    return done;
+}
+//-----------------------------------------------------------------------------
+/*static*/ void Connection::onZeroCopy(frame::aio::ReactorContext& _rctx, const uint32_t _count)
+{
+    Connection& rthis = static_cast<Connection&>(_rctx.actor());
+    rthis.doReleaseZeroCopy(_rctx, _count);
+}
+//-----------------------------------------------------------------------------
+// Release the buffers of the first _count zero-copy writes.
+// The last reference to a relay buffer is given back to the connection that
+// received it, for the buffer to be reused and acknowledged to the peer.
+void Connection::doReleaseZeroCopy(frame::aio::ReactorContext& _rctx, const uint32_t _count)
+{
+    while (!zero_copy_dq_.empty() && static_cast<int32_t>(_count - zero_copy_dq_.front().id_) > 0) {
+        auto& rstub = zero_copy_dq_.front();
+        if (auto buf = rstub.buffer_.collapse()) {
+            if (rstub.connection_id_.isValid()) {
+                Connection::notify(service(_rctx).manager(), rstub.connection_id_, std::move(buf));
+            } else {
+                send_buf_free_vec_.emplace_back(std::move(buf));
+            }
+        }
+        zero_copy_dq_.pop_front();
+    }
+}
+//-----------------------------------------------------------------------------
 void Connection::prepareSocket(frame::aio::ReactorContext& _rctx)
 {
     sock_ptr_->prepareSocket(_rctx);
@@ -1855,10 +2107,7 @@ void Connection::doResumeRead(frame::aio::ReactorContext& _rctx)
     if (flags_.isSet(FlagsE::PauseRecv)) {
         flags_.reset(FlagsE::PauseRecv);
 
-        const auto pbuf  = recv_buf_.data() + recv_buf_.size();
-        const auto bufsz = recv_buf_.capacity() - recv_buf_.size();
-
-        const bool rv = postRecvSome<Ctx>(_rctx, pbuf, bufsz); // fully asynchronous call
+        const bool rv = recv_buf_ ? postRecvSome<Ctx>(_rctx, recv_buf_.data() + recv_buf_.size(), recv_buf_.capacity() - recv_buf_.size()) : postRecvSome<Ctx>(_rctx, recv_idle_buf_, sizeof(recv_idle_buf_)); // fully asynchronous call
 
         solid_assert_log(!rv, logger);
         (void)rv;
@@ -2261,6 +2510,10 @@ void RelayConnection::onEvent(frame::aio::ReactorContext& _rctx, EventBase&& _ue
                     [](EventBase& _revt, RelayConnection& _rcon, frame::aio::ReactorContext& _rctx) {
                         _rcon.doHandleEventRelayDone(_rctx, _revt);
                     }},
+                {make_event(connection_event_category, ConnectionEvents::RelayBuffer),
+                    [](EventBase& _revt, RelayConnection& _rcon, frame::aio::ReactorContext& _rctx) {
+                        _rcon.doHandleEventRelayBuffer(_rctx, _revt);
+                    }},
                 {make_event(connection_event_category, ConnectionEvents::Post),
                     [](EventBase& _revt, RelayConnection& _rcon, frame::aio::ReactorContext& _rctx) {
                         _rcon.doHandleEventPost(_rctx, _revt);
@@ -2305,9 +2558,9 @@ void RelayConnection::doCancelRelayed(
     size_t               ack_buf_cnt = 0;
 
     const auto done_lambda = [this, &ack_buf_cnt](SharedBuffer& _rbuf) {
-        if (_rbuf.useCount() == 1) {
+        if (auto buf = _rbuf.collapse()) {
             ++ack_buf_cnt;
-            returnRecvBuffer(std::move(_rbuf));
+            returnRecvBuffer(std::move(buf));
         }
     };
 
@@ -2331,7 +2584,7 @@ bool RelayConnection::doReceiveRelayStart(
 {
     Configuration const& config = configuration(_rctx);
     ConnectionContext    conctx{_rctx, service(_rctx), *this};
-    RelayData            relmsg{recvBuffer(), _pbeg, _sz /*, this->uid(_rctx)*/, _is_last};
+    RelayData            relmsg{recvBuffer(), _pbeg, _sz, uid(_rctx), _is_last};
 
     return config.relayEngine().relayStart(uid(_rctx), relayId(), _rmsghdr, std::move(relmsg), _rrelay_id, _rerror);
 }
@@ -2346,7 +2599,7 @@ bool RelayConnection::doReceiveRelayBody(
 {
     Configuration const& config = configuration(_rctx);
     ConnectionContext    conctx{_rctx, service(_rctx), *this};
-    RelayData            relmsg{recvBuffer(), _pbeg, _sz /*, this->uid(_rctx)*/, _is_last};
+    RelayData            relmsg{recvBuffer(), _pbeg, _sz, uid(_rctx), _is_last};
 
     return config.relayEngine().relay(relayId(), std::move(relmsg), _rrelay_id, _rerror);
 }
@@ -2362,7 +2615,7 @@ bool RelayConnection::doReceiveRelayResponse(
 {
     Configuration const& config = configuration(_rctx);
     ConnectionContext    conctx{_rctx, service(_rctx), *this};
-    RelayData            relmsg{recvBuffer(), _pbeg, _sz /*, this->uid(_rctx)*/, _is_last};
+    RelayData            relmsg{recvBuffer(), _pbeg, _sz, uid(_rctx), _is_last};
 
     return config.relayEngine().relayResponse(relayId(), _rmsghdr, std::move(relmsg), _rrelay_id, _rerror);
 }
@@ -2389,9 +2642,9 @@ void RelayConnection::doHandleEventRelayDone(frame::aio::ReactorContext& _rctx,
         size_t               ack_buf_cnt = 0;
 
         const auto done_lambda = [this, &ack_buf_cnt](SharedBuffer& _rbuf) {
-            if (_rbuf.useCount() == 1) {
+            if (auto buf = _rbuf.collapse()) {
                 ++ack_buf_cnt;
-                returnRecvBuffer(std::move(_rbuf));
+                returnRecvBuffer(std::move(buf));
             }
         };
         const auto cancel_lambda = [this](const MessageHeader& _rmsghdr) {
@@ -2414,6 +2667,20 @@ void RelayConnection::doHandleEventRelayDone(frame::aio::ReactorContext& _rctx,
     }
 }
 //-----------------------------------------------------------------------------
+// A relay buffer given back by the connection which held its last reference
+// for a zero-copy write (see Connection::doReleaseZeroCopy).
+void RelayConnection::doHandleEventRelayBuffer(frame::aio::ReactorContext& _rctx, EventBase& _revent)
+{
+    SharedBuffer* pbuf = _revent.cast<SharedBuffer>();
+
+    // see doHandleEventRelayDone
+    if (pbuf != nullptr && *pbuf && relayId().isValid()) {
+        returnRecvBuffer(std::move(*pbuf));
+        ackBufferCountAdd(1);
+        doSend<RelayContext>(_rctx);
+    }
+}
+//-----------------------------------------------------------------------------
 void RelayConnection::stop(frame::aio::ReactorContext& _rctx, const ErrorConditionT& _rerr)
 {
     doStop<RelayContext>(_rctx, _rerr);
@@ -2525,6 +2792,16 @@ void ConnectionContext::resumeRead()
     return true;
 }
 //-----------------------------------------------------------------------------
+/*virtual*/ ErrorCodeT SocketStub::enableZeroCopy(frame::aio::ReactorContext& /*_rctx*/, OnZeroCopyF /*_pf*/)
+{
+    return solid::error_not_implemented;
+}
+//-----------------------------------------------------------------------------
+/*virtual*/ uint32_t SocketStub::zeroCopySendCount() const
+{
+    return 0;
+}
+//-----------------------------------------------------------------------------
 ConnectionProxy SocketStub::connectionProxy()
 {
     return ConnectionProxy{};
@@ -23,6 +23,8 @@
 #include "solid/frame/mprpc/mprpcconfiguration.hpp"
 #include "solid/frame/mprpc/mprpcsocketstub.hpp"
 
+#include <deque>
+
 #include "mprpcmessagereader.hpp"
 #include "mprpcmessagewriter.hpp"
 
@@ -192,6 +194,8 @@ protected:
         InPoolWaitQueue,
         Connected, // once set - the flag should not be reset. Is used by pool for restarting
         PauseRecv,
+        ZeroCopy,
+        Advertised, // the peer capabilities advertisement was sent
         LastFlag,
     };
 
@@ -270,6 +274,8 @@ private:
     bool recvSome(frame::aio::ReactorContext& _rctx, char* _buf, size_t _bufcp, size_t& _sz);
     template <class Ctx>
     bool sendAll(frame::aio::ReactorContext& _rctx, char* _buf, size_t _bufcp);
+    template <class Ctx>
+    bool sendAllv(frame::aio::ReactorContext& _rctx, WriteBuffer& _rbuffer, MessageWriterSender& _rsender);
     void prepareSocket(frame::aio::ReactorContext& _rctx);
 
     const NanoTime& minTimeout() const;
@@ -285,6 +291,10 @@ private:
     Any<>&              any();
 
     static bool notify(Manager& _rm, const ActorIdT&, const RelayEngineNotification);
+    static bool notify(Manager& _rm, const ActorIdT&, SharedBuffer&& _ubuf);
+    static void onZeroCopy(frame::aio::ReactorContext& _rctx, const uint32_t _count);
+
+    void doReleaseZeroCopy(frame::aio::ReactorContext& _rctx, const uint32_t _count);
 
     virtual void onEvent(frame::aio::ReactorContext& _rctx, EventBase&& _uevent) = 0;
 
@@ -317,6 +327,9 @@ private:
 
     void doOptimizeRecvBuffer();
     void doOptimizeRecvBufferForced();
+    void doAdaptRecvBuffer(Configuration const& _rconfig, const size_t _sz);
+    template <class Ctx>
+    void doReleaseIdleRecvBuffer(frame::aio::ReactorContext& _rctx);
     void doPrepare(frame::aio::ReactorContext& _rctx);
     void doUnprepare(frame::aio::ReactorContext& _rctx);
     template <class Ctx>
@@ -336,6 +349,8 @@ private:
     template <class Ctx>
     void doCompleteKeepalive(frame::aio::ReactorContext& _rctx);
     template <class Ctx>
+    void doCompletePeerCapabilities(frame::aio::ReactorContext& _rctx, const uint32_t _max_packet_size, const uint32_t _compression_engine_mask);
+    template <class Ctx>
     void doCompleteAckCount(frame::aio::ReactorContext& _rctx, uint8_t _count);
     template <class Ctx>
     void doCompleteCancelRequest(frame::aio::ReactorContext& _rctx, const RequestId& _reqid);
@@ -350,6 +365,22 @@ private:
     using FlagsT            = solid::Flags<FlagsE>;
     using RequestIdVectorT  = MessageWriter::RequestIdVectorT;
     using RecvBufferVectorT = std::vector<SharedBuffer>;
+    using SendBufferVectorT = std::vector<ConstBuffer>;
+
+    // a buffer the kernel may still reference after a zero-copy write
+    struct ZeroCopyStub {
+        uint32_t     id_; // the zero-copy write
+        SharedBuffer buffer_;
+        ActorIdT     connection_id_; // the connection owning a relay buffer
+
+        ZeroCopyStub(const uint32_t _id, const SharedBuffer& _buffer, const ActorIdT& _connection_id)
+            : id_(_id)
+            , buffer_(_buffer)
+            , connection_id_(_connection_id)
+        {
+        }
+    };
+    using ZeroCopyDequeT = std::deque<ZeroCopyStub>;
 
     template <class Ctx>
     friend struct ConnectionReceiver;
@@ -370,7 +401,14 @@ private:
     uint8_t                               ackd_buf_count_ = 0;
     SharedBuffer                          recv_buf_;
     RecvBufferVectorT                     recv_buf_vec_;
+    RecvBufferStatus                      recv_buf_status_;
+    size_t                                recv_buf_offered_size_ = 0; // the space offered to the pending read
+    NanoTime                              recv_last_time_;
     SharedBuffer                          send_buf_;
+    SendBufferVectorT                     send_buf_vec_;
+    WriteReferenceVectorT                 send_ref_vec_;
+    RecvBufferVectorT                     send_buf_free_vec_; // send buffers released by zero-copy writes
+    ZeroCopyDequeT                        zero_copy_dq_;
     MessageIdVectorT                      pending_message_vec_;
     MessageReader                         msg_reader_;
     MessageWriter                         msg_writer_;
@@ -388,7 +426,9 @@ private:
     NanoTime                              timeout_secure_    = NanoTime::max(); // server
     NanoTime                              timeout_active_    = NanoTime::max(); // server
     NanoTime                              timeout_keepalive_ = NanoTime::max(); // client
+    NanoTime                              timeout_recv_idle_ = NanoTime::max(); // client and server
     UniqueId                              relay_id_;
+    char                                  recv_idle_buf_[16]; // receives the first bytes after the recv buffer was released
 };
 
 //-----------------------------------------------------------------------------
@@ -500,6 +540,7 @@ private:
 
     void doHandleEventRelayNew(frame::aio::ReactorContext& _rctx, EventBase& _revent);
     void doHandleEventRelayDone(frame::aio::ReactorContext& _rctx, EventBase& _revent);
+    void doHandleEventRelayBuffer(frame::aio::ReactorContext& _rctx, EventBase& _revent);
 
     void stop(frame::aio::ReactorContext& _rctx, const ErrorConditionT& _rerr) override;
     void pauseRead(frame::aio::ReactorContext& _rctx) override;
@@ -650,9 +691,9 @@ inline bool Connection::canHandleMore(Configuration const& _rconfiguration) cons
 inline const NanoTime& Connection::minTimeout() const
 {
     if (isServer()) {
-        return std::min(timeout_send_soft_, std::min(timeout_send_hard_, std::min(timeout_recv_, std::min(timeout_secure_, timeout_active_))));
+        return std::min(timeout_send_soft_, std::min(timeout_send_hard_, std::min(timeout_recv_, std::min(timeout_secure_, std::min(timeout_active_, timeout_recv_idle_)))));
     } else {
-        return std::min(timeout_send_soft_, std::min(timeout_send_hard_, std::min(timeout_recv_, timeout_keepalive_)));
+        return std::min(timeout_send_soft_, std::min(timeout_send_hard_, std::min(timeout_recv_, std::min(timeout_keepalive_, timeout_recv_idle_))));
     }
 }
 //-----------------------------------------------------------------------------
@@ -21,9 +21,10 @@ const LoggerT logger("solid::frame::mprpc::listener");
 }
 
 Listener::Listener(
-    SocketDevice& _rsd)
+    SocketDevice& _rsd, const size_t _reactor_index)
     : sock_(this->proxy(), std::move(_rsd))
     , timer_(this->proxy())
+    , reactor_index_(_reactor_index)
 {
     solid_log(logger, Info, this);
 }
@@ -57,7 +58,7 @@ void Listener::onAccept(frame::aio::ReactorContext& _rctx, SocketDevice& _rsd)
 
     do {
         if (!_rctx.error()) {
-            service(_rctx).acceptIncomingConnection(_rsd);
+            service(_rctx).acceptIncomingConnection(_rsd, reactor_index_);
         } else if (_rctx.error() == aio::error_listener_hangup) {
             solid_log(logger, Error, "listen hangup" << _rctx.error().message());
             // TODO: maybe you shoud restart the listener.
@@ -37,7 +37,7 @@ public:
     }
 
     Listener(
-        SocketDevice& _rsd);
+        SocketDevice& _rsd, const size_t _reactor_index = InvalidIndex());
     ~Listener();
 
 private:
@@ -51,6 +51,7 @@ private:
 
     ListenerSocketT sock_;
     TimerT          timer_;
+    const size_t    reactor_index_; // valid for SO_REUSEPORT listeners - connections are started on the same reactor
 };
 
 } // namespace mprpc
@@ -59,14 +59,16 @@ size_t MessageReader::read(
         if (state_ == StateE::ReadPacketBody) {
             // try read the data
             const char* tmpbufpos = packet_header.load(pbufpos, _receiver.protocol());
-            if (!packet_header.isOk()) {
+            if (!packet_header.isOk(max_packet_data_size_)) {
                 _rerror = error_reader_invalid_packet_header;
                 solid_log(logger, Error, _rerror.message());
                 break;
             }
             if (static_cast<size_t>(pbufend - tmpbufpos) >= packet_header.size()) {
-                pbufpos = tmpbufpos;
+                pbufpos              = tmpbufpos;
+                pending_packet_size_ = 0;
             } else {
+                pending_packet_size_ = PacketHeader::size_of_header + packet_header.size();
                 break;
             }
         }
@@ -179,16 +181,50 @@ void MessageReader::doConsumePacket(
     }
 
     if (_packet_header.isTypeKeepAlive()) {
-        solid_log(logger, Verbose, "KeepAliveTypeE");
-        _receiver.receiveKeepAlive();
+        if (_packet_header.size() >= sizeof(uint32_t)) {
+            // capabilities advertisement - older versions skip the data of keep alive packets
+            uint32_t max_size         = 0;
+            uint32_t compression_mask = 0;
+            pbufpos                   = _receiver.protocol().loadValue(pbufpos, max_size);
+            if (_packet_header.size() >= 2 * sizeof(uint32_t)) {
+                _receiver.protocol().loadValue(pbufpos, compression_mask);
+            }
+            solid_log(logger, Verbose, "KeepAliveTypeE capabilities packet size " << max_size << " compression " << compression_mask);
+            _receiver.receivePeerCapabilities(max_size, compression_mask);
+        } else {
+            solid_log(logger, Verbose, "KeepAliveTypeE");
+            _receiver.receiveKeepAlive();
+        }
         return;
     }
 
     if (!_packet_header.isCompressed()) [[likely]] {
         doConsumePacketLoop(pbufpos, pbufend, _receiver, _rerror);
+    } else if (_packet_header.size() > Protocol::MaxPacketDataSize) {
+        _rerror = error_reader_invalid_packet_header;
+        solid_log(logger, Error, "compressed jumbo packet");
     } else {
+        const UncompressFunctionT* pdecompress_fnc = &_receiver.configuration().decompress_fnc;
+
+        if (_packet_header.compressionEngineId() != 0) {
+            pdecompress_fnc = nullptr;
+            if (pcompression_engine_vec_ != nullptr) {
+                for (const auto& engine : *pcompression_engine_vec_) {
+                    if (engine.id == _packet_header.compressionEngineId()) {
+                        pdecompress_fnc = &engine.decompress_fnc;
+                        break;
+                    }
+                }
+            }
+            if (pdecompress_fnc == nullptr) {
+                _rerror = error_compression_unavailable;
+                solid_log(logger, Error, "unknown compression engine " << static_cast<int>(_packet_header.compressionEngineId()));
+                return;
+            }
+        }
+
         char         tmpbuf[Protocol::MaxPacketDataSize]; // decompress = TODO: try not to use so much stack
-        const size_t uncompressed_size = _receiver.configuration().decompress_fnc(tmpbuf, pbufpos, pbufend - pbufpos, _rerror);
+        const size_t uncompressed_size = (*pdecompress_fnc)(tmpbuf, pbufpos, pbufend - pbufpos, _rerror);
 
         if (!_rerror) {
             pbufpos = tmpbuf;
@@ -634,6 +670,7 @@ Deserializer::PointerT MessageReader::createDeserializer(MessageReaderReceiver&
 {
     return ResponseStateE::None;
 }
+/*virtual*/ void MessageReaderReceiver::receivePeerCapabilities(const uint32_t /*_max_packet_size*/, const uint32_t /*_compression_engine_mask*/) {}
 /*virtual*/ void MessageReaderReceiver::pushCancelRequest(const RequestId&) {}
 /*virtual*/ void MessageReaderReceiver::cancelRelayed(const MessageId&) {}
 //-----------------------------------------------------------------------------
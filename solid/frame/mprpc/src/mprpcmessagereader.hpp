@@ -14,12 +14,14 @@
 #include "solid/system/common.hpp"
 #include "solid/system/error.hpp"
 #include <deque>
+#include <vector>
 
 namespace solid {
 namespace frame {
 namespace mprpc {
 
 struct ReaderConfiguration;
+struct CompressionEngine;
 
 class PacketHeader;
 
@@ -52,6 +54,7 @@ struct MessageReaderReceiver {
 
     virtual void           receiveMessage(MessagePointerT<>&, const size_t /*_msg_type_id*/) = 0;
     virtual void           receiveKeepAlive()                                                = 0;
+    virtual void           receivePeerCapabilities(const uint32_t _max_packet_size, const uint32_t _compression_engine_mask);
     virtual void           receiveAckCount(uint8_t _count)                                   = 0;
     virtual void           receiveCancelRequest(const RequestId&)                            = 0;
     virtual bool           receiveRelayStart(MessageHeader& _rmsghdr, const char* _pbeg, size_t _sz, MessageId& _rrelay_id, const bool _is_last, ErrorConditionT& _rerror);
@@ -102,9 +105,12 @@ class MessageReader {
     };
     using MessageVectorT = std::deque<MessageStub>;
 
-    StateE                 state_ = StateE::ReadPacketHead;
-    MessageVectorT         message_vec_;
-    Deserializer::PointerT des_top_;
+    StateE                                state_ = StateE::ReadPacketHead;
+    MessageVectorT                        message_vec_;
+    Deserializer::PointerT                des_top_;
+    size_t                                max_packet_data_size_    = Protocol::MaxPacketDataSize;
+    size_t                                pending_packet_size_     = 0;
+    const std::vector<CompressionEngine>* pcompression_engine_vec_ = nullptr;
 
 public:
     MessageReader() = default;
@@ -120,6 +126,24 @@ public:
     void prepare(ReaderConfiguration const& _rconfig);
     void unprepare();
 
+    //! The biggest packet accepted - above Protocol::MaxPacketDataSize when jumbo packets are enabled
+    void maxPacketDataSize(const size_t _max_size)
+    {
+        max_packet_data_size_ = _max_size;
+    }
+
+    //! The engines decompressing the packets marked with a negotiated compression engine id
+    void compressionEngines(const std::vector<CompressionEngine>& _rengine_vec)
+    {
+        pcompression_engine_vec_ = &_rengine_vec;
+    }
+
+    //! The size, with header, of the packet waiting for more data or zero
+    size_t pendingPacketSize() const
+    {
+        return pending_packet_size_;
+    }
+
 private:
     void doConsumePacket(
         const char*            _pbuf,
@@ -21,11 +21,18 @@ namespace frame {
 namespace mprpc {
 namespace {
 const LoggerT logger("solid::frame::mprpc::writer");
-}
+
+constexpr size_t chunk_header_size = 8; // command, compact message index and 16 bit chunk size
+// packets smaller than this are not considered when deciding to bypass compression - engines usually skip them
+constexpr size_t compression_probe_min_size    = 1024;
+constexpr size_t compression_bypass_max_factor = 64;
+} // namespace
 
 struct MessageWriter::PacketOptions {
-    bool force_no_compress = false;
-    bool request_accept    = false;
+    bool                   force_no_compress = false;
+    bool                   request_accept    = false;
+    const char*            pbuffer           = nullptr; // the WriteBuffer begin
+    WriteReferenceVectorT* preference_vec    = nullptr;
 };
 
 //-----------------------------------------------------------------------------
@@ -59,6 +66,36 @@ void MessageWriter::unprepare()
 {
 }
 //-----------------------------------------------------------------------------
+// Adaptive compression bypass: after writer.compression_bypass_fail_count consecutive
+// packets that did not compress well, skip compression for a number of packets that
+// doubles on every failed retry.
+bool MessageWriter::doBypassCompression()
+{
+    if (compression_skip_count_ != 0) {
+        --compression_skip_count_;
+        return true;
+    }
+    return false;
+}
+//-----------------------------------------------------------------------------
+void MessageWriter::doCompleteCompression(const bool _compressed, WriterConfiguration const& _rconfig)
+{
+    if (_compressed) {
+        compression_fail_count_   = 0;
+        compression_bypass_count_ = 0;
+    } else if (_rconfig.compression_bypass_fail_count != 0 && ++compression_fail_count_ >= _rconfig.compression_bypass_fail_count) {
+        if (compression_bypass_count_ == 0) {
+            compression_bypass_count_ = _rconfig.compression_bypass_packet_count;
+        } else if (compression_bypass_count_ < _rconfig.compression_bypass_packet_count * compression_bypass_max_factor) {
+            compression_bypass_count_ *= 2;
+        }
+        compression_skip_count_ = compression_bypass_count_;
+        // after the bypass, a single failed packet restarts it
+        compression_fail_count_ = _rconfig.compression_bypass_fail_count - 1;
+        solid_log(logger, Verbose, "bypass compression for " << compression_skip_count_ << " packets");
+    }
+}
+//-----------------------------------------------------------------------------
 void MessageWriter::doWriteQueuePushBack(const size_t _msgidx, const int _line)
 {
     if (write_inner_list_.size() <= 1) {
@@ -419,24 +456,45 @@ ErrorConditionT MessageWriter::write(
     bool            more    = true;
     ErrorConditionT error;
 
+    if (should_advertise_) {
+        // a keep alive packet carrying the biggest packet we accept and the compression engines we know - older versions skip its data
+        PacketHeader packet_header(PacketHeader::TypeE::KeepAlive, 0, 2 * sizeof(uint32_t));
+        pbufpos = packet_header.store(pbufpos, _rsender.protocol());
+        pbufpos = _rsender.protocol().storeValue(pbufpos, advertise_packet_data_size_);
+        pbufpos = _rsender.protocol().storeValue(pbufpos, advertise_compression_mask_);
+        freesz  = pbufend - pbufpos;
+
+        should_advertise_ = false;
+    }
+
     while (more && freesz >= (PacketHeader::size_of_header + _rsender.protocol().minimumFreePacketDataSize())) {
 
         PacketHeader  packet_header(PacketHeader::TypeE::Data, 0, 0);
         PacketOptions packet_options;
-        char*         pbufdata = pbufpos + PacketHeader::size_of_header;
-        size_t        fillsz   = doWritePacketData(pbufdata, pbufend, packet_options, _rackd_buf_count, _cancel_remote_msg_vec, _rrelay_free_count, _rsender, error);
+        char*         pbufdata   = pbufpos + PacketHeader::size_of_header;
+        char*         ppacketend = static_cast<size_t>(pbufend - pbufdata) > max_packet_data_size_ ? pbufdata + max_packet_data_size_ : pbufend;
+
+        packet_options.pbuffer        = _rbuffer.data();
+        packet_options.preference_vec = _rbuffer.referenceVector();
+
+        size_t fillsz = doWritePacketData(pbufdata, ppacketend, packet_options, _rackd_buf_count, _cancel_remote_msg_vec, _rrelay_free_count, _rsender, error);
 
         if (fillsz != 0u) {
 
-            if (!packet_options.force_no_compress) {
+            if (!packet_options.force_no_compress && fillsz <= Protocol::MaxPacketDataSize && !doBypassCompression()) { // jumbo packets are not compressed
                 ErrorConditionT compress_error;
-                size_t          compressed_size = _rsender.configuration().inplace_compress_fnc(pbufdata, fillsz, compress_error);
+                const uint8_t   engine_id       = pcompression_engine_ != nullptr ? pcompression_engine_->id : 0;
+                size_t          compressed_size = pcompression_engine_ != nullptr ? pcompression_engine_->compress_fnc(pbufdata, fillsz, compress_error) : _rsender.configuration().inplace_compress_fnc(pbufdata, fillsz, compress_error);
 
                 if (compressed_size != 0u) {
-                    packet_header.flags(packet_header.flags() | static_cast<uint8_t>(PacketHeader::FlagE::Compressed));
+                    packet_header.compressed(engine_id);
                     fillsz = compressed_size;
+                    doCompleteCompression(true, _rsender.configuration());
                 } else if (!compress_error) {
                     // the buffer was not modified, we can send it uncompressed
+                    if (fillsz >= compression_probe_min_size) {
+                        doCompleteCompression(false, _rsender.configuration());
+                    }
                 } else {
                     // there was an error and the inplace buffer was changed - exit with error
                     more  = false;
@@ -452,7 +510,7 @@ ErrorConditionT MessageWriter::write(
                 more = false; // do not allow multiple packets per relay buffer
             }
 
-            solid_assert_log(static_cast<size_t>(fillsz) < static_cast<size_t>(0xffffUL), logger);
+            solid_assert_log(static_cast<size_t>(fillsz) <= max_packet_data_size_, logger);
 
             packet_header.size(static_cast<uint32_t>(fillsz));
 
@@ -519,7 +577,8 @@ bool MessageWriter::doFindEligibleMessage(MessageWriterSender& _rsender, const b
                 continue;
             }
         }
-        if (rmsgstub.packet_count_ < _rsender.configuration().max_message_continuous_packet_count) {
+        // on jumbo packets messages are interleaved after every message_quantum_size chunk
+        if (rmsgstub.packet_count_ < (isJumbo() ? 1 : _rsender.configuration().max_message_continuous_packet_count)) {
 
         } else {
             rmsgstub.packet_count_ = 0;
@@ -578,6 +637,8 @@ size_t MessageWriter::doWritePacketData(
     while (
         !_rerror && static_cast<size_t>(_pbufend - pbufpos) >= _rsender.protocol().minimumFreePacketDataSize() && doFindEligibleMessage(_rsender, _relay_free_count != 0, _pbufend - pbufpos)) {
         const size_t msgidx = write_inner_list_.frontIndex();
+        // message chunks carry 16 bit sizes - on jumbo packets every chunk is at most message_quantum_size
+        char* const pchunkend = isJumbo() && static_cast<size_t>(_pbufend - pbufpos) > (chunk_header_size + _rsender.configuration().message_quantum_size) ? pbufpos + chunk_header_size + _rsender.configuration().message_quantum_size : _pbufend;
 
         PacketHeader::CommandE cmd = PacketHeader::CommandE::Message;
 
@@ -599,17 +660,17 @@ size_t MessageWriter::doWritePacketData(
         }
         case MessageStub::StateE::WriteHeadStart:
         case MessageStub::StateE::WriteHeadContinue:
-            pbufpos = doWriteMessageHead(pbufpos, _pbufend, msgidx, _rpacket_options, _rsender, cmd, _rerror);
+            pbufpos = doWriteMessageHead(pbufpos, pchunkend, msgidx, _rpacket_options, _rsender, cmd, _rerror);
             break;
         case MessageStub::StateE::WriteBodyStart:
         case MessageStub::StateE::WriteBodyContinue:
-            pbufpos = doWriteMessageBody(pbufpos, _pbufend, msgidx, _rpacket_options, _rsender, _rerror);
+            pbufpos = doWriteMessageBody(pbufpos, pchunkend, msgidx, _rpacket_options, _rsender, _rerror);
             break;
         case MessageStub::StateE::WriteWait:
             solid_throw_log(logger, "Invalid state for write queue - WriteWait");
             break;
         case MessageStub::StateE::WriteCanceled:
-            pbufpos = doWriteMessageCancel(pbufpos, _pbufend, msgidx, _rpacket_options, _rsender, _rerror);
+            pbufpos = doWriteMessageCancel(pbufpos, pchunkend, msgidx, _rpacket_options, _rsender, _rerror);
             break;
         case MessageStub::StateE::RelayedStart: {
             MessageStub& rmsgstub = message_vec_[msgidx];
@@ -624,19 +685,19 @@ size_t MessageWriter::doWritePacketData(
         }
         case MessageStub::StateE::RelayedHeadStart:
         case MessageStub::StateE::RelayedHeadContinue:
-            pbufpos = doWriteRelayedHead(pbufpos, _pbufend, msgidx, _rpacket_options, _rsender, cmd, _rerror);
+            pbufpos = doWriteRelayedHead(pbufpos, pchunkend, msgidx, _rpacket_options, _rsender, cmd, _rerror);
             break;
         case MessageStub::StateE::RelayedBody:
-            pbufpos = doWriteRelayedBody(pbufpos, _pbufend, msgidx, _rpacket_options, _rsender, _rerror);
+            pbufpos = doWriteRelayedBody(pbufpos, pchunkend, msgidx, _rpacket_options, _rsender, _rerror);
             break;
         case MessageStub::StateE::RelayedWait:
             solid_throw_log(logger, "Invalid state for write queue - RelayedWait");
             break;
         case MessageStub::StateE::RelayedCancelRequest:
-            pbufpos = doWriteRelayedCancelRequest(pbufpos, _pbufend, msgidx, _rpacket_options, _rsender, _rerror);
+            pbufpos = doWriteRelayedCancelRequest(pbufpos, pchunkend, msgidx, _rpacket_options, _rsender, _rerror);
             break;
         case MessageStub::StateE::RelayedCancel:
-            pbufpos = doWriteRelayedCancel(pbufpos, _pbufend, msgidx, _rpacket_options, _rsender, _rerror);
+            pbufpos = doWriteRelayedCancel(pbufpos, pchunkend, msgidx, _rpacket_options, _rsender, _rerror);
             break;
         default:
             // solid_check(false, "message state not handled: "<<(int)message_vec_[msgidx].state_<<" for message "<<msgidx);
@@ -816,10 +877,10 @@ char* MessageWriter::doWriteRelayedHead(
 }
 //-----------------------------------------------------------------------------
 char* MessageWriter::doWriteRelayedBody(
-    char*        _pbufpos,
-    char*        _pbufend,
-    const size_t _msgidx,
-    PacketOptions& /*_rpacket_options*/,
+    char*                _pbufpos,
+    char*                _pbufend,
+    const size_t         _msgidx,
+    PacketOptions&       _rpacket_options,
     MessageWriterSender& _rsender,
     ErrorConditionT& /*_rerror*/)
 {
@@ -844,7 +905,17 @@ char* MessageWriter::doWriteRelayedBody(
         towrite = rmsgstub.relay_size_;
     }
 
-    memcpy(_pbufpos, rmsgstub.prelay_pos_, towrite);
+    // NOTE: the end of a request is always copied: completing it moves the relayed
+    // message into WaitResponse, which must happen before the response can arrive.
+    const bool by_reference = _rpacket_options.preference_vec != nullptr && !(rmsgstub.prelay_data_->isMessageEnd() && rmsgstub.prelay_data_->isRequest());
+
+    if (by_reference) {
+        // leave the room in the buffer - the payload is gathered from the relay buffer on send
+        _rpacket_options.preference_vec->emplace_back(_pbufpos - _rpacket_options.pbuffer, rmsgstub.prelay_pos_, towrite, rmsgstub.prelay_data_);
+        _rpacket_options.force_no_compress = true;
+    } else {
+        memcpy(_pbufpos, rmsgstub.prelay_pos_, towrite);
+    }
 
     _pbufpos += towrite;
     rmsgstub.prelay_pos_ += towrite;
@@ -862,7 +933,13 @@ char* MessageWriter::doWriteRelayedBody(
         const bool is_request      = rmsgstub.prelay_data_->isRequest(); // Message::is_waiting_response(rmsgstub.prelay_data_->pmessage_header_->flags_);
 
         solid_log(logger, Verbose, this << " completeRelayed " << _msgidx << " is_end = " << is_message_end << " is_last " << is_message_last << " is_req = " << is_request);
-        _rsender.completeRelayed(rmsgstub.prelay_data_, rmsgstub.pool_msg_id_);
+        if (by_reference) {
+            // the relay buffer must not be released before the payload is sent
+            _rpacket_options.preference_vec->back().relay_msg_id_ = rmsgstub.pool_msg_id_;
+            _rpacket_options.preference_vec->back().complete_     = true;
+        } else {
+            _rsender.completeRelayed(rmsgstub.prelay_data_, rmsgstub.pool_msg_id_);
+        }
         rmsgstub.prelay_data_ = nullptr; // when prelay_data_ is null we consider the message not in write_inner_list_
 
         if (is_message_end) {
@@ -26,11 +26,42 @@ namespace solid {
 namespace frame {
 namespace mprpc {
 
+struct CompressionEngine;
+
+//! A relayed payload that MessageWriter did not copy into the WriteBuffer
+/*!
+ * The bytes [offset_, offset_ + size_) of the WriteBuffer are left untouched
+ * and must be replaced, on send, by the size_ bytes at data_ - which belong to
+ * prelay_data_->buffer_.
+ * If complete_ is set, the relay data must be completed (MessageWriterSender::completeRelayed)
+ * once the payload was either sent or copied into the WriteBuffer.
+ */
+struct WriteReference {
+    size_t      offset_;
+    const char* data_;
+    size_t      size_;
+    RelayData*  prelay_data_;
+    MessageId   relay_msg_id_;
+    bool        complete_;
+
+    WriteReference(const size_t _offset, const char* _data, const size_t _size, RelayData* _prelay_data)
+        : offset_(_offset)
+        , data_(_data)
+        , size_(_size)
+        , prelay_data_(_prelay_data)
+        , complete_(false)
+    {
+    }
+};
+
+using WriteReferenceVectorT = std::vector<WriteReference>;
+
 // TODO: replace this with SharedBuffer
 struct WriteBuffer {
-    WriteBuffer(char* _data = nullptr, size_t _size = -1)
+    WriteBuffer(char* _data = nullptr, size_t _size = -1, WriteReferenceVectorT* _preference_vec = nullptr)
         : data_(_data)
         , size_(_size)
+        , preference_vec_(_preference_vec)
     {
     }
     char*  data() const noexcept { return data_; }
@@ -48,9 +79,13 @@ struct WriteBuffer {
         size_ = _size;
     }
 
+    //! Where to store the payloads sent by reference - null when everything must be copied
+    WriteReferenceVectorT* referenceVector() const noexcept { return preference_vec_; }
+
 private:
-    char*  data_;
-    size_t size_;
+    char*                  data_;
+    size_t                 size_;
+    WriteReferenceVectorT* preference_vec_;
 };
 
 struct MessageWriterSender {
@@ -146,16 +181,24 @@ class MessageWriter {
 
     struct PacketOptions;
 
-    MessageVectorT          message_vec_;
-    uint32_t                current_message_type_id_;
-    size_t                  write_queue_sync_index_;
-    size_t                  write_queue_back_index_;
-    size_t                  write_queue_async_count_;
-    size_t                  write_queue_direct_count_;
-    MessageOrderInnerListT  order_inner_list_;
-    MessageStatusInnerListT write_inner_list_;
-    MessageStatusInnerListT cache_inner_list_;
-    Serializer::PointerT    serializer_stack_top_;
+    MessageVectorT           message_vec_;
+    uint32_t                 current_message_type_id_;
+    size_t                   write_queue_sync_index_;
+    size_t                   write_queue_back_index_;
+    size_t                   write_queue_async_count_;
+    size_t                   write_queue_direct_count_;
+    MessageOrderInnerListT   order_inner_list_;
+    MessageStatusInnerListT  write_inner_list_;
+    MessageStatusInnerListT  cache_inner_list_;
+    Serializer::PointerT     serializer_stack_top_;
+    size_t                   max_packet_data_size_       = Protocol::MaxPacketDataSize;
+    bool                     should_advertise_           = false;
+    uint32_t                 advertise_packet_data_size_ = 0;
+    uint32_t                 advertise_compression_mask_ = 0;
+    const CompressionEngine* pcompression_engine_        = nullptr;
+    size_t                   compression_fail_count_     = 0;
+    size_t                   compression_skip_count_     = 0;
+    size_t                   compression_bypass_count_   = 0;
 
 public:
     using VisitFunctionT = solid_function_t(void(
@@ -216,11 +259,50 @@ public:
     void prepare(WriterConfiguration const& _rconfig);
     void unprepare();
 
+    //! The biggest packet to write - above Protocol::MaxPacketDataSize once the peer accepted jumbo packets
+    void maxPacketDataSize(const size_t _max_size)
+    {
+        max_packet_data_size_ = _max_size;
+    }
+
+    size_t maxPacketDataSize() const
+    {
+        return max_packet_data_size_;
+    }
+
+    bool isJumbo() const
+    {
+        return max_packet_data_size_ > Protocol::MaxPacketDataSize;
+    }
+
+    //! Tell the peer, on the next write, the biggest packet accepted (0 - no jumbo packets) and the compression engines known
+    void advertisePeerCapabilities(const uint32_t _max_packet_size, const uint32_t _compression_engine_mask)
+    {
+        should_advertise_           = true;
+        advertise_packet_data_size_ = _max_packet_size;
+        advertise_compression_mask_ = _compression_engine_mask;
+    }
+
+    //! Compress with the engine negotiated with the peer instead of WriterConfiguration::inplace_compress_fnc
+    void compressionEngine(const CompressionEngine* _pengine)
+    {
+        pcompression_engine_ = _pengine;
+    }
+
+    const CompressionEngine* compressionEngine() const
+    {
+        return pcompression_engine_;
+    }
+
     void forEveryMessagesNewerToOlder(VisitFunctionT const& _rvisit_fnc);
 
     void print(std::ostream& _ros, const PrintWhat _what) const;
 
 private:
+    bool doBypassCompression();
+
+    void doCompleteCompression(const bool _compressed, WriterConfiguration const& _rconfig);
+
     size_t doWritePacketData(
         char*                _pbufbeg,
         char*                _pbufend,
@@ -12,6 +12,7 @@
 #include <condition_variable>
 #include <cstring>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
@@ -35,6 +36,7 @@
 #include "solid/frame/mprpc/mprpcservice.hpp"
 
 #include "solid/system/mutualstore.hpp"
+#include "solid/utility/common.hpp"
 #include "solid/utility/innerlist.hpp"
 #include "solid/utility/queue.hpp"
 #include "solid/utility/stack.hpp"
@@ -626,14 +628,129 @@ struct ConnectionPoolStub : inner::Node<to_underlying(ConnectionPoolInnerLink::C
 using ConnectionPoolDequeT     = std::deque<ConnectionPoolStub>;
 using ConnectionPoolInnerListT = inner::List<ConnectionPoolDequeT, to_underlying(ConnectionPoolInnerLink::Free)>;
 
+//-----------------------------------------------------------------------------
+//! Read-mostly name to pool index, looked up without locks by the senders
+/*!
+    Open addressing over a power of two count of slots, keyed by the url hash
+    carried in RecipientUrl. Modified only under Service::Data::rmutex_,
+    alongside name_map_. A found ConnectionPoolId is just a hint which
+    Data::doLockPool validates, under the pool mutex, against the pool's unique
+    and name - so a stale, torn or colliding entry only sends the caller on the
+    locked path.
+*/
+class NameIndex : NonCopyable {
+    static constexpr size_t empty_hash   = 0;
+    static constexpr size_t deleted_hash = 1;
+
+    struct Slot {
+        std::atomic<size_t>   hash_{empty_hash};
+        std::atomic<uint64_t> pool_id_{0};
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t                  mask_        = 0;
+    size_t                  dirty_count_ = 0; // used or deleted
+
+    static size_t key(const size_t _hash)
+    {
+        return _hash <= deleted_hash ? _hash + 2 : _hash;
+    }
+
+    static uint64_t pack(ConnectionPoolId const& _rpool_id)
+    {
+        return (static_cast<uint64_t>(_rpool_id.index) << 32) | _rpool_id.unique;
+    }
+
+    static ConnectionPoolId unpack(const uint64_t _value)
+    {
+        return ConnectionPoolId{static_cast<size_t>(_value >> 32), static_cast<uint32_t>(_value)};
+    }
+
+public:
+    void reset(const size_t _pool_count)
+    {
+        size_t capacity = 16;
+        while (capacity < 2 * _pool_count) {
+            capacity <<= 1;
+        }
+        slots_       = std::make_unique<Slot[]>(capacity);
+        mask_        = capacity - 1;
+        dirty_count_ = 0;
+    }
+
+    bool find(const size_t _hash, ConnectionPoolId& _rpool_id) const
+    {
+        const size_t k = key(_hash);
+        for (size_t i = 0, pos = k & mask_; i <= mask_; ++i, pos = (pos + 1) & mask_) {
+            const size_t h = slots_[pos].hash_.load(std::memory_order_acquire);
+            if (h == k) {
+                _rpool_id = unpack(slots_[pos].pool_id_.load(std::memory_order_acquire));
+                return true;
+            }
+            if (h == empty_hash) {
+                break;
+            }
+        }
+        return false;
+    }
+
+    // Returns false when too few empty slots are left - the caller should clear and insert back
+    bool insert(const size_t _hash, ConnectionPoolId const& _rpool_id)
+    {
+        const size_t k   = key(_hash);
+        size_t       pos = k & mask_;
+        while (true) {
+            const size_t h = slots_[pos].hash_.load(std::memory_order_relaxed);
+            if (h == empty_hash || h == deleted_hash) {
+                break;
+            }
+            pos = (pos + 1) & mask_;
+        }
+        if (slots_[pos].hash_.load(std::memory_order_relaxed) == empty_hash) {
+            ++dirty_count_;
+        }
+        slots_[pos].pool_id_.store(pack(_rpool_id), std::memory_order_release);
+        slots_[pos].hash_.store(k, std::memory_order_release);
+        return dirty_count_ * 4 <= (mask_ + 1) * 3;
+    }
+
+    void erase(const size_t _hash, ConnectionPoolId const& _rpool_id)
+    {
+        const size_t   k     = key(_hash);
+        const uint64_t value = pack(_rpool_id);
+        for (size_t i = 0, pos = k & mask_; i <= mask_; ++i, pos = (pos + 1) & mask_) {
+            const size_t h = slots_[pos].hash_.load(std::memory_order_relaxed);
+            if (h == k && slots_[pos].pool_id_.load(std::memory_order_relaxed) == value) {
+                slots_[pos].hash_.store(deleted_hash, std::memory_order_release);
+                return;
+            }
+            if (h == empty_hash) {
+                return;
+            }
+        }
+    }
+
+    // Concurrent lookups might miss until the entries are inserted back
+    void clear()
+    {
+        for (size_t i = 0; i <= mask_; ++i) {
+            slots_[i].hash_.store(empty_hash, std::memory_order_release);
+        }
+        dirty_count_ = 0;
+    }
+};
+
 //-----------------------------------------------------------------------------
 
 struct Service::Data {
+    using PoolMutexT = Padded<std::mutex>; // no false sharing between the pool mutexes
+
     std::mutex&              rmutex_;
     const Configuration      config_;
-    std::mutex*              pmutexes_;
+    PoolMutexT*              pmutexes_;
     size_t                   mutex_count_;
     NameMapT                 name_map_;
+    NameIndex                name_index_;
     ConnectionPoolDequeT     pool_dq_;
     ConnectionPoolInnerListT pool_free_list_;
     // std::string              tmp_str_;
@@ -658,6 +775,34 @@ struct Service::Data {
         return pmutexes_[_idx % mutex_count_];
     }
 
+    // Lock-free lookup of an already registered recipient name
+    bool findPoolByName(const RecipientUrl& _recipient_url, const string_view& _url, ConnectionPoolId& _rpool_id) const
+    {
+        return name_index_.find(_recipient_url.hasURLNonEmpty() ? _recipient_url.url_hash_ : RecipientUrl::hash(_url), _rpool_id);
+    }
+
+    // Called with rmutex_ locked
+    void registerName(ConnectionPoolStub const& _rpool, ConnectionPoolId const& _rpool_id)
+    {
+        name_map_[_rpool.name_.c_str()] = _rpool_id;
+        if (!name_index_.insert(RecipientUrl::hash(_rpool.name_), _rpool_id)) {
+            name_index_.clear();
+            for (const auto& item : name_map_) {
+                name_index_.insert(RecipientUrl::hash(item.first), item.second);
+            }
+        }
+    }
+
+    // Called with rmutex_ locked
+    void unregisterName(ConnectionPoolStub const& _rpool)
+    {
+        const auto it = name_map_.find(_rpool.name_);
+        if (it != name_map_.end()) {
+            name_index_.erase(RecipientUrl::hash(it->first), it->second);
+            name_map_.erase(it);
+        }
+    }
+
     void lockAllConnectionPoolMutexes()
     {
         for (size_t i = 0; i < mutex_count_; ++i) {
@@ -762,6 +907,21 @@ struct Service::Data {
         RecipientId*                       _precipient_id_out,
         MessageId*                         _pmsgid_out,
         const MessageFlagsT&               _flags);
+
+    ErrorConditionT doFindPool(
+        Service& _rsvc, const RecipientUrl& _recipient_url, const string_view& _url,
+        ConnectionPoolId& _rpool_id, bool& _rcheck_uid);
+
+    ErrorConditionT doSendMessagesToConnection(
+        Service&                           _rsvc,
+        const RecipientId&                 _rrecipient_id_in,
+        MessageBatch&                      _rbatch,
+        const OptionalMessageRelayHeaderT& _relay);
+
+    ErrorConditionT doSendMessagesToPool(
+        Service& _rsvc, const ConnectionPoolId& _rpool_id, MessageBatch& _rbatch,
+        const OptionalMessageRelayHeaderT& _relay,
+        RecipientId*                       _precipient_id_out);
 };
 //=============================================================================
 
@@ -800,10 +960,14 @@ inline std::shared_ptr<Service::Data> Service::acquire(std::unique_lock<std::mut
     }
     return nullptr;
 }
+// Without the service mutex: the status is atomic and pimpl_ is only replaced
+// by a (re)start, which cannot happen while the service is running
 inline std::shared_ptr<Service::Data> Service::acquire()
 {
-    std::unique_lock<std::mutex> lock;
-    return acquire(lock);
+    if (status() == ServiceStatusE::Running) {
+        return pimpl_;
+    }
+    return nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -839,11 +1003,12 @@ void Service::doFinalizeStart(ServiceStartStatus& _status, Configuration&& _ucfg
 
     if (configuration().pool_mutex_count > pimpl_->mutex_count_) {
         delete[] pimpl_->pmutexes_;
-        pimpl_->pmutexes_    = new std::mutex[configuration().pool_mutex_count];
+        pimpl_->pmutexes_    = new Data::PoolMutexT[configuration().pool_mutex_count];
         pimpl_->mutex_count_ = configuration().pool_mutex_count;
     }
 
     pimpl_->pool_dq_.resize(configuration().pool_count);
+    pimpl_->name_index_.reset(configuration().pool_count);
 
     pimpl_->pool_free_list_.clear();
 
@@ -852,21 +1017,7 @@ void Service::doFinalizeStart(ServiceStartStatus& _status, Configuration&& _ucfg
     }
 
     if (_usd) {
-        SocketAddress local_address;
-
-        _usd.localAddress(local_address); // socket is moved onto listener
-
-        _lock.unlock(); // temporary unlock the mutex so we can create the listener Actor
-
-        ErrorConditionT error;
-        ActorIdT        conuid = configuration().actor_create_fnc(make_shared<Listener>(_usd), *this, make_event(GenericEventE::Start), error);
-        (void)conuid;
-
-        _lock.lock();
-
-        solid_check_log(!error, logger, "Failed starting listener: " << error.message());
-
-        _status.listen_addr_vec_.emplace_back(std::move(local_address));
+        doStartListeners(_status, _usd, _lock);
     }
 }
 //-----------------------------------------------------------------------------
@@ -880,22 +1031,57 @@ void Service::doFinalizeStart(ServiceStartStatus& _status, std::unique_lock<std:
     solid_check(pimpl_->pool_dq_.size() == pimpl_->pool_free_list_.size() && !pimpl_->pool_dq_.empty());
 
     if (sd) {
-        SocketAddress local_address;
+        doStartListeners(_status, sd, _lock);
+    }
+}
+//-----------------------------------------------------------------------------
+void Service::doStartListeners(ServiceStartStatus& _status, SocketDevice& _rsd, std::unique_lock<std::mutex>& _lock)
+{
+    SocketAddress local_address;
 
-        sd.localAddress(local_address);
+    _rsd.localAddress(local_address); // socket is moved onto listener
 
-        _lock.unlock();
+    // With SO_REUSEPORT, every reactor gets its own listener socket bound on the same address,
+    // the kernel spreads the incoming connections and they stay on the accepting reactor.
+    std::vector<SocketDevice> sd_vec;
+    const size_t              reactor_count = configuration().server.listener_reuse_port && configuration().reactor_count_fnc ? configuration().reactor_count_fnc() : 0;
 
-        ErrorConditionT error;
-        ActorIdT        conuid = configuration().actor_create_fnc(make_shared<Listener>(sd), *this, make_event(GenericEventE::Start), error);
-        (void)conuid;
+    for (size_t i = 1; i < reactor_count; ++i) {
+        SocketDevice sd;
+        ErrorCodeT   err = sd.create(local_address.family(), SocketInfo::Stream, 0);
+        if (!err) {
+            err = sd.enableReusePort();
+        }
+        if (!err) {
+            err = sd.prepareAccept(local_address, SocketInfo::max_listen_backlog_size());
+        }
+        if (err) {
+            solid_log(logger, Warning, "Failed creating listener for reactor " << i << ": " << err.message() << " - using a single listener");
+            sd_vec.clear();
+            break;
+        }
+        sd_vec.emplace_back(std::move(sd));
+    }
 
-        _lock.lock();
+    _lock.unlock(); // temporary unlock the mutex so we can create the listener Actor
 
-        solid_check_log(!error, logger, "Failed starting listener: " << error.message());
+    ErrorConditionT error;
 
-        _status.listen_addr_vec_.emplace_back(std::move(local_address));
+    if (sd_vec.empty()) {
+        configuration().actor_create_fnc(make_shared<Listener>(_rsd), *this, make_event(GenericEventE::Start), error);
+    } else {
+        configuration().actor_create_on_fnc(make_shared<Listener>(_rsd, 0), *this, 0, make_event(GenericEventE::Start), error);
+
+        for (size_t i = 0; i < sd_vec.size() && !error; ++i) {
+            configuration().actor_create_on_fnc(make_shared<Listener>(sd_vec[i], i + 1), *this, i + 1, make_event(GenericEventE::Start), error);
+        }
     }
+
+    _lock.lock();
+
+    solid_check_log(!error, logger, "Failed starting listener: " << error.message());
+
+    _status.listen_addr_vec_.emplace_back(std::move(local_address));
 }
 
 //-----------------------------------------------------------------------------
@@ -956,9 +1142,9 @@ ErrorConditionT Service::doCreateConnectionPool(
                 const auto          pool_index{locked_pimpl->pool_free_list_.popFront()};
                 ConnectionPoolStub& rpool(pimpl_->pool_dq_[pool_index]);
 
-                pool_id                                      = ConnectionPoolId{pool_index, rpool.unique_};
-                rpool.name_                                  = _url;
-                locked_pimpl->name_map_[rpool.name_.c_str()] = pool_id;
+                pool_id     = ConnectionPoolId{pool_index, rpool.unique_};
+                rpool.name_ = _url;
+                locked_pimpl->registerName(rpool, pool_id);
             } else {
                 return error_service_connection_pool_count;
             }
@@ -996,7 +1182,7 @@ ErrorConditionT Service::Data::doLockPool(
         _rlock = unique_lock{poolMutex(_rpool_id.index)};
         ConnectionPoolStub& rpool(pool_dq_[_rpool_id.index]);
 
-        if (rpool.unique_ == _rpool_id.unique) {
+        if (rpool.unique_ == _rpool_id.unique && (_check_uid || rpool.name_ == _url)) {
             return ErrorConditionT{};
         } else {
             _rlock.unlock();
@@ -1019,9 +1205,9 @@ ErrorConditionT Service::Data::doLockPool(
                         const auto          pool_index{pool_free_list_.popFront()};
                         ConnectionPoolStub& rpool(pool_dq_[pool_index]);
 
-                        _rpool_id                      = ConnectionPoolId{pool_index, rpool.unique_};
-                        rpool.name_                    = _url;
-                        name_map_[rpool.name_.c_str()] = _rpool_id;
+                        _rpool_id   = ConnectionPoolId{pool_index, rpool.unique_};
+                        rpool.name_ = _url;
+                        registerName(rpool, _rpool_id);
                     } else {
                         return error_service_connection_pool_count;
                     }
@@ -1118,7 +1304,16 @@ ErrorConditionT Service::doSendMessage(
     const string_view                  url       = _recipient_url.hasURLNonEmpty() ? _recipient_url.url() : empty_url;
     ConnectionPoolId                   pool_id;
     bool                               check_uid = false;
-    {
+
+    if (_recipient_url.hasURL()) {
+        // the steady state: the name is already registered - no service mutex
+        locked_pimpl = acquire();
+        if (locked_pimpl && !locked_pimpl->findPoolByName(_recipient_url, url, pool_id)) {
+            locked_pimpl.reset();
+        }
+    }
+
+    if (!locked_pimpl) {
         unique_lock<std::mutex> lock;
 
         locked_pimpl = acquire(lock);
@@ -1129,36 +1324,9 @@ ErrorConditionT Service::doSendMessage(
             return error_service_stopping;
         }
 
-        if (_recipient_url.hasURL()) {
-
-            NameMapT::const_iterator it = locked_pimpl->name_map_.find(url);
-
-            if (it != locked_pimpl->name_map_.end()) {
-                pool_id = it->second;
-            } else {
-                if (configuration().isServerOnly()) {
-                    solid_log(logger, Error, this << " request for name resolve for a server only configuration");
-                    return error_service_server_only;
-                }
-                if (!pimpl_->pool_free_list_.empty()) {
-                    const auto          pool_index{locked_pimpl->pool_free_list_.popFront()};
-                    ConnectionPoolStub& rpool(pimpl_->pool_dq_[pool_index]);
-
-                    pool_id                                      = ConnectionPoolId{pool_index, rpool.unique_};
-                    rpool.name_                                  = url;
-                    locked_pimpl->name_map_[rpool.name_.c_str()] = pool_id;
-                } else {
-                    return error_service_connection_pool_count;
-                }
-            }
-        } else if (
-            static_cast<size_t>(_recipient_url.recipientId()->pool_id_.index) < pimpl_->pool_dq_.size()) {
-            // we cannot check the uid right now because we need a lock on the pool's mutex
-            check_uid = true;
-            pool_id   = _recipient_url.recipientId()->pool_id_;
-        } else {
-            solid_log(logger, Error, this << " recipient does not exist");
-            return error_service_unknown_recipient;
+        const auto error = locked_pimpl->doFindPool(*this, _recipient_url, url, pool_id, check_uid);
+        if (error) {
+            return error;
         }
     }
 
@@ -1181,6 +1349,168 @@ ErrorConditionT Service::doSendMessage(
     return locked_pimpl->doSendMessageToPool(*this, pool_id, _rmsgptr, _rcomplete_fnc, msg_type_idx, _recipient_url.relay_, _precipient_id_out, _pmsgid_out, _flags);
 }
 
+//-----------------------------------------------------------------------------
+ErrorConditionT Service::sendMessages(
+    const RecipientUrl& _recipient_url,
+    MessageBatch&       _rbatch)
+{
+    return doSendMessages(_recipient_url, _rbatch, nullptr);
+}
+//-----------------------------------------------------------------------------
+ErrorConditionT Service::sendMessages(
+    const RecipientUrl& _recipient_url,
+    MessageBatch&       _rbatch,
+    RecipientId&        _rrecipient_id)
+{
+    return doSendMessages(_recipient_url, _rbatch, &_rrecipient_id);
+}
+//-----------------------------------------------------------------------------
+ErrorConditionT Service::doSendMessages(
+    const RecipientUrl& _recipient_url,
+    MessageBatch&       _rbatch,
+    RecipientId*        _precipient_id_out)
+{
+    solid_log(logger, Verbose, this << " batch size = " << _rbatch.size());
+
+    if (_rbatch.empty()) {
+        return ErrorConditionT{};
+    }
+
+    solid_statistic_inc(pimpl_->statistic_.send_message_batch_count_);
+
+    if (_recipient_url.pctx_) {
+        // each message first tries the connection's writer directly, so there is no pool lock to share
+        ErrorConditionT error;
+        size_t          sent_count = 0;
+        for (auto& rstub : _rbatch.stub_vec_) {
+            error = doSendMessageUsingConnectionContext(_recipient_url, rstub.message_ptr_, rstub.complete_fnc_, nullptr, nullptr, rstub.flags_);
+            if (error) {
+                break;
+            }
+            ++sent_count;
+        }
+        _rbatch.stub_vec_.erase(_rbatch.stub_vec_.begin(), _rbatch.stub_vec_.begin() + sent_count);
+        return error;
+    }
+
+    solid_statistic_add(pimpl_->statistic_.send_message_count_, _rbatch.size());
+
+    shared_ptr<Data> locked_pimpl;
+
+    if (_recipient_url.hasRecipientId() && _recipient_url.recipientId()->isValidConnection()) {
+        if (_recipient_url.recipientId()->isValidPool()) {
+            locked_pimpl = acquire();
+
+            if (locked_pimpl) {
+            } else {
+                solid_log(logger, Error, this << " service not running");
+                return error_service_stopping;
+            }
+            return locked_pimpl->doSendMessagesToConnection(
+                *this,
+                *_recipient_url.recipientId(),
+                _rbatch,
+                _recipient_url.relay_);
+        } else {
+            solid_assert_log(false, logger);
+            return error_service_unknown_connection;
+        }
+    }
+
+    if (!_recipient_url.hasRecipientId() && !_recipient_url.hasURL()) {
+        solid_log(logger, Error, this << " wrong url");
+        return error_service_invalid_url;
+    }
+
+    static constexpr const string_view empty_url = ":";
+    const string_view                  url       = _recipient_url.hasURLNonEmpty() ? _recipient_url.url() : empty_url;
+    ConnectionPoolId                   pool_id;
+    bool                               check_uid = false;
+
+    if (_recipient_url.hasURL()) {
+        // the steady state: the name is already registered - no service mutex
+        locked_pimpl = acquire();
+        if (locked_pimpl && !locked_pimpl->findPoolByName(_recipient_url, url, pool_id)) {
+            locked_pimpl.reset();
+        }
+    }
+
+    if (!locked_pimpl) {
+        unique_lock<std::mutex> lock;
+
+        locked_pimpl = acquire(lock);
+
+        if (locked_pimpl) {
+        } else {
+            solid_log(logger, Error, this << " service not running");
+            return error_service_stopping;
+        }
+
+        const auto error = locked_pimpl->doFindPool(*this, _recipient_url, url, pool_id, check_uid);
+        if (error) {
+            return error;
+        }
+    }
+
+    for (auto& rstub : _rbatch.stub_vec_) {
+        rstub.type_index_ = locked_pimpl->config_.protocol().typeIndex(rstub.message_ptr_.get());
+        if (rstub.type_index_ == 0) {
+            solid_log(logger, Error, this << " message type not registered");
+            return error_service_message_unknown_type;
+        }
+    }
+
+    unique_lock<std::mutex> pool_lock;
+    const auto              error = locked_pimpl->doLockPool(*this, check_uid, url, pool_id, pool_lock);
+    if (!error) {
+    } else {
+        return error;
+    }
+
+    solid_assert(pool_lock.owns_lock());
+
+    return locked_pimpl->doSendMessagesToPool(*this, pool_id, _rbatch, _recipient_url.relay_, _precipient_id_out);
+}
+//-----------------------------------------------------------------------------
+// Called with the service mutex locked
+ErrorConditionT Service::Data::doFindPool(
+    Service& _rsvc, const RecipientUrl& _recipient_url, const string_view& _url,
+    ConnectionPoolId& _rpool_id, bool& _rcheck_uid)
+{
+    if (_recipient_url.hasURL()) {
+        solid_statistic_inc(statistic_.send_message_name_lookup_count_);
+
+        NameMapT::const_iterator it = name_map_.find(_url);
+
+        if (it != name_map_.end()) {
+            _rpool_id = it->second;
+        } else {
+            if (config_.isServerOnly()) {
+                solid_log(logger, Error, &_rsvc << " request for name resolve for a server only configuration");
+                return error_service_server_only;
+            }
+            if (!pool_free_list_.empty()) {
+                const auto          pool_index{pool_free_list_.popFront()};
+                ConnectionPoolStub& rpool(pool_dq_[pool_index]);
+
+                _rpool_id   = ConnectionPoolId{pool_index, rpool.unique_};
+                rpool.name_ = _url;
+                registerName(rpool, _rpool_id);
+            } else {
+                return error_service_connection_pool_count;
+            }
+        }
+    } else if (
+        static_cast<size_t>(_recipient_url.recipientId()->pool_id_.index) < pool_dq_.size()) {
+        // we cannot check the uid right now because we need a lock on the pool's mutex
+        _rcheck_uid = true;
+        _rpool_id   = _recipient_url.recipientId()->pool_id_;
+    } else {
+        solid_log(logger, Error, &_rsvc << " recipient does not exist");
+        return error_service_unknown_recipient;
+    }
+    return ErrorConditionT{};
+}
 //-----------------------------------------------------------------------------
 
 ErrorConditionT Service::Data::doSendMessageToConnection(
@@ -1263,6 +1593,171 @@ ErrorConditionT Service::Data::doSendMessageToConnection(
     return error;
 }
 //-----------------------------------------------------------------------------
+ErrorConditionT Service::Data::doSendMessagesToConnection(
+    Service&                           _rsvc,
+    const RecipientId&                 _rrecipient_id_in,
+    MessageBatch&                      _rbatch,
+    const OptionalMessageRelayHeaderT& _relay)
+{
+    solid_log(logger, Verbose, &_rsvc << " batch size = " << _rbatch.size());
+    solid_statistic_add(statistic_.send_message_to_connection_count_, _rbatch.size());
+
+    for (auto& rstub : _rbatch.stub_vec_) {
+        rstub.type_index_ = config_.protocol().typeIndex(rstub.message_ptr_.get());
+        if (rstub.type_index_ == 0) {
+            solid_log(logger, Error, &_rsvc << " message type not registered");
+            return error_service_message_unknown_type;
+        }
+
+        rstub.flags_ |= MessageFlagsE::OneShotSend;
+
+        if (Message::is_response_part(rstub.flags_) || Message::is_response_last(rstub.flags_)) {
+            rstub.flags_ |= MessageFlagsE::Synchronous;
+        }
+    }
+
+    const size_t pool_index = static_cast<size_t>(_rrecipient_id_in.poolId().index);
+    if (pool_index < pool_dq_.size()) {
+    } else {
+        solid_log(logger, Error, &_rsvc << " unknown connection");
+        return error_service_unknown_connection;
+    }
+
+    unique_lock<std::mutex> pool_lock{poolMutex(pool_index)};
+    ConnectionPoolStub&     rpool = pool_dq_[pool_index];
+
+    if (rpool.unique_ == _rrecipient_id_in.poolId().unique && !rpool.isClosing() && !rpool.isFastClosing()) {
+    } else {
+        solid_log(logger, Error, &_rsvc << " unknown connection or connection closing");
+        return error_service_unknown_connection;
+    }
+
+    if (rpool.isServerSide()) {
+        // unnamed pool has a single connection - notify it once for the whole batch
+        bool should_notify = false;
+
+        for (auto& rstub : _rbatch.stub_vec_) {
+            bool is_first = false;
+            rpool.pushBackMessage(rstub.message_ptr_, rstub.type_index_, rstub.complete_fnc_, rstub.flags_, _relay, is_first);
+            should_notify = should_notify || is_first;
+        }
+        _rbatch.clear();
+
+        pool_lock.unlock();
+
+        if (should_notify) {
+            _rsvc.manager().notify(_rrecipient_id_in.connectionId(), Connection::eventNewMessage());
+        }
+    } else {
+        // the event carries the message id, so the connection is notified for every message
+        std::vector<MessageId> msgid_vec;
+        msgid_vec.reserve(_rbatch.size());
+
+        for (auto& rstub : _rbatch.stub_vec_) {
+            msgid_vec.emplace_back(rpool.insertMessage(rstub.message_ptr_, rstub.type_index_, rstub.complete_fnc_, rstub.flags_, _relay));
+        }
+        _rbatch.clear();
+
+        pool_lock.unlock();
+
+        for (const auto& msgid : msgid_vec) {
+            _rsvc.manager().notify(_rrecipient_id_in.connectionId(), Connection::eventNewMessage(msgid));
+        }
+    }
+    return ErrorConditionT{};
+}
+//-----------------------------------------------------------------------------
+ErrorConditionT Service::Data::doSendMessagesToPool(
+    Service& _rsvc, const ConnectionPoolId& _rpool_id, MessageBatch& _rbatch,
+    const OptionalMessageRelayHeaderT& _relay,
+    RecipientId*                       _precipient_id_out)
+{
+    solid_log(logger, Verbose, &_rsvc << " " << _rpool_id << " batch size = " << _rbatch.size());
+    solid_statistic_add(statistic_.send_message_to_pool_count_, _rbatch.size());
+
+    ConnectionPoolStub& rpool(pool_dq_[_rpool_id.index]);
+
+    if (rpool.isClosing()) {
+        solid_log(logger, Error, &_rsvc << " connection pool is stopping");
+        return error_service_pool_stopping;
+    }
+
+    if (_precipient_id_out != nullptr) {
+        _precipient_id_out->pool_id_ = _rpool_id;
+    }
+
+    ErrorConditionT error;
+    size_t          sent_count        = 0;
+    size_t          async_count       = 0;
+    bool            has_synchronous   = false;
+    bool            should_create_new = false;
+
+    for (auto& rstub : _rbatch.stub_vec_) {
+        if (rpool.isFull(config_.pool_max_message_queue_size)) {
+            solid_log(logger, Error, &_rsvc << " connection pool is full");
+            error = error_service_pool_full;
+            break;
+        }
+
+        bool            is_first = false;
+        const MessageId msgid    = rpool.pushBackMessage(rstub.message_ptr_, rstub.type_index_, rstub.complete_fnc_, rstub.flags_, _relay, is_first);
+
+        ++sent_count;
+
+        if (
+            rpool.isCleaningOneShotMessages() && Message::is_one_shot(rstub.flags_)) {
+            const bool success = _rsvc.manager().notify(
+                rpool.main_connection_id_,
+                Connection::eventClosePoolMessage(msgid));
+
+            if (success) {
+                solid_log(logger, Verbose, &_rsvc << " message " << msgid << " from pool " << _rpool_id << " sent for canceling to " << rpool.main_connection_id_);
+                // erase/unlink the message from any list
+                if (rpool.message_order_inner_list_.contains(msgid.index)) {
+                    rpool.eraseMessageOrderAsync(msgid.index);
+                }
+            } else {
+                solid_throw_log(logger, "Message Cancel connection not available");
+            }
+        } else if (Message::is_synchronous(rstub.flags_)) {
+            has_synchronous = true;
+        } else {
+            ++async_count;
+        }
+    }
+
+    _rbatch.stub_vec_.erase(_rbatch.stub_vec_.begin(), _rbatch.stub_vec_.begin() + sent_count);
+
+    if (has_synchronous) {
+        if (rpool.isMainConnectionActive()) {
+            const bool success = _rsvc.manager().notify(
+                rpool.main_connection_id_,
+                Connection::eventNewMessage());
+            solid_assert_log(success, logger);
+            (void)success;
+        } else {
+            should_create_new = true;
+        }
+    }
+
+    if (async_count != 0) {
+        // wake at most one waiting connection per asynchronous message, each one only once
+        size_t notified_count = 0;
+        while (notified_count < async_count && doTryNotifyPoolWaitingConnection(_rsvc, _rpool_id.index)) {
+            ++notified_count;
+        }
+        should_create_new = should_create_new || notified_count == 0;
+    }
+
+    if (should_create_new) {
+        ErrorConditionT create_error;
+        if (!doTryCreateNewConnectionForPool(_rsvc, _rpool_id.index, create_error)) {
+            solid_log(logger, Info, &_rsvc << " no connection notified about the new messages");
+        }
+    }
+    return error;
+}
+//-----------------------------------------------------------------------------
 ErrorConditionT Service::Data::doSendMessageToPool(
     Service& _rsvc, const ConnectionPoolId& _rpool_id, MessagePointerT<>& _rmsgptr,
     MessageCompleteFunctionT&          _rcomplete_fnc,
@@ -1628,7 +2123,7 @@ ErrorConditionT Service::doDelayCloseConnectionPool(
     {
         lock_guard<std::mutex> lock(locked_pimpl->rmutex_);
         if (!rpool.name_.empty()) {
-            pimpl_->name_map_.erase(rpool.name_.c_str());
+            pimpl_->unregisterName(rpool);
         }
     }
 
@@ -1679,7 +2174,7 @@ ErrorConditionT Service::doForceCloseConnectionPool(
         lock_guard<std::mutex> lock(locked_pimpl->rmutex_);
 
         if (!rpool.name_.empty()) {
-            locked_pimpl->name_map_.erase(rpool.name_.c_str());
+            locked_pimpl->unregisterName(rpool);
         }
     }
 
@@ -2191,7 +2686,10 @@ bool Service::Data::doMainConnectionStoppingCleanAll(
         rpool.resetCleaningAllMessages();
 
         if (!rpool.name_.empty() && !rpool.isClosing()) { // closing pools are already unregistered from namemap
-            name_map_.erase(rpool.name_.c_str());
+            {
+                lock_guard<std::mutex> lock{rmutex_};
+                unregisterName(rpool);
+            }
             rpool.setClosing();
             solid_log(logger, Verbose, this << " pool " << pool_index << " set closing");
         }
@@ -2243,7 +2741,7 @@ bool Service::Data::doMainConnectionStoppingPrepareCleanOneShot(
         if (!rpool.name_.empty() && !rpool.isClosing()) { // closing pools are already unregistered from namemap
             {
                 lock_guard<std::mutex> lock{rmutex_};
-                name_map_.erase(rpool.name_.c_str());
+                unregisterName(rpool);
                 rpool.name_.clear();
             }
             rpool.setClosing();
@@ -2271,7 +2769,7 @@ bool Service::Data::doMainConnectionStoppingPrepareCleanAll(
 
     if (!rpool.name_.empty() && !rpool.isClosing()) { // closing pools are already unregistered from namemap
         lock_guard<std::mutex> lock{rmutex_};
-        name_map_.erase(rpool.name_.c_str());
+        unregisterName(rpool);
         rpool.name_.clear();
     }
 
@@ -2389,7 +2887,7 @@ void Service::connectionStop(ConnectionContext& _rconctx)
             pimpl_->pool_free_list_.pushBack(pool_index);
 
             if (!rpool.name_.empty() && !rpool.isClosing()) { // closing pools are already unregistered from namemap
-                pimpl_->name_map_.erase(rpool.name_.c_str());
+                pimpl_->unregisterName(rpool);
             }
 
             on_event_fnc = std::move(rpool.on_event_fnc_);
@@ -2600,7 +3098,7 @@ ErrorConditionT Service::activateConnection(ConnectionContext& _rconctx, ActorId
     return error;
 }
 //-----------------------------------------------------------------------------
-void Service::acceptIncomingConnection(SocketDevice& _rsd)
+void Service::acceptIncomingConnection(SocketDevice& _rsd, const size_t _reactor_index)
 {
     solid_log(logger, Verbose, this);
 
@@ -2618,13 +3116,25 @@ void Service::acceptIncomingConnection(SocketDevice& _rsd)
 
     configuration().server.socket_device_setup_fnc(_rsd);
 
+    int incoming_cpu = -1;
+    if (configuration().server.connection_near_incoming_cpu && _reactor_index == InvalidIndex()) {
+        _rsd.incomingCpu(incoming_cpu);
+    }
+
     {
         lock_guard<std::mutex> pool_lock(pimpl_->poolMutex(pool_index));
         ConnectionPoolStub&    rpool(pimpl_->pool_dq_[pool_index]);
         auto                   actptr(new_connection(configuration(), _rsd, ConnectionPoolId(pool_index, rpool.unique_), rpool.name_));
         solid::ErrorConditionT error;
-        ActorIdT               con_id = pimpl_->config_.actor_create_fnc(
-            std::move(actptr), *this, make_event(GenericEventE::Start), error);
+        ActorIdT               con_id;
+
+        if (_reactor_index != InvalidIndex()) {
+            con_id = pimpl_->config_.actor_create_on_fnc(std::move(actptr), *this, _reactor_index, make_event(GenericEventE::Start), error);
+        } else if (incoming_cpu >= 0 && !solid_function_empty(pimpl_->config_.actor_create_near_fnc)) {
+            con_id = pimpl_->config_.actor_create_near_fnc(std::move(actptr), *this, incoming_cpu, make_event(GenericEventE::Start), error);
+        } else {
+            con_id = pimpl_->config_.actor_create_fnc(std::move(actptr), *this, make_event(GenericEventE::Start), error);
+        }
 
         solid_log(logger, Info, this << " receive connection [" << con_id << "] error = " << error.message());
 
@@ -2797,6 +3307,8 @@ ServiceStatistic::ServiceStatistic()
     , send_message_context_count_(0)
     , send_message_to_connection_count_(0)
     , send_message_to_pool_count_(0)
+    , send_message_batch_count_(0)
+    , send_message_name_lookup_count_(0)
     , reject_new_pool_message_count_(0)
     , connection_new_pool_message_count_(0)
     , connection_do_send_count_(0)
@@ -2815,6 +3327,7 @@ ServiceStatistic::ServiceStatistic()
     , connection_recv_buff_size_count_03_(0)
     , connection_recv_buff_size_count_04_(0)
     , connection_send_posted_(0)
+    , connection_send_zero_copy_count_(0)
     , max_fetch_size_(0)
     , min_fetch_size_(-1)
 {
@@ -2827,6 +3340,8 @@ std::ostream& ServiceStatistic::print(std::ostream& _ros) const
     _ros << " send_message_context_count = " << send_message_context_count_;
     _ros << " send_message_to_connection_count = " << send_message_to_connection_count_;
     _ros << " send_message_to_pool_count = " << send_message_to_pool_count_;
+    _ros << " send_message_batch_count = " << send_message_batch_count_;
+    _ros << " send_message_name_lookup_count = " << send_message_name_lookup_count_;
     _ros << " reject_new_pool_message = " << reject_new_pool_message_count_;
     _ros << " connection_new_pool_message_count = " << connection_new_pool_message_count_;
     _ros << " connection_do_send_count = " << connection_do_send_count_;
@@ -2834,6 +3349,7 @@ std::ostream& ServiceStatistic::print(std::ostream& _ros) const
     _ros << " connection_send_done_count = " << connection_send_done_count_;
     _ros << " connection_send_buff_size_max = " << connection_send_buff_size_max_;
     _ros << " connection_send_posted = " << connection_send_posted_;
+    _ros << " connection_send_zero_copy_count = " << connection_send_zero_copy_count_;
     _ros << " connection_send_buff_size_count = [0:" << connection_send_buff_size_count_00_ << " 01:" << connection_send_buff_size_count_01_;
     _ros << " 02:" << connection_send_buff_size_count_02_ << " 03:" << connection_send_buff_size_count_03_ << " 04:" << connection_send_buff_size_count_04_ << ']';
     _ros << " connection_recv_buff_size_max = " << connection_recv_buff_size_max_;
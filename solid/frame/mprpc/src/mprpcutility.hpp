@@ -74,8 +74,11 @@ public:
         Size64KB   = 1, // DO NOT CHANGE!!
         Compressed = 2,
         AckRequest = 4,
+        SizeHigh   = 0xf8, // bits 17 to 21 of the size on jumbo packets, the compression engine id on compressed packets
     };
 
+    static constexpr uint8_t size_high_shift = 3;
+
     PacketHeader(
         const TypeE    _type  = TypeE::Data,
         const uint8_t  _flags = 0,
@@ -97,9 +100,25 @@ public:
     uint32_t size() const
     {
         uint32_t sz = (flags_ & static_cast<uint32_t>(FlagE::Size64KB));
+        if (!isCompressed()) {
+            sz |= (flags_ & static_cast<uint32_t>(FlagE::SizeHigh)) >> (size_high_shift - 1);
+        }
         return (sz << 16) | size_;
     }
 
+    //! The negotiated engine of a compressed packet - 0 for Configuration::writer.inplace_compress_fnc
+    uint8_t compressionEngineId() const
+    {
+        return (flags_ & static_cast<uint8_t>(FlagE::SizeHigh)) >> size_high_shift;
+    }
+
+    //! Mark the packet as compressed - before setting its size
+    void compressed(const uint8_t _engine_id)
+    {
+        flags_ &= ~static_cast<uint8_t>(FlagE::SizeHigh);
+        flags_ |= static_cast<uint8_t>(FlagE::Compressed) | static_cast<uint8_t>(_engine_id << size_high_shift);
+    }
+
     uint8_t type() const
     {
         return type_;
@@ -122,7 +141,12 @@ public:
     void size(uint32_t _sz)
     {
         size_ = _sz & 0xffff;
+        flags_ &= ~static_cast<uint8_t>(FlagE::Size64KB);
         flags_ |= ((_sz & (1 << 16)) >> 16);
+        if (!isCompressed()) {
+            flags_ &= ~static_cast<uint8_t>(FlagE::SizeHigh);
+            flags_ |= ((_sz >> 17) << size_high_shift) & static_cast<uint8_t>(FlagE::SizeHigh);
+        }
     }
 
     bool isTypeKeepAlive() const
@@ -134,7 +158,7 @@ public:
     {
         return flags_ & static_cast<uint8_t>(FlagE::Compressed);
     }
-    bool isOk() const
+    bool isOk(const size_t _max_size = Protocol::MaxPacketDataSize) const
     {
         switch (static_cast<TypeE>(type_)) {
         case TypeE::Data:
@@ -144,7 +168,7 @@ public:
             return false;
         }
 
-        return size() <= Protocol::MaxPacketDataSize;
+        return size() <= _max_size;
     }
 
     char* store(char* _pc, const Protocol& _rproto) const
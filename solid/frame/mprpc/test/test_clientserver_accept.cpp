@@ -0,0 +1,193 @@
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v3.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "solid/utility/threadpool.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+namespace {
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor<frame::mprpc::EventT>>;
+using CallPoolT     = ThreadPool<Function<void()>, Function<void()>>;
+
+struct Message : frame::mprpc::Message {
+    uint32_t idx = 0;
+
+    SOLID_REFLECT_V1(_rr, _rthis, _rctx)
+    {
+        _rr.add(_rthis.idx, _rctx, 0, "idx");
+    }
+};
+
+using MessagePointerT = solid::frame::mprpc::MessagePointerT<Message>;
+
+mutex                   mtx;
+condition_variable      cnd;
+size_t                  server_connection_count = 0;
+map<thread::id, size_t> server_thread_map;
+
+void server_connection_start(frame::mprpc::ConnectionContext& _rctx)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId());
+    lock_guard<mutex> lock(mtx);
+    ++server_connection_count;
+    ++server_thread_map[this_thread::get_id()];
+    cnd.notify_one();
+}
+
+void connection_stop(frame::mprpc::ConnectionContext& _rctx)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+}
+
+void complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+}
+
+} // namespace
+
+// Connection setup rate of a server listening either on a single socket (connections are spread
+// round-robin on reactors), on one SO_REUSEPORT socket per reactor or on a single socket with
+// NUMA placed reactors and connections started near their incoming cpu.
+int test_clientserver_accept(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWX"});
+
+    bool   reuse_port       = false;
+    bool   numa_placement   = false;
+    size_t connection_count = 400;
+    size_t reactor_count    = 4;
+
+    if (argc > 1) {
+        reuse_port     = *argv[1] == 'r' || *argv[1] == 'R';
+        numa_placement = *argv[1] == 'n' || *argv[1] == 'N';
+    }
+    if (argc > 2) {
+        connection_count = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        reactor_count = atoi(argv[3]);
+    }
+
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpcserver(m);
+        frame::mprpc::ServiceT mprpcclient(m);
+        CallPoolT              cwp{{1, 100, 0}, [](const size_t) {}, [](const size_t) {}};
+        frame::aio::Resolver   resolver([&cwp](std::function<void()>&& _fnc) { cwp.pushOne(std::move(_fnc)); });
+
+        sch_client.start(1);
+        if (numa_placement) {
+            sch_server.start(frame::SchedulerPlacement::numa(reactor_count));
+        } else {
+            sch_server.start(reactor_count);
+        }
+
+        std::string server_port;
+
+        { // mprpc server initialization
+            auto proto = frame::mprpc::serialization_v3::create_protocol<reflection::v1::metadata::Variant, uint8_t>(
+                reflection::v1::metadata::factory,
+                [&](auto& _rmap) {
+                    _rmap.template registerMessage<Message>(1, "Message", complete_message);
+                });
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            cfg.connection_stop_fnc         = &connection_stop;
+            cfg.server.connection_start_fnc = &server_connection_start;
+
+            cfg.server.listener_address_str = "0.0.0.0:0";
+            cfg.server.listener_reuse_port  = reuse_port;
+
+            cfg.server.connection_near_incoming_cpu = numa_placement;
+
+            {
+                frame::mprpc::ServiceStartStatus start_status;
+                mprpcserver.start(start_status, std::move(cfg));
+
+                std::ostringstream oss;
+                oss << start_status.listen_addr_vec_.back().port();
+                server_port = oss.str();
+                solid_dbg(generic_logger, Info, "server listens on: " << start_status.listen_addr_vec_.back());
+            }
+        }
+
+        { // mprpc client initialization
+            auto proto = frame::mprpc::serialization_v3::create_protocol<reflection::v1::metadata::Variant, uint8_t>(
+                reflection::v1::metadata::factory,
+                [&](auto& _rmap) {
+                    _rmap.template registerMessage<Message>(1, "Message", complete_message);
+                });
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            cfg.connection_stop_fnc = &connection_stop;
+
+            // every pool name resolves to the server
+            cfg.client.name_resolve_fnc = [resolve_fnc = frame::mprpc::InternetResolverF{resolver, server_port, "127.0.0.1"}](const std::string&, frame::mprpc::ResolveCompleteFunctionT& _cbk) mutable {
+                resolve_fnc("", _cbk);
+            };
+
+            mprpcclient.start(std::move(cfg));
+        }
+
+        const auto start_time = chrono::steady_clock::now();
+
+        for (size_t i = 0; i < connection_count; ++i) {
+            const auto err = mprpcclient.createConnectionPool("c" + to_string(i), 1);
+            solid_check(!err, "failed creating pool " << i << ": " << err.message());
+        }
+
+        {
+            unique_lock<mutex> lock(mtx);
+
+            if (!cnd.wait_for(lock, std::chrono::seconds(60), [connection_count]() { return server_connection_count >= connection_count; })) {
+                solid_throw("Process is taking too long: " << server_connection_count << " connections of " << connection_count);
+            }
+        }
+
+        const auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time);
+
+        mprpcclient.stop();
+        mprpcserver.stop();
+
+        lock_guard<mutex> lock(mtx);
+
+        cout << (reuse_port ? "SO_REUSEPORT" : "single") << " listener: " << connection_count << " connections in " << duration.count() << "us - "
+             << (connection_count * 1000000.0 / duration.count()) << " connections/s" << endl;
+        cout << "server reactor distribution:";
+        for (const auto& p : server_thread_map) {
+            cout << ' ' << p.second;
+        }
+        cout << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v3.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/utility/threadpool.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+namespace {
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor<frame::mprpc::EventT>>;
+using CallPoolT     = ThreadPool<Function<void()>, Function<void()>>;
+
+struct Message : frame::mprpc::Message {
+    uint32_t    idx = 0;
+    std::string str;
+
+    Message() = default;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+        , str("small message payload")
+    {
+    }
+
+    SOLID_REFLECT_V1(_rr, _rthis, _rctx)
+    {
+        _rr.add(_rthis.idx, _rctx, 0, "idx").add(_rthis.str, _rctx, 1, "str");
+    }
+};
+
+using MessagePointerT = solid::frame::mprpc::MessagePointerT<Message>;
+
+mutex              mtx;
+condition_variable cnd;
+size_t             server_received_count = 0;
+size_t             client_complete_count = 0;
+size_t             expected_count        = 0;
+
+void server_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "error: " << _rerror.message());
+    if (_rrecv_msg_ptr) {
+        lock_guard<mutex> lock(mtx);
+        ++server_received_count;
+        if (server_received_count == expected_count) {
+            cnd.notify_one();
+        }
+    }
+}
+
+void client_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "error: " << _rerror.message());
+    solid_check(_rsent_msg_ptr && !_rrecv_msg_ptr);
+    lock_guard<mutex> lock(mtx);
+    ++client_complete_count;
+    if (client_complete_count == expected_count) {
+        cnd.notify_one();
+    }
+}
+
+} // namespace
+
+// Compares enqueueing messages for one recipient with a loop of sendMessage calls
+// against sendMessages with MessageBatch.
+// Every tick sends tick_message_count messages and waits for all of them to be delivered.
+int test_clientserver_batch(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWX"});
+
+    size_t tick_count         = 100;
+    size_t tick_message_count = 1000;
+    size_t batch_size         = 100; // 0 - send one by one
+
+    if (argc > 1) {
+        batch_size = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        tick_count = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        tick_message_count = atoi(argv[3]);
+    }
+
+    const size_t message_count = tick_count * tick_message_count;
+
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpcserver(m);
+        frame::mprpc::ServiceT mprpcclient(m);
+        CallPoolT              cwp{{1, 100, 0}, [](const size_t) {}, [](const size_t) {}};
+        frame::aio::Resolver   resolver([&cwp](std::function<void()>&& _fnc) { cwp.pushOne(std::move(_fnc)); });
+
+        sch_client.start(1);
+        sch_server.start(1);
+
+        std::string server_port;
+
+        { // mprpc server initialization
+            auto proto = frame::mprpc::serialization_v3::create_protocol<reflection::v1::metadata::Variant, uint8_t>(
+                reflection::v1::metadata::factory,
+                [&](auto& _rmap) {
+                    _rmap.template registerMessage<Message>(1, "Message", server_complete_message);
+                });
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            cfg.server.listener_address_str   = "0.0.0.0:0";
+            cfg.server.connection_start_state = frame::mprpc::ConnectionState::Active;
+
+            {
+                frame::mprpc::ServiceStartStatus start_status;
+                mprpcserver.start(start_status, std::move(cfg));
+
+                std::ostringstream oss;
+                oss << start_status.listen_addr_vec_.back().port();
+                server_port = oss.str();
+                solid_dbg(generic_logger, Info, "server listens on: " << start_status.listen_addr_vec_.back());
+            }
+        }
+
+        { // mprpc client initialization
+            auto proto = frame::mprpc::serialization_v3::create_protocol<reflection::v1::metadata::Variant, uint8_t>(
+                reflection::v1::metadata::factory,
+                [&](auto& _rmap) {
+                    _rmap.template registerMessage<Message>(1, "Message", client_complete_message);
+                });
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            cfg.pool_max_message_queue_size   = tick_message_count;
+            cfg.client.connection_start_state = frame::mprpc::ConnectionState::Active;
+            cfg.client.name_resolve_fnc       = frame::mprpc::InternetResolverF{resolver, server_port, "127.0.0.1"};
+
+            mprpcclient.start(std::move(cfg));
+        }
+
+        frame::mprpc::RecipientId recipient_id;
+        {
+            const auto err = mprpcclient.createConnectionPool("localhost", recipient_id, [](frame::mprpc::ConnectionContext&, EventBase&&, const ErrorConditionT&) {}, 1);
+            solid_check(!err, "failed creating pool: " << err.message());
+        }
+
+        const auto                 start_time = chrono::steady_clock::now();
+        chrono::microseconds       enqueue_duration{0};
+        frame::mprpc::MessageBatch batch(batch_size);
+
+        for (size_t tick = 0; tick < tick_count; ++tick) {
+            const size_t tick_start_index = tick * tick_message_count;
+            const auto   tick_start_time  = chrono::steady_clock::now();
+
+            {
+                lock_guard<mutex> lock(mtx);
+                expected_count = tick_start_index + tick_message_count;
+            }
+
+            if (batch_size == 0) {
+                for (size_t i = tick_start_index; i < expected_count; ++i) {
+                    const auto err = mprpcclient.sendMessage(recipient_id, frame::mprpc::make_message<Message>(static_cast<uint32_t>(i)));
+                    solid_check(!err, "send error: " << err.message());
+                }
+            } else {
+                for (size_t i = tick_start_index; i < expected_count;) {
+                    for (size_t j = 0; j < batch_size && i < expected_count; ++j, ++i) {
+                        batch.add(frame::mprpc::make_message<Message>(static_cast<uint32_t>(i)));
+                    }
+                    const auto err = mprpcclient.sendMessages(recipient_id, batch);
+                    solid_check(!err && batch.empty(), "send error: " << err.message());
+                }
+            }
+
+            enqueue_duration += chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - tick_start_time);
+
+            unique_lock<mutex> lock(mtx);
+
+            if (!cnd.wait_for(lock, std::chrono::seconds(120), []() { return server_received_count == expected_count && client_complete_count == expected_count; })) {
+                solid_throw("Process is taking too long: received " << server_received_count << " completed " << client_complete_count << " of " << expected_count);
+            }
+        }
+
+        const auto total_duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time);
+
+        mprpcclient.stop();
+        mprpcserver.stop();
+
+        cout << (batch_size == 0 ? string("single sends") : "batches of " + to_string(batch_size)) << ": " << tick_count << " ticks of " << tick_message_count << " messages" << endl;
+        cout << "enqueue: " << enqueue_duration.count() << "us - " << (enqueue_duration.count() * 1000 / message_count) << "ns/msg" << endl;
+        cout << "delivered: " << total_duration.count() << "us - " << (message_count * 1000000.0 / total_duration.count()) << " msg/s" << endl;
+
+        solid_log(generic_logger, Statistic, "mprpcclient statistic: " << mprpcclient.statistic());
+    }
+
+    return 0;
+}
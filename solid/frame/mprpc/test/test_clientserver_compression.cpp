@@ -0,0 +1,337 @@
+#include "solid/frame/mprpc/mprpccompression_lz4.hpp"
+#include "solid/frame/mprpc/mprpccompression_snappy.hpp"
+#include "solid/frame/mprpc/mprpccompression_zstd.hpp"
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v3.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/utility/threadpool.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+namespace {
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor<frame::mprpc::EventT>>;
+using CallPoolT     = ThreadPool<Function<void()>, Function<void()>>;
+
+const char* actions[] = {"login", "logout", "read", "write"};
+
+// small repetitive json like records
+string make_record(uint32_t _idx, const size_t _size)
+{
+    string s;
+    while (s.size() < _size) {
+        s += "{\"id\":" + to_string((_idx * 7919) % 100000) + ",\"user\":\"user" + to_string(_idx % 97) + "\",\"action\":\"" + actions[_idx % 4] + "\",\"status\":\"ok\",\"ts\":" + to_string(1700000000 + _idx * 13) + "}";
+        ++_idx;
+    }
+    s.resize(_size);
+    return s;
+}
+
+string make_random(uint32_t _idx, const size_t _size)
+{
+    string   s(_size, '\0');
+    uint32_t seed = _idx + 1;
+    for (auto& c : s) {
+        seed = seed * 1103515245 + 12345;
+        c    = static_cast<char>(seed >> 16);
+    }
+    return s;
+}
+
+struct Message : frame::mprpc::Message {
+    uint32_t    idx    = 0;
+    bool        random = false;
+    std::string str;
+
+    Message() = default;
+
+    Message(uint32_t _idx, const bool _random, const size_t _size)
+        : idx(_idx)
+        , random(_random)
+        , str(_random ? make_random(_idx, _size) : make_record(_idx, _size))
+    {
+    }
+
+    SOLID_REFLECT_V1(_rr, _rthis, _rctx)
+    {
+        _rr.add(_rthis.idx, _rctx, 0, "idx").add(_rthis.random, _rctx, 1, "random").add(_rthis.str, _rctx, 2, "str");
+    }
+
+    bool check() const
+    {
+        return str == (random ? make_random(idx, str.size()) : make_record(idx, str.size()));
+    }
+};
+
+using MessagePointerT = solid::frame::mprpc::MessagePointerT<Message>;
+
+struct Counters {
+    atomic<size_t> compress_count[frame::mprpc::Protocol::MaxCompressionEngineId + 1]   = {};
+    atomic<size_t> decompress_count[frame::mprpc::Protocol::MaxCompressionEngineId + 1] = {};
+
+    size_t decompressed() const
+    {
+        size_t count = 0;
+        for (const auto& c : decompress_count) {
+            count += c;
+        }
+        return count;
+    }
+};
+
+Counters server_counters;
+Counters client_counters;
+
+template <class Engine>
+void register_counted(frame::mprpc::Configuration& _rcfg, const uint8_t _id, Engine _engine, Counters& _rcounters)
+{
+    _rcfg.registerCompressionEngine(
+        _id,
+        [_engine, &_rcounters, _id](char* _piobuf, size_t _bufsz, ErrorConditionT& _rerror) mutable {
+            ++_rcounters.compress_count[_id];
+            return _engine(_piobuf, _bufsz, _rerror);
+        },
+        [_engine, &_rcounters, _id](char* _pto, const char* _pfrom, size_t _from_sz, ErrorConditionT& _rerror) mutable {
+            ++_rcounters.decompress_count[_id];
+            return _engine(_pto, _pfrom, _from_sz, _rerror);
+        });
+}
+
+mutex              mtx;
+condition_variable cnd;
+size_t             client_received_count = 0;
+
+void server_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rrecv_msg_ptr) {
+        solid_check(_rrecv_msg_ptr->check(), "message check failed on server");
+        const auto err = _rctx.service().sendResponse(_rctx, _rrecv_msg_ptr);
+        solid_check(!err, "send response error: " << err.message());
+    }
+}
+
+void client_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "error: " << _rerror.message());
+    if (_rrecv_msg_ptr) {
+        solid_check(_rrecv_msg_ptr->check(), "message check failed on client");
+        lock_guard<mutex> lock(mtx);
+        ++client_received_count;
+        cnd.notify_one();
+    }
+}
+
+} // namespace
+
+// Negotiates the compression engine per connection direction:
+// z - server {zstd, lz4, snappy}, client {lz4, zstd}: the server sends zstd, the client lz4
+// d - server {zstd+dict, lz4+dict}, client {lz4+dict, zstd+dict}: trained dictionaries
+// n - server without engines: nothing negotiated, nothing compressed
+// b - poorly compressing (random) messages: compression is mostly bypassed
+int test_clientserver_compression(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWX"});
+
+    char   choice        = 'z';
+    size_t message_count = 1000;
+
+    if (argc > 1) {
+        choice = *argv[1];
+    }
+    if (argc > 2) {
+        message_count = atoi(argv[2]);
+    }
+
+    const uint8_t zstd_dict_id = 10;
+    const uint8_t lz4_dict_id  = 11;
+    const bool    random       = choice == 'b';
+    const size_t  min_size     = random ? 16 * 1024 : 64;
+    const size_t  max_size     = random ? 16 * 1024 : 2048;
+    const auto    message_size = [min_size, max_size](const size_t _idx) { return min_size + (_idx * 131) % (max_size - min_size + 1); };
+
+    frame::mprpc::zstd::Dictionary::PointerT zstd_dict_ptr;
+    frame::mprpc::lz4::Dictionary::PointerT  lz4_dict_ptr;
+
+    if (choice == 'd') {
+        vector<string> samples;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            samples.emplace_back(make_record(100000 + i * 3, 64 + (i * 37) % 512));
+        }
+        const string dict = frame::mprpc::zstd::train(samples);
+        solid_check(!dict.empty(), "dictionary training failed");
+        zstd_dict_ptr = frame::mprpc::zstd::Dictionary::create(dict);
+        lz4_dict_ptr  = frame::mprpc::lz4::Dictionary::create(dict);
+    }
+
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpcserver(m);
+        frame::mprpc::ServiceT mprpcclient(m);
+        CallPoolT              cwp{{1, 100, 0}, [](const size_t) {}, [](const size_t) {}};
+        frame::aio::Resolver   resolver([&cwp](std::function<void()>&& _fnc) { cwp.pushOne(std::move(_fnc)); });
+
+        sch_client.start(1);
+        sch_server.start(1);
+
+        std::string server_port;
+
+        { // mprpc server initialization
+            auto proto = frame::mprpc::serialization_v3::create_protocol<reflection::v1::metadata::Variant, uint8_t>(
+                reflection::v1::metadata::factory,
+                [&](auto& _rmap) {
+                    _rmap.template registerMessage<Message>(1, "Message", server_complete_message);
+                });
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            switch (choice) {
+            case 'z':
+                register_counted(cfg, frame::mprpc::zstd::engine_id, frame::mprpc::zstd::Engine(64, 16, 1, nullptr), server_counters);
+                register_counted(cfg, frame::mprpc::lz4::engine_id, frame::mprpc::lz4::Engine(64, 16, 1, nullptr), server_counters);
+                register_counted(cfg, frame::mprpc::snappy::engine_id, frame::mprpc::snappy::Engine(1024, 32), server_counters);
+                break;
+            case 'd':
+                register_counted(cfg, zstd_dict_id, frame::mprpc::zstd::Engine(64, 16, 1, zstd_dict_ptr), server_counters);
+                register_counted(cfg, lz4_dict_id, frame::mprpc::lz4::Engine(64, 16, 1, lz4_dict_ptr), server_counters);
+                break;
+            case 'b':
+                register_counted(cfg, frame::mprpc::zstd::engine_id, frame::mprpc::zstd::Engine(64, 16, 1, nullptr), server_counters);
+                break;
+            default:
+                break;
+            }
+
+            cfg.server.listener_address_str   = "0.0.0.0:0";
+            cfg.server.connection_start_state = frame::mprpc::ConnectionState::Active;
+
+            {
+                frame::mprpc::ServiceStartStatus start_status;
+                mprpcserver.start(start_status, std::move(cfg));
+
+                std::ostringstream oss;
+                oss << start_status.listen_addr_vec_.back().port();
+                server_port = oss.str();
+                solid_dbg(generic_logger, Info, "server listens on: " << start_status.listen_addr_vec_.back());
+            }
+        }
+
+        { // mprpc client initialization
+            auto proto = frame::mprpc::serialization_v3::create_protocol<reflection::v1::metadata::Variant, uint8_t>(
+                reflection::v1::metadata::factory,
+                [&](auto& _rmap) {
+                    _rmap.template registerMessage<Message>(1, "Message", client_complete_message);
+                });
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            switch (choice) {
+            case 'd':
+                register_counted(cfg, lz4_dict_id, frame::mprpc::lz4::Engine(64, 16, 1, lz4_dict_ptr), client_counters);
+                register_counted(cfg, zstd_dict_id, frame::mprpc::zstd::Engine(64, 16, 1, zstd_dict_ptr), client_counters);
+                break;
+            case 'b':
+                register_counted(cfg, frame::mprpc::zstd::engine_id, frame::mprpc::zstd::Engine(64, 16, 1, nullptr), client_counters);
+                break;
+            default:
+                register_counted(cfg, frame::mprpc::lz4::engine_id, frame::mprpc::lz4::Engine(64, 16, 1, nullptr), client_counters);
+                register_counted(cfg, frame::mprpc::zstd::engine_id, frame::mprpc::zstd::Engine(64, 16, 1, nullptr), client_counters);
+                break;
+            }
+
+            cfg.client.connection_start_state = frame::mprpc::ConnectionState::Active;
+            cfg.client.name_resolve_fnc       = frame::mprpc::InternetResolverF{resolver, server_port, "127.0.0.1"};
+
+            mprpcclient.start(std::move(cfg));
+        }
+
+        frame::mprpc::RecipientId recipient_id;
+        {
+            const auto err = mprpcclient.createConnectionPool("localhost", recipient_id, [](frame::mprpc::ConnectionContext&, EventBase&&, const ErrorConditionT&) {}, 1);
+            solid_check(!err, "failed creating pool: " << err.message());
+        }
+
+        size_t total_size = 0;
+        for (size_t i = 0; i < message_count; ++i) {
+            total_size += message_size(i);
+            const auto err = mprpcclient.sendMessage(recipient_id, frame::mprpc::make_message<Message>(static_cast<uint32_t>(i), random, message_size(i)), {frame::mprpc::MessageFlagsE::AwaitResponse});
+            solid_check(!err, "send error: " << err.message());
+        }
+
+        {
+            unique_lock<mutex> lock(mtx);
+            if (!cnd.wait_for(lock, std::chrono::seconds(120), [message_count]() { return client_received_count == message_count; })) {
+                solid_throw("Process is taking too long: received " << client_received_count << " of " << message_count);
+            }
+        }
+
+        cout << "choice " << choice << " - server decompressed:";
+        for (size_t i = 0; i < std::size(server_counters.decompress_count); ++i) {
+            if (server_counters.decompress_count[i] != 0) {
+                cout << " [" << i << "] = " << server_counters.decompress_count[i];
+            }
+        }
+        cout << " client decompressed:";
+        for (size_t i = 0; i < std::size(client_counters.decompress_count); ++i) {
+            if (client_counters.decompress_count[i] != 0) {
+                cout << " [" << i << "] = " << client_counters.decompress_count[i];
+            }
+        }
+        cout << " compress attempts: server " << server_counters.compress_count[frame::mprpc::zstd::engine_id] << " client " << client_counters.compress_count[frame::mprpc::zstd::engine_id] << endl;
+
+        switch (choice) {
+        case 'z':
+            solid_check(server_counters.decompress_count[frame::mprpc::lz4::engine_id] != 0 && server_counters.decompress_count[frame::mprpc::lz4::engine_id] == server_counters.decompressed(), "server should receive lz4 packets only");
+            solid_check(client_counters.decompress_count[frame::mprpc::zstd::engine_id] != 0 && client_counters.decompress_count[frame::mprpc::zstd::engine_id] == client_counters.decompressed(), "client should receive zstd packets only");
+            break;
+        case 'd':
+            solid_check(server_counters.decompress_count[lz4_dict_id] != 0 && server_counters.decompress_count[lz4_dict_id] == server_counters.decompressed(), "server should receive lz4 dictionary packets only");
+            solid_check(client_counters.decompress_count[zstd_dict_id] != 0 && client_counters.decompress_count[zstd_dict_id] == client_counters.decompressed(), "client should receive zstd dictionary packets only");
+            break;
+        case 'n':
+            solid_check(server_counters.decompressed() == 0 && client_counters.decompressed() == 0, "nothing should be compressed");
+            break;
+        case 'b': {
+            // the server negotiates on the first packet received and sends the responses back
+            const size_t min_packet_count = total_size / frame::mprpc::Protocol::MaxPacketDataSize;
+            const size_t attempt_count    = server_counters.compress_count[frame::mprpc::zstd::engine_id];
+            solid_check(attempt_count != 0 && attempt_count < min_packet_count / 2, "compression was not bypassed: " << attempt_count << " attempts for at least " << min_packet_count << " packets");
+        } break;
+        default:
+            break;
+        }
+
+        mprpcclient.stop();
+        mprpcserver.stop();
+    }
+
+    return 0;
+}
@@ -0,0 +1,267 @@
+#include "solid/frame/mprpc/mprpcsocketstub_openssl.hpp"
+
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v3.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/utility/threadpool.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#ifdef SOLID_ON_LINUX
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+namespace {
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor<frame::mprpc::EventT>>;
+using CallPoolT     = ThreadPool<Function<void()>, Function<void()>>;
+
+struct Message : frame::mprpc::Message {
+    uint32_t    idx = 0;
+    std::string str;
+
+    Message() = default;
+
+    Message(uint32_t _idx, const size_t _size)
+        : idx(_idx)
+    {
+        str.resize(_size);
+        for (size_t i = 0; i < _size; ++i) {
+            str[i] = static_cast<char>('a' + (i + _idx) % 26);
+        }
+    }
+
+    bool check() const
+    {
+        for (size_t i = 0; i < str.size(); ++i) {
+            if (str[i] != static_cast<char>('a' + (i + idx) % 26)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    SOLID_REFLECT_V1(_rr, _rthis, _rctx)
+    {
+        _rr.add(_rthis.idx, _rctx, 0, "idx").add(_rthis.str, _rctx, 1, "str");
+    }
+};
+
+using MessagePointerT = solid::frame::mprpc::MessagePointerT<Message>;
+
+mutex              mtx;
+condition_variable cnd;
+size_t             server_received_count = 0;
+size_t             client_complete_count = 0;
+size_t             expected_count        = 0;
+atomic<bool>       server_kernel_tls{false};
+atomic<bool>       client_kernel_tls{false};
+
+// the kernel tls upper layer protocol was attached on the connection's socket
+bool is_kernel_tls(frame::mprpc::ConnectionContext& _rctx)
+{
+#if defined(SOLID_ON_LINUX) && defined(TCP_ULP)
+    char      name[16] = {0};
+    socklen_t len      = sizeof(name) - 1;
+    if (::getsockopt(_rctx.device().descriptor(), IPPROTO_TCP, TCP_ULP, name, &len) == 0) {
+        return strcmp(name, "tls") == 0;
+    }
+#endif
+    return false;
+}
+
+void server_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "error: " << _rerror.message());
+    if (_rrecv_msg_ptr) {
+        solid_check(_rrecv_msg_ptr->check(), "message " << _rrecv_msg_ptr->idx << " corrupted");
+        server_kernel_tls = is_kernel_tls(_rctx);
+        lock_guard<mutex> lock(mtx);
+        ++server_received_count;
+        if (server_received_count == expected_count) {
+            cnd.notify_one();
+        }
+    }
+}
+
+void client_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "error: " << _rerror.message());
+    solid_check(_rsent_msg_ptr && !_rrecv_msg_ptr);
+    client_kernel_tls = is_kernel_tls(_rctx);
+    lock_guard<mutex> lock(mtx);
+    ++client_complete_count;
+    if (client_complete_count == expected_count) {
+        cnd.notify_one();
+    }
+}
+
+} // namespace
+
+// Streams messages over a TLS loopback connection, with the record encryption
+// done by OpenSSL ('u') or, when both the library and the kernel support it,
+// offloaded to the kernel ('k'). Without kernel support the 'k' run falls back
+// on OpenSSL and must behave exactly like the 'u' one.
+int test_clientserver_ktls(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWX"});
+
+    bool   kernel_tls    = true;
+    size_t message_count = 200;
+    size_t message_size  = 64 * 1024;
+
+    if (argc > 1) {
+        kernel_tls = *argv[1] == 'k';
+    }
+    if (argc > 2) {
+        message_count = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        message_size = atoi(argv[3]);
+    }
+
+    expected_count = message_count;
+
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpcserver(m);
+        frame::mprpc::ServiceT mprpcclient(m);
+        CallPoolT              cwp{{1, 100, 0}, [](const size_t) {}, [](const size_t) {}};
+        frame::aio::Resolver   resolver([&cwp](std::function<void()>&& _fnc) { cwp.pushOne(std::move(_fnc)); });
+
+        sch_client.start(1);
+        sch_server.start(1);
+
+        std::string server_port;
+
+        { // mprpc server initialization
+            auto proto = frame::mprpc::serialization_v3::create_protocol<reflection::v1::metadata::Variant, uint8_t>(
+                reflection::v1::metadata::factory,
+                [&](auto& _rmap) {
+                    _rmap.template registerMessage<Message>(1, "Message", server_complete_message);
+                });
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            cfg.server.listener_address_str   = "0.0.0.0:0";
+            cfg.server.connection_start_state = frame::mprpc::ConnectionState::Active;
+
+            frame::mprpc::openssl::setup_server(
+                cfg,
+                [kernel_tls](frame::aio::openssl::Context& _rctx) -> ErrorCodeT {
+                    _rctx.loadVerifyFile("echo-ca-cert.pem");
+                    _rctx.loadCertificateFile("echo-server-cert.pem");
+                    _rctx.loadPrivateKeyFile("echo-server-key.pem");
+                    if (kernel_tls) {
+                        if (const auto err = _rctx.enableKernelTls()) {
+                            solid_log(generic_logger, Warning, "kernel tls not available: " << err.message());
+                        }
+                    }
+                    return ErrorCodeT();
+                },
+                frame::mprpc::openssl::NameCheckSecureStart{"echo-client"});
+
+            {
+                frame::mprpc::ServiceStartStatus start_status;
+                mprpcserver.start(start_status, std::move(cfg));
+
+                std::ostringstream oss;
+                oss << start_status.listen_addr_vec_.back().port();
+                server_port = oss.str();
+                solid_dbg(generic_logger, Info, "server listens on: " << start_status.listen_addr_vec_.back());
+            }
+        }
+
+        { // mprpc client initialization
+            auto proto = frame::mprpc::serialization_v3::create_protocol<reflection::v1::metadata::Variant, uint8_t>(
+                reflection::v1::metadata::factory,
+                [&](auto& _rmap) {
+                    _rmap.template registerMessage<Message>(1, "Message", client_complete_message);
+                });
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            cfg.pool_max_message_queue_size   = message_count;
+            cfg.client.connection_start_state = frame::mprpc::ConnectionState::Active;
+            cfg.client.name_resolve_fnc       = frame::mprpc::InternetResolverF{resolver, server_port, "127.0.0.1"};
+
+            frame::mprpc::openssl::setup_client(
+                cfg,
+                [kernel_tls](frame::aio::openssl::Context& _rctx) -> ErrorCodeT {
+                    _rctx.loadVerifyFile("echo-ca-cert.pem");
+                    _rctx.loadCertificateFile("echo-client-cert.pem");
+                    _rctx.loadPrivateKeyFile("echo-client-key.pem");
+                    if (kernel_tls) {
+                        if (const auto err = _rctx.enableKernelTls()) {
+                            solid_log(generic_logger, Warning, "kernel tls not available: " << err.message());
+                        }
+                    }
+                    return ErrorCodeT();
+                },
+                frame::mprpc::openssl::NameCheckSecureStart{"echo-server"});
+
+            mprpcclient.start(std::move(cfg));
+        }
+
+        const auto start_time = chrono::steady_clock::now();
+
+        for (size_t i = 0; i < message_count; ++i) {
+            const auto err = mprpcclient.sendMessage({"localhost"}, frame::mprpc::make_message<Message>(static_cast<uint32_t>(i), message_size));
+            solid_check(!err, "send error: " << err.message());
+        }
+
+        {
+            unique_lock<mutex> lock(mtx);
+
+            if (!cnd.wait_for(lock, std::chrono::seconds(120), []() { return server_received_count == expected_count && client_complete_count == expected_count; })) {
+                solid_throw("Process is taking too long: received " << server_received_count << " completed " << client_complete_count << " of " << expected_count);
+            }
+        }
+
+        const auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time);
+
+        if (!kernel_tls) {
+            solid_check(!server_kernel_tls && !client_kernel_tls, "kernel tls used though not enabled");
+        }
+
+        mprpcclient.stop();
+        mprpcserver.stop();
+
+        cout << (kernel_tls ? "kernel tls requested" : "openssl tls") << ": server " << (server_kernel_tls ? "kernel" : "openssl") << " client " << (client_kernel_tls ? "kernel" : "openssl") << endl;
+        cout << message_count << " messages of " << message_size << " bytes: " << duration.count() << "us - " << (message_count * message_size / (duration.count() + 1)) << "MB/s" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,228 @@
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v3.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/utility/threadpool.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+namespace {
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor<frame::mprpc::EventT>>;
+using CallPoolT     = ThreadPool<Function<void()>, Function<void()>>;
+
+struct Message : frame::mprpc::Message {
+    uint32_t    idx = 0;
+    std::string str;
+
+    Message() = default;
+
+    Message(uint32_t _idx, const size_t _size)
+        : idx(_idx)
+        , str(_size, static_cast<char>('a' + _idx % 26))
+    {
+    }
+
+    SOLID_REFLECT_V1(_rr, _rthis, _rctx)
+    {
+        _rr.add(_rthis.idx, _rctx, 0, "idx").add(_rthis.str, _rctx, 1, "str");
+    }
+};
+
+using MessagePointerT = solid::frame::mprpc::MessagePointerT<Message>;
+
+mutex              mtx;
+condition_variable cnd;
+size_t             server_received_count = 0;
+size_t             expected_count        = 0;
+atomic<size_t>     server_allocate_count{0};
+atomic<size_t>     server_max_capacity{0};
+
+void server_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "error: " << _rerror.message());
+    if (_rrecv_msg_ptr) {
+        solid_check(_rrecv_msg_ptr->str.empty() || _rrecv_msg_ptr->str.back() == static_cast<char>('a' + _rrecv_msg_ptr->idx % 26));
+        lock_guard<mutex> lock(mtx);
+        ++server_received_count;
+        if (server_received_count == expected_count) {
+            cnd.notify_one();
+        }
+    }
+}
+
+void client_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "error: " << _rerror.message());
+}
+
+void wait_received(const size_t _count)
+{
+    unique_lock<mutex> lock(mtx);
+    expected_count = _count;
+    if (!cnd.wait_for(lock, std::chrono::seconds(120), []() { return server_received_count == expected_count; })) {
+        solid_throw("Process is taking too long: received " << server_received_count << " of " << expected_count);
+    }
+}
+
+} // namespace
+
+// Sends big messages to a server using either the adaptive receive buffer policy (a)
+// or a fixed, start capacity, receive buffer (s).
+// Then checks that the server's connection releases its receive buffer when idle.
+int test_clientserver_recv_buffer(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWX"});
+
+    char   choice        = 'a';
+    size_t message_count = 64;
+    size_t message_size  = 4 * 1024 * 1024;
+
+    if (argc > 1) {
+        choice = *argv[1];
+    }
+    if (argc > 2) {
+        message_count = atoi(argv[2]);
+    }
+
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpcserver(m);
+        frame::mprpc::ServiceT mprpcclient(m);
+        CallPoolT              cwp{{1, 100, 0}, [](const size_t) {}, [](const size_t) {}};
+        frame::aio::Resolver   resolver([&cwp](std::function<void()>&& _fnc) { cwp.pushOne(std::move(_fnc)); });
+
+        sch_client.start(1);
+        sch_server.start(1);
+
+        std::string server_port;
+
+        { // mprpc server initialization
+            auto proto = frame::mprpc::serialization_v3::create_protocol<reflection::v1::metadata::Variant, uint8_t>(
+                reflection::v1::metadata::factory,
+                [&](auto& _rmap) {
+                    _rmap.template registerMessage<Message>(1, "Message", server_complete_message);
+                });
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            auto policy_ptr                  = std::make_shared<frame::mprpc::AdaptiveRecvBufferPolicy>();
+            policy_ptr->idle_release_timeout = std::chrono::milliseconds(200);
+            cfg.connection_recv_buffer_start_capacity_kb = 64; // must fit the client's packets
+            if (choice == 'a') {
+                policy_ptr->read_budget                    = 4 * 1024 * 1024;
+                cfg.connection_recv_buffer_max_capacity_kb = 4 * 1024;
+            }
+            cfg.connection_recv_buffer_policy_ptr        = policy_ptr;
+            cfg.connection_recv_buffer_allocate_fnc      = [](const uint32_t _cp) {
+                ++server_allocate_count;
+                store_max(server_max_capacity, static_cast<size_t>(_cp));
+                return BufferManager::make(_cp);
+            };
+
+            cfg.server.listener_address_str   = "0.0.0.0:0";
+            cfg.server.connection_start_state = frame::mprpc::ConnectionState::Active;
+
+            {
+                frame::mprpc::ServiceStartStatus start_status;
+                mprpcserver.start(start_status, std::move(cfg));
+
+                std::ostringstream oss;
+                oss << start_status.listen_addr_vec_.back().port();
+                server_port = oss.str();
+                solid_dbg(generic_logger, Info, "server listens on: " << start_status.listen_addr_vec_.back());
+            }
+        }
+
+        { // mprpc client initialization
+            auto proto = frame::mprpc::serialization_v3::create_protocol<reflection::v1::metadata::Variant, uint8_t>(
+                reflection::v1::metadata::factory,
+                [&](auto& _rmap) {
+                    _rmap.template registerMessage<Message>(1, "Message", client_complete_message);
+                });
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            cfg.connection_send_buffer_start_capacity_kb = 64;
+            cfg.client.connection_start_state            = frame::mprpc::ConnectionState::Active;
+            cfg.client.name_resolve_fnc                  = frame::mprpc::InternetResolverF{resolver, server_port, "127.0.0.1"};
+
+            mprpcclient.start(std::move(cfg));
+        }
+
+        frame::mprpc::RecipientId recipient_id;
+        {
+            const auto err = mprpcclient.createConnectionPool("localhost", recipient_id, [](frame::mprpc::ConnectionContext&, EventBase&&, const ErrorConditionT&) {}, 1);
+            solid_check(!err, "failed creating pool: " << err.message());
+        }
+
+        const auto start_time = chrono::steady_clock::now();
+
+        for (size_t i = 0; i < message_count; ++i) {
+            const auto err = mprpcclient.sendMessage(recipient_id, frame::mprpc::make_message<Message>(static_cast<uint32_t>(i), message_size));
+            solid_check(!err, "send error: " << err.message());
+        }
+
+        wait_received(message_count);
+
+        const auto total_duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time);
+        const auto total_size     = message_count * message_size;
+
+        cout << (choice == 's' ? "static" : "adaptive") << " recv buffer: " << total_size << " bytes in " << total_duration.count() << "us - " << (total_size / (total_duration.count() + 1.0)) << " MB/s";
+        cout << " max recv buffer capacity: " << server_max_capacity << " allocations: " << server_allocate_count << endl;
+
+        if (choice == 's') {
+            solid_check(server_max_capacity <= 64 * 1024);
+        } else {
+            solid_check(server_max_capacity > 64 * 1024, "the recv buffer did not grow");
+        }
+
+        // the server connection releases its recv buffer after 200ms without data
+        // and allocates a new one on the next message
+        this_thread::sleep_for(chrono::milliseconds(1000));
+        const size_t idle_allocate_count = server_allocate_count;
+
+        {
+            const auto err = mprpcclient.sendMessage(recipient_id, frame::mprpc::make_message<Message>(static_cast<uint32_t>(message_count), 100));
+            solid_check(!err, "send error: " << err.message());
+        }
+        wait_received(message_count + 1);
+
+        solid_check(server_allocate_count > idle_allocate_count, "the idle recv buffer was not released");
+
+        mprpcclient.stop();
+        mprpcserver.stop();
+
+        solid_log(generic_logger, Statistic, "mprpcserver statistic: " << mprpcserver.statistic());
+    }
+
+    return 0;
+}
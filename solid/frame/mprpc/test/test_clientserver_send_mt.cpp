@@ -0,0 +1,237 @@
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v3.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/utility/threadpool.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+namespace {
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor<frame::mprpc::EventT>>;
+using CallPoolT     = ThreadPool<Function<void()>, Function<void()>>;
+
+struct Message : frame::mprpc::Message {
+    uint32_t    idx = 0;
+    std::string str;
+
+    Message() = default;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+        , str("small message payload")
+    {
+    }
+
+    SOLID_REFLECT_V1(_rr, _rthis, _rctx)
+    {
+        _rr.add(_rthis.idx, _rctx, 0, "idx").add(_rthis.str, _rctx, 1, "str");
+    }
+};
+
+using MessagePointerT = solid::frame::mprpc::MessagePointerT<Message>;
+
+mutex              mtx;
+condition_variable cnd;
+atomic<size_t>     server_received_count{0};
+atomic<size_t>     client_complete_count{0};
+size_t             expected_count = 0;
+
+void server_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "error: " << _rerror.message());
+    if (_rrecv_msg_ptr && server_received_count.fetch_add(1) + 1 == expected_count) {
+        lock_guard<mutex> lock(mtx);
+        cnd.notify_one();
+    }
+}
+
+void client_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    MessagePointerT& _rsent_msg_ptr, MessagePointerT& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "error: " << _rerror.message());
+    solid_check(_rsent_msg_ptr && !_rrecv_msg_ptr);
+    if (client_complete_count.fetch_add(1) + 1 == expected_count) {
+        lock_guard<mutex> lock(mtx);
+        cnd.notify_one();
+    }
+}
+
+} // namespace
+
+// Many threads calling sendMessage for the same recipient, addressed either
+// by name - the default - or by RecipientId ('i').
+// Measures the time the threads spend enqueueing and checks that, once
+// the pool exists, the sends by name do not resolve the name under the service mutex.
+int test_clientserver_send_mt(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWX"});
+
+    size_t thread_count         = 4;
+    size_t thread_message_count = 10000;
+    bool   by_name              = true;
+
+    if (argc > 1) {
+        thread_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        thread_message_count = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        by_name = *argv[3] != 'i';
+    }
+
+    expected_count = thread_count * thread_message_count;
+
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpcserver(m);
+        frame::mprpc::ServiceT mprpcclient(m);
+        CallPoolT              cwp{{1, 100, 0}, [](const size_t) {}, [](const size_t) {}};
+        frame::aio::Resolver   resolver([&cwp](std::function<void()>&& _fnc) { cwp.pushOne(std::move(_fnc)); });
+
+        sch_client.start(1);
+        sch_server.start(1);
+
+        std::string server_port;
+
+        { // mprpc server initialization
+            auto proto = frame::mprpc::serialization_v3::create_protocol<reflection::v1::metadata::Variant, uint8_t>(
+                reflection::v1::metadata::factory,
+                [&](auto& _rmap) {
+                    _rmap.template registerMessage<Message>(1, "Message", server_complete_message);
+                });
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            cfg.server.listener_address_str   = "0.0.0.0:0";
+            cfg.server.connection_start_state = frame::mprpc::ConnectionState::Active;
+
+            {
+                frame::mprpc::ServiceStartStatus start_status;
+                mprpcserver.start(start_status, std::move(cfg));
+
+                std::ostringstream oss;
+                oss << start_status.listen_addr_vec_.back().port();
+                server_port = oss.str();
+                solid_dbg(generic_logger, Info, "server listens on: " << start_status.listen_addr_vec_.back());
+            }
+        }
+
+        { // mprpc client initialization
+            auto proto = frame::mprpc::serialization_v3::create_protocol<reflection::v1::metadata::Variant, uint8_t>(
+                reflection::v1::metadata::factory,
+                [&](auto& _rmap) {
+                    _rmap.template registerMessage<Message>(1, "Message", client_complete_message);
+                });
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            cfg.pool_max_message_queue_size   = expected_count;
+            cfg.client.connection_start_state = frame::mprpc::ConnectionState::Active;
+            cfg.client.name_resolve_fnc       = frame::mprpc::InternetResolverF{resolver, server_port, "127.0.0.1"};
+
+            mprpcclient.start(std::move(cfg));
+        }
+
+        frame::mprpc::RecipientId recipient_id;
+        {
+            const auto err = mprpcclient.createConnectionPool("localhost", recipient_id, [](frame::mprpc::ConnectionContext&, EventBase&&, const ErrorConditionT&) {}, 1);
+            solid_check(!err, "failed creating pool: " << err.message());
+        }
+
+#ifdef SOLID_HAS_STATISTICS
+        const uint64_t initial_lookup_count = mprpcclient.statistic().send_message_name_lookup_count_;
+#endif
+
+        atomic<size_t>      ready_count{0};
+        atomic<bool>        go{false};
+        atomic<uint64_t>    enqueue_ns{0};
+        vector<std::thread> thread_vec;
+        const auto          start_time = chrono::steady_clock::now();
+
+        for (size_t t = 0; t < thread_count; ++t) {
+            thread_vec.emplace_back(
+                [&, t]() {
+                    ++ready_count;
+                    while (!go) {
+                        this_thread::yield();
+                    }
+                    const auto thread_start_time = chrono::steady_clock::now();
+                    for (size_t i = 0; i < thread_message_count; ++i) {
+                        const auto idx = static_cast<uint32_t>(t * thread_message_count + i);
+                        const auto err = by_name
+                            ? mprpcclient.sendMessage({"localhost"}, frame::mprpc::make_message<Message>(idx))
+                            : mprpcclient.sendMessage(recipient_id, frame::mprpc::make_message<Message>(idx));
+                        solid_check(!err, "send error: " << err.message());
+                    }
+                    enqueue_ns += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - thread_start_time).count();
+                });
+        }
+
+        while (ready_count != thread_count) {
+            this_thread::yield();
+        }
+        go = true;
+
+        for (auto& thr : thread_vec) {
+            thr.join();
+        }
+
+        const auto enqueue_duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time);
+
+        {
+            unique_lock<mutex> lock(mtx);
+
+            if (!cnd.wait_for(lock, std::chrono::seconds(120), []() { return server_received_count == expected_count && client_complete_count == expected_count; })) {
+                solid_throw("Process is taking too long: received " << server_received_count << " completed " << client_complete_count << " of " << expected_count);
+            }
+        }
+
+        const auto total_duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time);
+
+#ifdef SOLID_HAS_STATISTICS
+        if (by_name) {
+            solid_check(mprpcclient.statistic().send_message_name_lookup_count_ == initial_lookup_count, "sends by name took the locked lookup");
+        }
+#endif
+
+        mprpcclient.stop();
+        mprpcserver.stop();
+
+        cout << thread_count << " threads sending " << thread_message_count << " messages each, by " << (by_name ? "name" : "recipient id") << endl;
+        cout << "enqueue: " << enqueue_duration.count() << "us - " << (enqueue_ns / expected_count) << "ns/msg per thread" << endl;
+        cout << "delivered: " << total_duration.count() << "us - " << (expected_count * 1000000.0 / total_duration.count()) << " msg/s" << endl;
+
+        solid_log(generic_logger, Statistic, "mprpcclient statistic: " << mprpcclient.statistic());
+    }
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include "solid/frame/mprpc/mprpccompression_lz4.hpp"
+#include "solid/frame/mprpc/mprpccompression_snappy.hpp"
+#include "solid/frame/mprpc/mprpccompression_zstd.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+namespace {
+
+const char* actions[] = {"login", "logout", "read", "write"};
+
+// small repetitive json like records - the kind of messages dictionaries are for
+string make_record(uint32_t _idx, const size_t _size)
+{
+    string s;
+    while (s.size() < _size) {
+        s += "{\"id\":" + to_string((_idx * 7919) % 100000) + ",\"user\":\"user" + to_string(_idx % 97) + "\",\"action\":\"" + actions[_idx % 4] + "\",\"status\":\"ok\",\"ts\":" + to_string(1700000000 + _idx * 13) + "}";
+        ++_idx;
+    }
+    s.resize(_size);
+    return s;
+}
+
+// packets as MessageWriter fills them: a single small message, a few messages or a full packet
+vector<string> make_corpus(const size_t _count, const size_t _min_size, const size_t _max_size)
+{
+    vector<string> corpus;
+    uint32_t       idx = 0;
+    for (size_t i = 0; i < _count; ++i) {
+        const size_t size = _min_size + (i * 977) % (_max_size - _min_size + 1);
+        corpus.emplace_back(make_record(idx, size));
+        idx += static_cast<uint32_t>(size / 64);
+    }
+    return corpus;
+}
+
+struct Result {
+    size_t              input_size  = 0;
+    size_t              output_size = 0;
+    chrono::nanoseconds compress_duration{0};
+    chrono::nanoseconds decompress_duration{0};
+};
+
+template <class Engine>
+Result run(Engine& _engine, const vector<string>& _corpus, const size_t _repeat_count)
+{
+    Result       result;
+    vector<char> iobuf(frame::mprpc::Protocol::MaxPacketDataSize);
+    vector<char> outbuf(frame::mprpc::Protocol::MaxPacketDataSize);
+
+    for (size_t r = 0; r < _repeat_count; ++r) {
+        for (const auto& packet : _corpus) {
+            ErrorConditionT error;
+            memcpy(iobuf.data(), packet.data(), packet.size());
+
+            auto         start = chrono::steady_clock::now();
+            const size_t len   = _engine(iobuf.data(), packet.size(), error);
+            result.compress_duration += chrono::steady_clock::now() - start;
+            solid_check(!error, "compression error: " << error.message());
+
+            result.input_size += packet.size();
+            if (len == 0) { // not worth compressing - sent as is
+                result.output_size += packet.size();
+                continue;
+            }
+            result.output_size += len;
+
+            start                = chrono::steady_clock::now();
+            const size_t out_len = _engine(outbuf.data(), iobuf.data(), len, error);
+            result.decompress_duration += chrono::steady_clock::now() - start;
+
+            solid_check(!error && out_len == packet.size() && memcmp(outbuf.data(), packet.data(), out_len) == 0, "decompression mismatch: " << error.message());
+        }
+    }
+    return result;
+}
+
+void print(const char* _name, const char* _corpus_name, const Result& _result)
+{
+    const auto mbps = [&_result](const chrono::nanoseconds _duration) {
+        return _result.input_size * 1000.0 / (_duration.count() + 1);
+    };
+    cout << setw(10) << left << _name << setw(8) << _corpus_name << right
+         << " ratio: " << setw(6) << fixed << setprecision(3) << (static_cast<double>(_result.output_size) / _result.input_size)
+         << " compress: " << setw(8) << setprecision(1) << mbps(_result.compress_duration) << " MB/s"
+         << " decompress: " << setw(8) << mbps(_result.decompress_duration) << " MB/s" << endl;
+}
+
+} // namespace
+
+// Compares the compression engines, with and without a trained dictionary, on a corpus of mprpc like packets.
+int test_compression_corpus(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWX"});
+
+    size_t packet_count = 2000;
+    size_t repeat_count = 4;
+
+    if (argc > 1) {
+        packet_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        repeat_count = atoi(argv[2]);
+    }
+
+    const vector<string> small_corpus  = make_corpus(packet_count, 64, 512);
+    const vector<string> medium_corpus = make_corpus(packet_count / 4, 1024, 8 * 1024);
+    const vector<string> full_corpus   = make_corpus(packet_count / 32, frame::mprpc::Protocol::MaxPacketDataSize, frame::mprpc::Protocol::MaxPacketDataSize);
+
+    vector<string> samples;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        samples.emplace_back(make_record(1000000 + i * 3, 64 + (i * 37) % 512));
+    }
+    const string dict = frame::mprpc::zstd::train(samples);
+    solid_check(!dict.empty(), "dictionary training failed");
+
+    // zero thresholds: every packet is compressed
+    frame::mprpc::snappy::Engine snappy_engine(0, 0);
+    frame::mprpc::lz4::Engine    lz4_engine(0, 0, 1, nullptr);
+    frame::mprpc::lz4::Engine    lz4_dict_engine(0, 0, 1, frame::mprpc::lz4::Dictionary::create(dict));
+    frame::mprpc::zstd::Engine   zstd_engine(0, 0, 1, nullptr);
+    frame::mprpc::zstd::Engine   zstd_dict_engine(0, 0, 1, frame::mprpc::zstd::Dictionary::create(dict));
+
+    cout << "dictionary of " << dict.size() << " bytes" << endl;
+
+    const auto run_all = [&](const char* _corpus_name, const vector<string>& _corpus) {
+        const Result snappy_result    = run(snappy_engine, _corpus, repeat_count);
+        const Result lz4_result       = run(lz4_engine, _corpus, repeat_count);
+        const Result lz4_dict_result  = run(lz4_dict_engine, _corpus, repeat_count);
+        const Result zstd_result      = run(zstd_engine, _corpus, repeat_count);
+        const Result zstd_dict_result = run(zstd_dict_engine, _corpus, repeat_count);
+
+        print("snappy", _corpus_name, snappy_result);
+        print("lz4", _corpus_name, lz4_result);
+        print("lz4+dict", _corpus_name, lz4_dict_result);
+        print("zstd", _corpus_name, zstd_result);
+        print("zstd+dict", _corpus_name, zstd_dict_result);
+
+        return std::make_pair(lz4_dict_result.output_size < lz4_result.output_size, zstd_dict_result.output_size < zstd_result.output_size);
+    };
+
+    const auto small_dict_helps = run_all("small", small_corpus);
+    run_all("medium", medium_corpus);
+    run_all("full", full_corpus);
+
+    // dictionaries are for small messages
+    solid_check(small_dict_helps.first, "the dictionary did not help lz4 on small packets");
+    solid_check(small_dict_helps.second, "the dictionary did not help zstd on small packets");
+    return 0;
+}
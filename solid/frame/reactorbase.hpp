@@ -11,10 +11,12 @@
 #pragma once
 #include <atomic>
 #include <memory>
+#include <vector>
 #if !defined(__cpp_lib_atomic_wait)
 #include "solid/utility/atomic_wait"
 #endif
 #include "solid/frame/actorbase.hpp"
+#include "solid/frame/schedulerbase.hpp"
 #include "solid/system/statistic.hpp"
 #include "solid/utility/stack.hpp"
 
@@ -118,6 +120,9 @@ public:
     virtual bool wake(UniqueId const& _ractuid, EventBase&& _ue)      = 0;
     virtual void stop()                                               = 0;
 
+    //! Wake every actor in _ruid_vec with a copy of _re - one by one unless the reactor batches them
+    virtual void wakeAll(std::vector<UniqueId>&& _ruid_vec, EventBase const& _re);
+
     bool   prepareThread(const bool _success);
     void   unprepareThread();
     size_t load() const;
@@ -134,6 +139,7 @@ protected:
     }
 
     void           stopActor(ActorBase& _ract, Manager& _rm);
+    bool           moveActor(ActorBase& _ract, Manager& _rm, ReactorBase& _rreactor, ScheduleFunctionT& _rfct);
     SchedulerBase& scheduler();
     UniqueId       popUid(ActorBase& _ract);
     void           pushUid(UniqueId const& _ruid);
@@ -68,8 +68,9 @@ private:
     struct Worker {
         static void run(SchedulerBase* _psched, const size_t _idx, const size_t _wake_capacity)
         {
-            auto& rthis       = *static_cast<ThisT*>(_psched);
-            auto  reactor_ptr = std::make_shared<ReactorT>(*_psched, rthis.statistic_.reactorStatistic(_idx), _idx, _wake_capacity);
+            auto& rthis = *static_cast<ThisT*>(_psched);
+            rthis.doPlaceThread(_idx); // before creating the reactor so its memory is NUMA local
+            auto reactor_ptr = std::make_shared<ReactorT>(*_psched, rthis.statistic_.reactorStatistic(_idx), _idx, _wake_capacity);
 
             if (!reactor_ptr->prepareThread(reactor_ptr->start())) {
                 return;
@@ -139,6 +140,32 @@ public:
         SchedulerBase::doStart(Worker::create, enf, exf, _reactorcnt, _wake_capacity);
     }
 
+    //! Start a reactor per placement entry, pinned as given
+    void start(SchedulerPlacement _placement, const size_t _wake_capacity = default_reactor_wake_capacity)
+    {
+        ThreadEnterFunctionT enf;
+        ThreadExitFunctionT  exf;
+        const size_t         reactorcnt = _placement.size();
+        statistic_.resize(reactorcnt);
+        statistic_.clear();
+        SchedulerBase::doStart(Worker::create, enf, exf, reactorcnt, _wake_capacity, std::move(_placement));
+    }
+
+    template <class EnterFct, class ExitFct>
+    std::enable_if_t<
+        std::conjunction_v<
+            std::is_invocable_r<bool, EnterFct>,
+            std::is_invocable<ExitFct>>>
+    start(SchedulerPlacement _placement, EnterFct _enf, ExitFct _exf, const size_t _wake_capacity = default_reactor_wake_capacity)
+    {
+        ThreadEnterFunctionT enf(std::move(_enf));
+        ThreadExitFunctionT  exf(std::move(_exf));
+        const size_t         reactorcnt = _placement.size();
+        statistic_.resize(reactorcnt);
+        statistic_.clear();
+        SchedulerBase::doStart(Worker::create, enf, exf, reactorcnt, _wake_capacity, std::move(_placement));
+    }
+
     StatisticT& statistic()
     {
         return statistic_;
@@ -154,11 +181,48 @@ public:
         return SchedulerBase::workerCount();
     }
 
+    //! The NUMA node of the reactor or -1 if the scheduler was started without a placement
+    int workerNumaNode(const size_t _worker_index) const
+    {
+        return SchedulerBase::workerNumaNode(_worker_index);
+    }
+
     void stop(const bool _wait = true)
     {
         SchedulerBase::doStop(_wait);
     }
 
+    //! Move a running actor onto reactor _worker_index
+    /*!
+        Asynchronous - the actor is moved, between its callbacks, only if it
+        allows it (aio::Actor::migratable) and the reactor supports it.
+        The ActorIdT stays the same.
+        Only for reactors providing migrate_event (aio).
+    */
+    bool migrateActor(Manager& _rmanager, ActorIdT const& _ractor_id, const size_t _worker_index)
+    {
+        auto reactor_ptr = SchedulerBase::workerReactor(_worker_index);
+        if (reactor_ptr) {
+            return _rmanager.notify(_ractor_id, ReactorT::migrate_event(std::move(reactor_ptr)));
+        }
+        return false;
+    }
+
+    //! Move the busiest movable actors of reactor _from_index, worth at most _load_fraction of its load, onto reactor _to_index
+    /*!
+        Only for reactors providing rebalance (aio) - see aio::Rebalancer.
+    */
+    bool rebalanceWorkers(const size_t _from_index, const size_t _to_index, const double _load_fraction, const size_t _max_actor_count = 1)
+    {
+        auto from_reactor_ptr = SchedulerBase::workerReactor(_from_index);
+        auto to_reactor_ptr   = SchedulerBase::workerReactor(_to_index);
+        if (from_reactor_ptr && to_reactor_ptr && from_reactor_ptr != to_reactor_ptr) {
+            static_cast<ReactorT&>(*from_reactor_ptr).rebalance(std::move(to_reactor_ptr), _load_fraction, _max_actor_count);
+            return true;
+        }
+        return false;
+    }
+
     ActorIdT startActor(
         ActorPointerT&& _ractptr, Service& _rsvc,
         EventBase&& _revt, ErrorConditionT& _rerr)
@@ -180,6 +244,22 @@ public:
 
         return doStartActor(ractor, _rsvc, _worker_index, fct, _rerr);
     }
+
+    //! Start the actor on a reactor local to _cpu - e.g. the cpu handling the NIC queue of a socket
+    /*!
+        Prefers a reactor pinned on _cpu, then one on the NUMA node of _cpu.
+        Without a placement it is the same as startActor.
+    */
+    ActorIdT startActorNearCpu(
+        ActorPointerT&& _ractptr, Service& _rsvc, const int _cpu,
+        EventBase&& _revt, ErrorConditionT& _rerr)
+    {
+        auto&             ractor = *_ractptr;
+        ScheduleCommand   cmd(std::move(_ractptr), _rsvc, std::move(_revt));
+        ScheduleFunctionT fct([&cmd](ReactorBase& _rreactor) { return cmd(_rreactor); });
+
+        return doStartActorNearCpu(ractor, _rsvc, _cpu, fct, _rerr);
+    }
 };
 
 template <class Actr, class Schd, class Srvc, class... P>
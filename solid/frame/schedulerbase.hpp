@@ -11,10 +11,13 @@
 #pragma once
 
 #include "solid/frame/common.hpp"
+#include "solid/system/cpu.hpp"
 #include "solid/system/error.hpp"
 #include "solid/system/pimpl.hpp"
 #include "solid/utility/function.hpp"
+#include <memory>
 #include <thread>
+#include <vector>
 
 namespace solid {
 
@@ -27,6 +30,31 @@ class ActorBase;
 // typedef FunctorReference<bool, ReactorBase&>  ScheduleFunctorT;
 typedef solid_function_t(bool(ReactorBase&)) ScheduleFunctionT;
 
+//! Where the reactor threads of a Scheduler run
+/*!
+    Reactor i is pinned on reactor_cpu_vec[i] and belongs to the NUMA node of those cpus.
+    The reactor is created on its thread after pinning, so the memory it owns
+    is first touched, thus allocated, on its NUMA node.
+*/
+struct SchedulerPlacement {
+    std::vector<CpuVectorT> reactor_cpu_vec;
+
+    bool empty() const
+    {
+        return reactor_cpu_vec.empty();
+    }
+
+    size_t size() const
+    {
+        return reactor_cpu_vec.size();
+    }
+
+    //! A reactor per cpu, pinned on that cpu
+    static SchedulerPlacement cpus(const CpuVectorT& _cpu_vec);
+    //! _reactor_count reactors grouped by NUMA node - consecutive reactors on the same node, each pinned on a cpu of its node
+    static SchedulerPlacement numa(size_t _reactor_count = 0);
+};
+
 //! A base class for all schedulers
 class SchedulerBase : NonCopyable {
     struct Data;
@@ -42,14 +70,22 @@ protected:
         CreateWorkerF         _pf,
         ThreadEnterFunctionT& _renf,
         ThreadExitFunctionT&  _rexf,
-        size_t _reactorcnt, const size_t _wake_capacity);
+        size_t _reactorcnt, const size_t _wake_capacity,
+        SchedulerPlacement&& _uplacement = SchedulerPlacement());
 
     void doStop(const bool _wait = true);
 
     ActorIdT doStartActor(ActorBase& _ract, Service& _rsvc, ScheduleFunctionT& _rfct, ErrorConditionT& _rerr);
     ActorIdT doStartActor(ActorBase& _ract, Service& _rsvc, const size_t _workerIndex, ScheduleFunctionT& _rfct, ErrorConditionT& _rerr);
+    ActorIdT doStartActorNearCpu(ActorBase& _ract, Service& _rsvc, const int _cpu, ScheduleFunctionT& _rfct, ErrorConditionT& _rerr);
 
     size_t workerCount() const;
+    int    workerNumaNode(const size_t _workerIndex) const;
+    size_t workerIndexNearCpu(const int _cpu);
+    //! The reactor of a running worker or empty
+    std::shared_ptr<ReactorBase> workerReactor(const size_t _workerIndex);
+
+    void doPlaceThread(const size_t _idx);
 
 protected:
     SchedulerBase();
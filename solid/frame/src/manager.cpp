@@ -212,6 +212,9 @@ std::ostream& operator<<(std::ostream& _ros, UniqueId const& _uid)
 using SizeStackT    = Stack<size_t>;
 using AtomicStatusT = std::atomic<StatusE>;
 
+// notifyAll hands the actors to their reactor in batches of at most this size
+constexpr size_t notify_all_batch_size = 4 * 1024;
+
 //-----------------------------------------------------------------------------
 // POD structure
 struct ActorStub {
@@ -716,6 +719,31 @@ ActorIdT Manager::registerActor(
     return retval;
 }
 
+// Moves a registered actor onto _rreactor - _rfct schedules it there.
+// Fails when the actor's visits were disabled - i.e. the actor is stopping.
+bool Manager::moveActor(
+    ActorBase&         _ractor,
+    ReactorBase&       _rreactor,
+    ScheduleFunctionT& _rschedule_fnc)
+{
+    const size_t                  actor_index = static_cast<size_t>(_ractor.id());
+    std::unique_lock<ChunkMutexT> chunk_lock;
+    ActorChunkPtrT&               rchunk_ptr = pimpl_->chunk(actor_index, chunk_lock);
+    ActorChunk&                   rchunk     = *rchunk_ptr;
+    ActorStub&                    ras        = rchunk[actor_index % pimpl_->actor_chunk_size_];
+
+    if (ras.pactor_ != &_ractor || !ras.reactor_ptr_) {
+        return false;
+    }
+    // NOTE: same as on registerActor - the new reactor locks the actor's
+    // mutex before calling any of the actor's code
+    if (_rschedule_fnc(_rreactor)) {
+        ras.reactor_ptr_ = _rreactor.shared_from_this();
+        return true;
+    }
+    return false;
+}
+
 void Manager::unregisterActor(ActorBase& _ractor)
 {
     size_t       service_index = InvalidIndex();
@@ -789,12 +817,80 @@ bool Manager::notify(ActorIdT const& _ruid, const EventBase& _evt)
     return doVisit(_ruid, ActorVisitFunctionT{do_notify_fnc});
 }
 
+/*NOTE:
+    Instead of one wake per actor, the actors are grouped by their reactor
+    and each reactor gets one wakeAll per batch - the reactor fans the
+    event out locally. The chunk lock is held only while collecting the
+    actor ids of a chunk, the batches are delivered after releasing it.
+*/
 size_t Manager::notifyAll(const Service& _rsvc, EventBase const& _revt)
 {
-    const auto do_notify_fnc = [&_revt](VisitContext& _rctx) {
-        return _rctx.wakeActor(_revt);
+    if (!_rsvc.registered()) {
+        return 0u;
+    }
+    size_t first_actor_chunk = InvalidIndex();
+    {
+        std::unique_lock<ServiceMutexT> service_lock;
+        ServiceStub&                    rss = pimpl_->service(_rsvc.index(), service_lock);
+        first_actor_chunk                   = rss.first_actor_chunk_;
+    }
+    return doNotifyAll(first_actor_chunk, _revt);
+}
+
+size_t Manager::doNotifyAll(const size_t _first_actor_chunk, EventBase const& _revt)
+{
+    struct ReactorBatch {
+        ReactorBasePtrT       reactor_ptr_;
+        std::vector<UniqueId> uid_vec_;
+    };
+
+    size_t                    chunk_index = _first_actor_chunk;
+    std::vector<ReactorBatch> batch_vec;
+    size_t                    notified_count = 0;
+
+    const auto flush_batches = [&batch_vec, &_revt](const size_t _min_size) {
+        for (auto& rbatch : batch_vec) {
+            if (!rbatch.uid_vec_.empty() && rbatch.uid_vec_.size() >= _min_size) {
+                rbatch.reactor_ptr_->wakeAll(std::move(rbatch.uid_vec_), _revt);
+                rbatch.uid_vec_ = std::vector<UniqueId>();
+            }
+        }
     };
-    return doForEachServiceActor(_rsvc, ActorVisitFunctionT{do_notify_fnc});
+
+    while (chunk_index != InvalidIndex()) {
+        {
+            std::unique_lock<ChunkMutexT> chunk_lock;
+            ActorChunkPtrT&               rchunk_ptr = pimpl_->chunk(chunk_index * pimpl_->actor_chunk_size_, chunk_lock);
+            ActorChunk&                   rchunk     = *rchunk_ptr;
+            ReactorBatch*                 pbatch     = nullptr;
+
+            for (size_t i{0}, cnt{0}; i < pimpl_->actor_chunk_size_ && cnt < rchunk.actor_count_; ++i) {
+                ActorStub& ractor = rchunk[i];
+                if (ractor.pactor_ != nullptr && ractor.reactor_ptr_) {
+                    if (pbatch == nullptr || pbatch->reactor_ptr_ != ractor.reactor_ptr_) {
+                        pbatch = nullptr;
+                        for (auto& rbatch : batch_vec) {
+                            if (rbatch.reactor_ptr_ == ractor.reactor_ptr_) {
+                                pbatch = &rbatch;
+                                break;
+                            }
+                        }
+                        if (pbatch == nullptr) {
+                            pbatch = &batch_vec.emplace_back(ReactorBatch{ractor.reactor_ptr_, {}});
+                        }
+                    }
+                    pbatch->uid_vec_.emplace_back(ractor.pactor_->runId());
+                    ++notified_count;
+                    ++cnt;
+                }
+            }
+            chunk_index = rchunk.next_chunk_;
+        }
+        flush_batches(notify_all_batch_size);
+    }
+    flush_batches(0);
+
+    return notified_count;
 }
 
 bool Manager::doVisit(ActorIdT const& _actor_id, const ActorVisitFunctionT& _rfct)
@@ -1011,10 +1107,9 @@ bool Manager::doStopService(const size_t _service_index, const bool _wait)
             rss.pservice_->onLockedStoppingBeforeActors();
         }
 
-        const auto raise_lambda = [](VisitContext& _rctx) {
-            return _rctx.wakeActor(generic_event<GenericEventE::Kill>);
-        };
-        const size_t cnt = doForEachServiceActor(rss.first_actor_chunk_, ActorVisitFunctionT{raise_lambda});
+        // batched - the reactors cannot stop actors while we hold the service lock
+        // so one wake per actor would fill their wake rings
+        const size_t cnt = doNotifyAll(rss.first_actor_chunk_, generic_event<GenericEventE::Kill>);
 
         if (cnt == 0 && rss.actor_count_ == 0) {
             solid_log(frame_logger, Verbose, "StateStoppedE on " << _service_index);
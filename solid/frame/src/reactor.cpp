@@ -35,6 +35,7 @@
 #include "solid/frame/service.hpp"
 #include "solid/frame/timer.hpp"
 #include "solid/frame/timestore.hpp"
+#include "solid/frame/timewheel.hpp"
 
 using namespace std;
 
@@ -102,12 +103,17 @@ using UniqueIdVectorT         = std::vector<UniqueId>;
 using CompletionHandlerDequeT = std::deque<CompletionHandlerStub>;
 using ActorDequeT             = std::deque<ActorStub>;
 using SizeStackT              = Stack<size_t>;
+#if defined(SOLID_FRAME_REACTOR_USE_TIME_WHEEL)
+using TimeStoreT = TimeWheel;
+#else
+using TimeStoreT = TimeStore;
+#endif
 } // namespace
 
 struct impl::Reactor::Data {
     bool                    running_   = false;
     bool                    must_stop_ = false;
-    TimeStore               time_store_{max_event_capacity};
+    TimeStoreT              time_store_{max_event_capacity};
     NanoTime                current_time_;
     std::mutex              mutex_;
     condition_variable      cnd_var_;
@@ -532,6 +538,11 @@ UniqueId ReactorBase::popUid(ActorBase& _ract)
     return rv;
 }
 
+bool ReactorBase::moveActor(ActorBase& _ract, Manager& _rm, ReactorBase& _rreactor, ScheduleFunctionT& _rfct)
+{
+    return _rm.moveActor(_ract, _rreactor, _rfct);
+}
+
 bool ReactorBase::prepareThread(const bool _success)
 {
     return scheduler().prepareThread(idInScheduler(), *this, _success);
@@ -543,6 +554,13 @@ void ReactorBase::unprepareThread()
 
 ReactorBase::~ReactorBase() {}
 
+void ReactorBase::wakeAll(std::vector<UniqueId>&& _ruid_vec, EventBase const& _revent)
+{
+    for (const auto& uid : _ruid_vec) {
+        wake(uid, _revent);
+    }
+}
+
 //=============================================================================
 //      ReactorStatisticBase
 //=============================================================================
@@ -15,6 +15,7 @@
 #include "solid/utility/algorithm.hpp"
 #include "solid/utility/queue.hpp"
 #include "solid/utility/stack.hpp"
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
@@ -82,15 +83,20 @@ using AtomicSizeT = std::atomic<size_t>;
 struct ReactorStub {
     thread       thread_;
     ReactorBase* preactor_;
+    CpuVectorT   cpu_vec_; // sorted, empty - not pinned
+    int          numa_node_;
 
     ReactorStub(ReactorBase* _preactor = nullptr)
         : preactor_(_preactor)
+        , numa_node_(-1)
     {
     }
 
     ReactorStub(ReactorStub&& _other) noexcept
         : thread_(std::move(_other.thread_))
         , preactor_(_other.preactor_)
+        , cpu_vec_(std::move(_other.cpu_vec_))
+        , numa_node_(_other.numa_node_)
     {
         _other.preactor_ = nullptr;
     }
@@ -129,6 +135,7 @@ struct SchedulerBase::Data {
     ThreadEnterFunctionT thread_enter_fnc_;
     ThreadExitFunctionT  thread_exit_fnc_;
     ReactorVectorT       reactor_vec_;
+    CpuVectorT           cpu_node_vec_; // NUMA node by cpu - filled only with a placement
     mutex                mtx_;
     condition_variable   cnd_;
 
@@ -162,13 +169,56 @@ size_t SchedulerBase::workerCount() const
     return pimpl_->reactor_cnt_.load(std::memory_order_relaxed);
 }
 
+SchedulerPlacement SchedulerPlacement::cpus(const CpuVectorT& _cpu_vec)
+{
+    SchedulerPlacement placement;
+    for (const auto cpu : _cpu_vec) {
+        placement.reactor_cpu_vec.emplace_back(CpuVectorT{cpu});
+    }
+    return placement;
+}
+
+SchedulerPlacement SchedulerPlacement::numa(size_t _reactor_count)
+{
+    std::vector<CpuVectorT> node_cpu_vec;
+    size_t                  total_cpu_count = 0;
+
+    for (size_t i = 0; i < numa_node_count(); ++i) {
+        CpuVectorT cpu_vec = numa_node_cpus(static_cast<int>(i));
+        if (!cpu_vec.empty()) { // skip memory only nodes
+            total_cpu_count += cpu_vec.size();
+            node_cpu_vec.emplace_back(std::move(cpu_vec));
+        }
+    }
+
+    if (_reactor_count == 0) {
+        _reactor_count = total_cpu_count;
+    }
+
+    SchedulerPlacement placement;
+    // every node gets reactors in proportion to its cpus
+    size_t assigned_count = 0;
+    size_t cpu_offset     = 0;
+    for (const auto& cpu_vec : node_cpu_vec) {
+        cpu_offset += cpu_vec.size();
+        const size_t node_reactor_count = (_reactor_count * cpu_offset + total_cpu_count - 1) / total_cpu_count - assigned_count;
+
+        for (size_t i = 0; i < node_reactor_count; ++i) {
+            placement.reactor_cpu_vec.emplace_back(CpuVectorT{cpu_vec[i % cpu_vec.size()]});
+        }
+        assigned_count += node_reactor_count;
+    }
+    return placement;
+}
+
 void SchedulerBase::doStart(
     CreateWorkerF         _pf,
     ThreadEnterFunctionT& _renter_fnc, ThreadExitFunctionT& _rexit_fnc,
-    size_t _reactorcnt, const size_t _wake_capacity)
+    size_t _reactorcnt, const size_t _wake_capacity,
+    SchedulerPlacement&& _uplacement)
 {
     if (_reactorcnt == 0) {
-        _reactorcnt = thread::hardware_concurrency();
+        _reactorcnt = _uplacement.empty() ? thread::hardware_concurrency() : _uplacement.size();
     }
     bool start_err = false;
 
@@ -184,6 +234,29 @@ void SchedulerBase::doStart(
         }
 
         pimpl_->reactor_vec_.resize(_reactorcnt);
+        pimpl_->cpu_node_vec_.clear();
+
+        if (!_uplacement.empty()) {
+            for (size_t i = 0; i < _reactorcnt; ++i) {
+                ReactorStub& rrs = pimpl_->reactor_vec_[i];
+                rrs.cpu_vec_     = _uplacement.reactor_cpu_vec[i % _uplacement.size()];
+                std::sort(rrs.cpu_vec_.begin(), rrs.cpu_vec_.end());
+                rrs.numa_node_ = rrs.cpu_vec_.empty() ? -1 : cpu_numa_node(rrs.cpu_vec_.front());
+            }
+            for (size_t i = 0; i < numa_node_count(); ++i) {
+                for (const auto cpu : numa_node_cpus(static_cast<int>(i))) {
+                    if (static_cast<size_t>(cpu) >= pimpl_->cpu_node_vec_.size()) {
+                        pimpl_->cpu_node_vec_.resize(cpu + 1, -1);
+                    }
+                    pimpl_->cpu_node_vec_[cpu] = static_cast<int>(i);
+                }
+            }
+        } else {
+            for (auto& rrs : pimpl_->reactor_vec_) {
+                rrs.cpu_vec_.clear();
+                rrs.numa_node_ = -1;
+            }
+        }
 
         if (!solid_function_empty(_renter_fnc)) {
             solid_function_clear(pimpl_->thread_enter_fnc_);
@@ -331,6 +404,88 @@ ActorIdT SchedulerBase::doStartActor(ActorBase& _ract, Service& _rsvc, const siz
     return rv;
 }
 
+ActorIdT SchedulerBase::doStartActorNearCpu(ActorBase& _ract, Service& _rsvc, const int _cpu, ScheduleFunctionT& _rfnc, ErrorConditionT& _rerr)
+{
+    ++pimpl_->use_cnt_;
+    ActorIdT rv;
+    if (pimpl_->status_ == StatusE::Running) {
+        ReactorStub& rrs = pimpl_->reactor_vec_[workerIndexNearCpu(_cpu)];
+
+        rv = _rsvc.registerActor(_ract, *rrs.preactor_, _rfnc, _rerr);
+    } else {
+        _rerr = error_running;
+    }
+    --pimpl_->use_cnt_;
+    return rv;
+}
+
+std::shared_ptr<ReactorBase> SchedulerBase::workerReactor(const size_t _workerIndex)
+{
+    ++pimpl_->use_cnt_;
+    std::shared_ptr<ReactorBase> reactor_ptr;
+    if (pimpl_->status_ == StatusE::Running && _workerIndex < workerCount()) {
+        reactor_ptr = pimpl_->reactor_vec_[_workerIndex].preactor_->shared_from_this();
+    }
+    --pimpl_->use_cnt_;
+    return reactor_ptr;
+}
+
+int SchedulerBase::workerNumaNode(const size_t _workerIndex) const
+{
+    return _workerIndex < pimpl_->reactor_vec_.size() ? pimpl_->reactor_vec_[_workerIndex].numa_node_ : -1;
+}
+
+// The least loaded reactor pinned on _cpu, then the least loaded one on the NUMA node of _cpu,
+// then the least loaded one overall.
+size_t SchedulerBase::workerIndexNearCpu(const int _cpu)
+{
+    if (_cpu < 0 || static_cast<size_t>(_cpu) >= pimpl_->cpu_node_vec_.size()) {
+        return doComputeScheduleReactorIndex();
+    }
+    const int node        = pimpl_->cpu_node_vec_[_cpu];
+    size_t    cpu_index   = InvalidIndex();
+    size_t    node_index  = InvalidIndex();
+    size_t    cpu_load    = 0;
+    size_t    node_load   = 0;
+    auto&     reactor_vec = pimpl_->reactor_vec_;
+
+    for (size_t i = 0; i < reactor_vec.size(); ++i) {
+        const ReactorStub& rrs  = reactor_vec[i];
+        const size_t       load = rrs.preactor_->load();
+
+        if (std::binary_search(rrs.cpu_vec_.begin(), rrs.cpu_vec_.end(), _cpu)) {
+            if (cpu_index == InvalidIndex() || load < cpu_load) {
+                cpu_index = i;
+                cpu_load  = load;
+            }
+        } else if (node >= 0 && rrs.numa_node_ == node) {
+            if (node_index == InvalidIndex() || load < node_load) {
+                node_index = i;
+                node_load  = load;
+            }
+        }
+    }
+
+    if (cpu_index != InvalidIndex()) {
+        return cpu_index;
+    }
+    if (node_index != InvalidIndex()) {
+        return node_index;
+    }
+    return doComputeScheduleReactorIndex();
+}
+
+void SchedulerBase::doPlaceThread(const size_t _idx)
+{
+    const ReactorStub& rrs = pimpl_->reactor_vec_[_idx];
+    if (!rrs.cpu_vec_.empty()) {
+        const ErrorCodeT err = thread_cpu_affinity(rrs.cpu_vec_);
+        if (err) {
+            solid_log(logger, Warning, "Failed pinning reactor " << _idx << " thread: " << err.message());
+        }
+    }
+}
+
 bool less_cmp(ReactorStub const& _rrs1, ReactorStub const& _rrs2)
 {
     return _rrs1.preactor_->load() < _rrs2.preactor_->load();
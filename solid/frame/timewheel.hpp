@@ -0,0 +1,363 @@
+// solid/frame/timewheel.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include "solid/system/cassert.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/nanotime.hpp"
+#include "solid/utility/common.hpp"
+#include "solid/utility/innerlist.hpp"
+
+namespace solid {
+namespace frame {
+
+namespace time_wheel_impl {
+enum struct LinkE : size_t {
+    Free = 0,
+    // add above
+    Count,
+};
+
+inline size_t trailing_zero_count(const uint64_t _v)
+{
+    return bit_count((_v & (~_v + 1)) - 1);
+}
+
+} // namespace time_wheel_impl
+
+//! Hierarchical timing wheel - drop-in alternative for TimeStore
+/*!
+    Time is split in ticks of the given resolution. A timer lives in
+    one of Levels x SlotCount slots chosen by the highest tick bit where its
+    expiry differs from the current tick, so push, update and pop(index)
+    are O(1) and every level only holds timers later than all the timers
+    on the levels below it. A slot is moved one level down (cascaded) when
+    the current tick reaches its start.
+    Timers are fired per whole tick: pop(_now, _fnc) fires every timer from
+    the ticks before the tick of _now and expiry() reports the end of the
+    earliest occupied tick. Thus a timer never fires before its expiry but
+    can fire up to one resolution late, while all timers sharing a tick
+    are fired in a single pass.
+*/
+class TimeWheel {
+    static constexpr size_t   SlotBits     = 6;
+    static constexpr size_t   SlotCount    = 1 << SlotBits;
+    static constexpr uint64_t SlotMask     = SlotCount - 1;
+    static constexpr size_t   Levels       = 6;
+    static constexpr size_t   OverflowSlot = Levels * SlotCount;
+    static constexpr size_t   InvalidSlot  = OverflowSlot + 1;
+    static constexpr uint64_t MaxTick      = std::numeric_limits<uint64_t>::max();
+
+    struct ProxyNode : inner::Node<to_underlying(time_wheel_impl::LinkE::Count)> {
+        size_t value_          = InvalidIndex{};
+        size_t internal_index_ = InvalidIndex{};
+        size_t slot_           = InvalidSlot;
+
+        void clear()
+        {
+            value_          = InvalidIndex{};
+            internal_index_ = InvalidIndex{};
+            slot_           = InvalidSlot;
+        }
+
+        bool empty() const
+        {
+            return slot_ == InvalidSlot;
+        }
+    };
+
+    struct Value {
+        NanoTime expiry_      = NanoTime::max();
+        uint64_t tick_        = 0;
+        size_t   proxy_index_ = InvalidIndex{};
+
+        Value() = default;
+        Value(const NanoTime& _expiry, const uint64_t _tick, const size_t _proxy_index)
+            : expiry_(_expiry)
+            , tick_(_tick)
+            , proxy_index_(_proxy_index)
+        {
+        }
+    };
+
+    using ValueVectorT   = std::vector<Value>;
+    using ProxyNodesT    = std::deque<ProxyNode>;
+    using ProxyFreeListT = inner::List<ProxyNodesT, to_underlying(time_wheel_impl::LinkE::Free)>;
+    using SlotsT         = std::vector<ValueVectorT>;
+    using OccupancyT     = std::array<uint64_t, Levels>;
+
+    const uint64_t resolution_;
+    uint64_t       cur_tick_   = 0;
+    uint64_t       min_tick_   = MaxTick;
+    NanoTime       min_expiry_ = NanoTime::max();
+    ProxyNodesT    proxy_nodes_;
+    ProxyFreeListT proxy_free_list_;
+    SlotsT         slots_;
+    OccupancyT     occupancy_;
+    ValueVectorT   cascade_values_;
+
+public:
+    TimeWheel(const size_t _capacity = 0, const std::chrono::nanoseconds _resolution = std::chrono::milliseconds(1));
+
+    size_t size() const;
+
+    bool empty() const;
+
+    size_t push(const NanoTime& _now, const NanoTime& _expiry, const size_t _value);
+
+    void update(const size_t _proxy_index, const NanoTime& _now, const NanoTime& _expiry);
+
+    void pop(const size_t _index);
+
+    template <class Fnc>
+    size_t pop(const NanoTime& _now, Fnc&& _fnc);
+
+    const NanoTime& expiry() const
+    {
+        return min_expiry_;
+    }
+
+private:
+    uint64_t tick(const NanoTime& _time) const;
+    NanoTime time(const uint64_t _tick) const;
+    void     link(const Value& _value);
+    void     unlink(const size_t _proxy_index);
+    bool     nextSlot(uint64_t& _rtick, size_t& _rslot) const;
+    void     cascade(const size_t _slot);
+    void     computeExpiry();
+};
+
+inline TimeWheel::TimeWheel(const size_t /*_capacity*/, const std::chrono::nanoseconds _resolution)
+    : resolution_(_resolution.count() > 0 ? static_cast<uint64_t>(_resolution.count()) : 1)
+    , proxy_free_list_(proxy_nodes_)
+    , slots_(OverflowSlot + 1)
+{
+    occupancy_.fill(0);
+}
+
+inline size_t TimeWheel::size() const
+{
+    return proxy_nodes_.size() - proxy_free_list_.size();
+}
+
+inline bool TimeWheel::empty() const
+{
+    return size() == 0;
+}
+
+inline uint64_t TimeWheel::tick(const NanoTime& _time) const
+{
+    constexpr uint64_t max_seconds = std::numeric_limits<uint64_t>::max() / 1000000000ULL - 1;
+    if (_time.seconds() < 0) {
+        return 0;
+    }
+    if (static_cast<uint64_t>(_time.seconds()) >= max_seconds) {
+        return MaxTick;
+    }
+    return (static_cast<uint64_t>(_time.seconds()) * 1000000000ULL + static_cast<uint64_t>(_time.nanoSeconds())) / resolution_;
+}
+
+inline NanoTime TimeWheel::time(const uint64_t _tick) const
+{
+    const uint64_t nanos = _tick * resolution_;
+    return NanoTime(static_cast<NanoTime::SecondT>(nanos / 1000000000ULL), static_cast<NanoTime::NanoSecondT>(nanos % 1000000000ULL));
+}
+
+inline void TimeWheel::link(const Value& _value)
+{
+    auto&          rnode = proxy_nodes_[_value.proxy_index_];
+    const uint64_t tick  = _value.tick_ < cur_tick_ ? cur_tick_ : _value.tick_;
+    const uint64_t diff  = tick ^ cur_tick_;
+    const size_t   level = diff == 0 ? 0 : (63 - leading_zero_count(diff)) / SlotBits;
+    uint64_t       expiry_tick;
+
+    if (level < Levels) {
+        const size_t shift = level * SlotBits;
+        const size_t index = static_cast<size_t>((tick >> shift) & SlotMask);
+        rnode.slot_        = level * SlotCount + index;
+        occupancy_[level] |= (uint64_t(1) << index);
+        expiry_tick = level == 0 ? tick + 1 : (tick >> shift) << shift;
+    } else {
+        rnode.slot_ = OverflowSlot;
+        expiry_tick = ((cur_tick_ >> (Levels * SlotBits)) + 1) << (Levels * SlotBits);
+    }
+
+    auto& rslot           = slots_[rnode.slot_];
+    rnode.internal_index_ = rslot.size();
+    rslot.emplace_back(_value);
+
+    if (expiry_tick < min_tick_) {
+        min_tick_   = expiry_tick;
+        min_expiry_ = time(expiry_tick);
+    }
+}
+
+inline void TimeWheel::unlink(const size_t _proxy_index)
+{
+    auto& rnode = proxy_nodes_[_proxy_index];
+    auto& rslot = slots_[rnode.slot_];
+
+    solid_assert(rslot.size() > rnode.internal_index_);
+
+    rslot[rnode.internal_index_]                                            = rslot.back();
+    proxy_nodes_[rslot[rnode.internal_index_].proxy_index_].internal_index_ = rnode.internal_index_;
+    rslot.pop_back();
+
+    if (rslot.empty() && rnode.slot_ < OverflowSlot) {
+        occupancy_[rnode.slot_ / SlotCount] &= ~(uint64_t(1) << (rnode.slot_ % SlotCount));
+    }
+}
+
+inline size_t TimeWheel::push(const NanoTime& _now, const NanoTime& _expiry, const size_t _value)
+{
+    if (empty()) {
+        // nothing to cascade - jump straight to the current tick
+        const uint64_t now_tick = tick(_now);
+        if (cur_tick_ < now_tick) {
+            cur_tick_ = now_tick;
+        }
+    }
+
+    size_t proxy_index = InvalidIndex{};
+    if (!proxy_free_list_.empty()) {
+        proxy_index = proxy_free_list_.popBack();
+    } else {
+        proxy_index = proxy_nodes_.size();
+        proxy_nodes_.emplace_back();
+    }
+
+    proxy_nodes_[proxy_index].value_ = _value;
+    link(Value(_expiry, tick(_expiry), proxy_index));
+
+    solid_dbg(generic_logger, Verbose, " slot = " << proxy_nodes_[proxy_index].slot_ << " internal index = " << proxy_nodes_[proxy_index].internal_index_ << " " << _expiry);
+    return proxy_index;
+}
+
+inline void TimeWheel::update(const size_t _proxy_index, const NanoTime& /*_now*/, const NanoTime& _expiry)
+{
+    solid_assert(_proxy_index < proxy_nodes_.size() && !proxy_nodes_[_proxy_index].empty());
+
+    unlink(_proxy_index);
+    link(Value(_expiry, tick(_expiry), _proxy_index));
+
+    solid_dbg(generic_logger, Verbose, " slot = " << proxy_nodes_[_proxy_index].slot_ << " internal index = " << proxy_nodes_[_proxy_index].internal_index_ << " " << _expiry);
+}
+
+inline void TimeWheel::pop(const size_t _proxy_index)
+{
+    solid_assert(_proxy_index < proxy_nodes_.size() && !proxy_nodes_[_proxy_index].empty());
+
+    unlink(_proxy_index);
+    proxy_nodes_[_proxy_index].clear();
+    proxy_free_list_.pushBack(_proxy_index);
+}
+
+inline bool TimeWheel::nextSlot(uint64_t& _rtick, size_t& _rslot) const
+{
+    // the lowest occupied level holds the earliest slot
+    for (size_t level = 0; level < Levels; ++level) {
+        if (occupancy_[level] != 0) {
+            const size_t shift = level * SlotBits;
+            const size_t index = time_wheel_impl::trailing_zero_count(occupancy_[level]);
+            _rtick             = ((cur_tick_ >> (shift + SlotBits)) << (shift + SlotBits)) | (static_cast<uint64_t>(index) << shift);
+            _rslot             = level * SlotCount + index;
+            return true;
+        }
+    }
+    if (!slots_[OverflowSlot].empty()) {
+        _rtick = ((cur_tick_ >> (Levels * SlotBits)) + 1) << (Levels * SlotBits);
+        _rslot = OverflowSlot;
+        return true;
+    }
+    return false;
+}
+
+inline void TimeWheel::cascade(const size_t _slot)
+{
+    // relative to the new current tick the timers land on lower levels,
+    // only the overflow ones can land back on the same slot
+    cascade_values_.clear();
+    cascade_values_.swap(slots_[_slot]);
+    if (_slot < OverflowSlot) {
+        occupancy_[_slot / SlotCount] &= ~(uint64_t(1) << (_slot % SlotCount));
+    }
+    for (const auto& value : cascade_values_) {
+        link(value);
+    }
+}
+
+inline void TimeWheel::computeExpiry()
+{
+    uint64_t next_tick;
+    size_t   slot;
+    if (nextSlot(next_tick, slot)) {
+        min_tick_   = slot < SlotCount ? next_tick + 1 : next_tick;
+        min_expiry_ = time(min_tick_);
+    } else {
+        min_tick_   = MaxTick;
+        min_expiry_ = NanoTime::max();
+    }
+}
+
+template <class Fnc>
+inline size_t TimeWheel::pop(const NanoTime& _now, Fnc&& _fnc)
+{
+    size_t count = 0;
+    if (_now < expiry()) {
+        return count;
+    }
+
+    const uint64_t now_tick = tick(_now);
+    uint64_t       next_tick;
+    size_t         slot;
+
+    while (nextSlot(next_tick, slot)) {
+        if (slot < SlotCount) {
+            if (next_tick >= now_tick) {
+                break;
+            }
+            cur_tick_ = next_tick;
+            // timers re-armed from _fnc for an already passed tick land
+            // back on this slot and are fired in the same pass
+            while (!slots_[slot].empty()) {
+                const auto proxy_index = slots_[slot].back().proxy_index_;
+                const auto expiry      = slots_[slot].back().expiry_;
+                const auto value       = proxy_nodes_[proxy_index].value_;
+
+                pop(proxy_index);
+
+                _fnc(value, expiry, proxy_index);
+                ++count;
+            }
+        } else {
+            if (next_tick > now_tick) {
+                break;
+            }
+            cur_tick_ = next_tick;
+            cascade(slot);
+        }
+    }
+
+    if (cur_tick_ < now_tick) {
+        cur_tick_ = now_tick;
+    }
+    computeExpiry();
+    return count;
+}
+
+} // namespace frame
+} // namespace solid
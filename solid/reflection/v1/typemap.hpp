@@ -9,6 +9,8 @@
 //
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <typeindex>
@@ -79,33 +81,113 @@ protected:
     };
     using ReflectorVectorT = std::vector<ReflectorStub>;
     struct TypeStub {
-        ReflectorVectorT reflector_vec_;
-        std::type_index  base_type_index_ = std::type_index{typeid(void)};
-        size_t           base_cast_index_ = 0;
-        std::type_index  this_type_index_ = std::type_index{typeid(void)};
-        size_t           this_cast_index_ = 0;
+        ReflectorVectorT      reflector_vec_;
+        std::type_index       base_type_index_ = std::type_index{typeid(void)};
+        size_t                base_cast_index_ = 0;
+        std::type_index       this_type_index_ = std::type_index{typeid(void)};
+        size_t                this_cast_index_ = 0;
+        const std::type_info* ptype_info_      = nullptr;
+        size_t                category_        = 0;
+        size_t                id_              = 0;
     };
 
     using TypeNameMapT = std::unordered_map<std::string_view, size_t>;
     using TypeIdMapT   = std::unordered_map<size_t, size_t>;
 
+    // ids below this are also kept in a vector indexed by id
+    static constexpr size_t dense_type_id_limit = 4 * 1024;
+
     struct CategoryStub {
-        TypeNameMapT type_name_map_;
-        TypeIdMapT   type_id_map_;
+        TypeNameMapT        type_name_map_;
+        TypeIdMapT          type_id_map_;
+        std::vector<size_t> type_id_vec_; // id -> type index, 0 for none
+    };
+
+    // open addressing on the type_info address - the dynamic type of a value is found
+    // without hashing its type name, as std::type_index does
+    struct TypeInfoStub {
+        const std::type_info* ptype_info_ = nullptr;
+        size_t                index_      = 0;
     };
 
     using IndexTupleT     = std::tuple<size_t, size_t, size_t>; // index, category, id
     using TypeIndexMapT   = std::unordered_map<std::type_index, IndexTupleT>;
     using TypeVectorT     = std::vector<TypeStub>;
     using CategoryVectorT = std::vector<CategoryStub>;
+    using TypeInfoVectorT = std::vector<TypeInfoStub>;
 
     TypeIndexMapT        type_index_map_;
     TypeVectorT          type_vec_;
     CastMapT             cast_map_;
     CastVectorT          cast_vec_;
     CategoryVectorT      category_vec_;
+    TypeInfoVectorT      type_info_vec_;
     std::vector<size_t>& reflector_index_vec_;
 
+    static size_t type_info_hash(const std::type_info& _rtype_info)
+    {
+        const auto value = reinterpret_cast<uintptr_t>(&_rtype_info);
+        return static_cast<size_t>((value >> 3) ^ (value >> 11));
+    }
+
+    //! The type_vec_ index of the registered type with _rtype_info or 0
+    size_t typeIndex(const std::type_info& _rtype_info) const
+    {
+        if (!type_info_vec_.empty()) {
+            const size_t mask = type_info_vec_.size() - 1;
+            for (size_t i = type_info_hash(_rtype_info) & mask;; i = (i + 1) & mask) {
+                const auto& rstub = type_info_vec_[i];
+                if (rstub.ptype_info_ == &_rtype_info) {
+                    return rstub.index_;
+                }
+                if (rstub.ptype_info_ == nullptr) {
+                    break;
+                }
+            }
+        }
+        // not found by address - e.g. a type_info from another shared object
+        const auto it = type_index_map_.find(std::type_index(_rtype_info));
+        return it != type_index_map_.end() ? std::get<0>(it->second) : 0;
+    }
+
+    //! The type_vec_ index of the type registered with _id in _category or 0
+    size_t typeIndex(const size_t _category, const size_t _id) const
+    {
+        solid_assert(_category < category_vec_.size());
+        const CategoryStub& rcategory_stub = category_vec_[_category];
+        if (_id < rcategory_stub.type_id_vec_.size()) {
+            return rcategory_stub.type_id_vec_[_id];
+        }
+        const auto it = rcategory_stub.type_id_map_.find(_id);
+        return it != rcategory_stub.type_id_map_.end() ? it->second : 0;
+    }
+
+    void indexTypeInfo(const size_t _index)
+    {
+        if ((type_vec_.size() - 1) * 2 > type_info_vec_.size()) {
+            TypeInfoVectorT type_info_vec(std::max(type_info_vec_.size() * 2, static_cast<size_t>(64)));
+            type_info_vec_.swap(type_info_vec);
+            for (size_t i = 1; i < type_vec_.size(); ++i) {
+                if (i != _index) {
+                    doIndexTypeInfo(i);
+                }
+            }
+        }
+        doIndexTypeInfo(_index);
+    }
+
+    void doIndexTypeInfo(const size_t _index)
+    {
+        const std::type_info& rtype_info = *type_vec_[_index].ptype_info_;
+        const size_t          mask       = type_info_vec_.size() - 1;
+        size_t                i          = type_info_hash(rtype_info) & mask;
+        while (type_info_vec_[i].ptype_info_ != nullptr) {
+            i = (i + 1) & mask;
+        }
+        type_info_vec_[i].ptype_info_ = &rtype_info;
+        type_info_vec_[i].index_      = _index;
+    }
+
     template <class Reflector>
     size_t reflectorIndex() const
     {
@@ -146,10 +228,10 @@ public:
         const auto reflector_index = reflectorIndex<Reflector>();
         solid_assert(reflector_index != solid::InvalidIndex());
 
-        const auto it = type_index_map_.find(std::type_index(typeid(_rvalue)));
+        const size_t type_index = typeIndex(typeid(_rvalue));
 
-        if (it != type_index_map_.end()) {
-            const auto& rtypestub       = type_vec_[std::get<0>(it->second)];
+        if (type_index != 0) {
+            const auto& rtypestub       = type_vec_[type_index];
             size_t      cast_index      = InvalidIndex{};
             const auto  elem_type_index = std::type_index(typeid(T));
             if (rtypestub.base_type_index_ == elem_type_index) {
@@ -244,9 +326,9 @@ public:
 
         solid_assert(_category < category_vec_.size());
         _rptr.reset(nullptr);
-        const auto it = category_vec_[_category].type_id_map_.find(_id);
-        if (it != category_vec_[_category].type_id_map_.end()) {
-            const TypeStub& rtypestub       = type_vec_[it->second];
+        const size_t type_index = typeIndex(_category, _id);
+        if (type_index != 0) {
+            const TypeStub& rtypestub       = type_vec_[type_index];
             const auto      elem_type_index = std::type_index(typeid(typename Ptr::element_type));
             size_t          cast_index      = InvalidIndex{};
             if (rtypestub.base_type_index_ == elem_type_index) {
@@ -268,7 +350,7 @@ public:
                 static_assert(std::is_same_v<Ptr, std::unique_ptr<typename Ptr::element_type>>, "Only unique with default deleter is supported");
                 rtypestub.reflector_vec_[reflector_index].create_unique_fnc_(&_rctx, &_rptr, rcaststub.unique_fnc_);
             }
-            return it->second;
+            return type_index;
         } else {
             return 0;
         }
@@ -324,9 +406,9 @@ public:
 
         solid_assert(_category < category_vec_.size());
         _rptr.reset();
-        const auto it = category_vec_[_category].type_id_map_.find(_id);
-        if (it != category_vec_[_category].type_id_map_.end()) {
-            const TypeStub& rtypestub       = type_vec_[it->second];
+        const size_t type_index = typeIndex(_category, _id);
+        if (type_index != 0) {
+            const TypeStub& rtypestub       = type_vec_[type_index];
             const auto      elem_type_index = std::type_index(typeid(typename Ptr::element_type));
             size_t          cast_index      = InvalidIndex{};
             if (rtypestub.base_type_index_ == elem_type_index) {
@@ -352,7 +434,7 @@ public:
             }
 
             rtypestub.reflector_vec_[reflector_index].reflect_fnc_(&_rreflector, _rptr.get(), &_rctx, rcaststub.reverse_fnc_);
-            return it->second;
+            return type_index;
         } else {
             return 0;
         }
@@ -362,9 +444,9 @@ public:
     size_t index(const T* _pvalue) const
     {
         if (_pvalue != nullptr) {
-            const auto it = type_index_map_.find(std::type_index(typeid(*_pvalue)));
-            solid_check(it != type_index_map_.end(), "Unknown type: " << typeid(*_pvalue).name());
-            return std::get<0>(it->second);
+            const size_t type_index = typeIndex(typeid(*_pvalue));
+            solid_check(type_index != 0, "Unknown type: " << typeid(*_pvalue).name());
+            return type_index;
         } else {
             return 0;
         }
@@ -374,13 +456,12 @@ public:
     auto id(const T* _pvalue) const
     {
         if (_pvalue != nullptr) {
-            const auto index = std::type_index(typeid(*_pvalue));
-            const auto it    = type_index_map_.find(index);
-            // solid_check(it != type_index_map_.end(), "Unknown type: "<<typeid(*_pvalue).name());
-            solid_assert(it != type_index_map_.end());
-            if (it != type_index_map_.end()) {
-                return it->second;
-                // return std::pair<size_t, size_t>(std::get<1>(it->second), std::get<2>(it->second));
+            const size_t type_index = typeIndex(typeid(*_pvalue));
+            // solid_check(type_index != 0, "Unknown type: "<<typeid(*_pvalue).name());
+            solid_assert(type_index != 0);
+            if (type_index != 0) {
+                const auto& rtypestub = type_vec_[type_index];
+                return std::make_tuple(type_index, rtypestub.category_, rtypestub.id_);
             }
         }
         return std::make_tuple(static_cast<size_t>(0), static_cast<size_t>(0), static_cast<size_t>(0));
@@ -540,14 +621,25 @@ private:
         solid_check(rcategory_stub.type_id_map_.find(_id) == rcategory_stub.type_id_map_.end(), "Id " << _id << " already exist in category " << _category);
         rcategory_stub.type_name_map_[_name] = index;
         rcategory_stub.type_id_map_[_id]     = index;
+        if (_id < dense_type_id_limit) {
+            if (_id >= rcategory_stub.type_id_vec_.size()) {
+                rcategory_stub.type_id_vec_.resize(_id + 1, 0);
+            }
+            rcategory_stub.type_id_vec_[_id] = index;
+        }
 
         type_vec_.emplace_back();
         type_vec_.back().this_cast_index_ = _this_cast_index;
         type_vec_.back().this_type_index_ = std::type_index(typeid(T));
         type_vec_.back().base_type_index_ = _base_type_index;
         type_vec_.back().base_cast_index_ = _base_cast_index;
+        type_vec_.back().ptype_info_      = &typeid(T);
+        type_vec_.back().category_        = _category;
+        type_vec_.back().id_              = _id;
         type_vec_.back().reflector_vec_.resize(reflector_index_vector().size());
 
+        indexTypeInfo(index);
+
         doInitTypeReflect<CreateF, T, Reflector...>(_create_f, index);
         return index;
     }
@@ -10,8 +10,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <bitset>
 #include <memory>
+#include <new>
 #include <utility>
 #include <vector>
 
@@ -45,6 +47,103 @@ protected:
     ErrorConditionT error_;
 };
 
+//! The part of the run stack owned by the currently running Runnable
+/*!
+    The top of the run stack is the front of the run queue. The sub-runnables
+    scheduled by a Runnable are pushed above it in call order and are put in
+    run order (reversed) when the Runnable restores the previous sentinel.
+*/
+struct RunSentinel {
+    size_t base_    = 0; // run stack size when the sentinel was set
+    size_t ordered_ = 0; // [base_, ordered_) is already in run order
+};
+
+//! Stack of Runnables backed by a reusable arena
+/*!
+    The Runnables are never moved once pushed - the sub-runnables may point
+    inside their parent's closure - only the pointers are reordered.
+    Popped slots and the pointer stack are kept for reuse, so a (de)serializer
+    reused across messages stops allocating after its deepest message.
+*/
+template <class T, size_t ChunkCapacity = 32>
+class RunStack : NonCopyable {
+    union Slot {
+        Slot() {}
+        ~Slot() {}
+
+        T     value_;
+        Slot* pnext_;
+    };
+    using ChunkPointerT  = std::unique_ptr<Slot[]>;
+    using ChunkVectorT   = std::vector<ChunkPointerT>;
+    using PointerVectorT = std::vector<T*>;
+
+    ChunkVectorT   chunks_;
+    PointerVectorT stack_;
+    Slot*          pfree_ = nullptr;
+
+public:
+    RunStack() = default;
+
+    ~RunStack()
+    {
+        clear();
+    }
+
+    bool empty() const
+    {
+        return stack_.empty();
+    }
+
+    size_t size() const
+    {
+        return stack_.size();
+    }
+
+    T& top()
+    {
+        return *stack_.back();
+    }
+
+    void push(T&& _rt)
+    {
+        if (pfree_ == nullptr) {
+            chunks_.emplace_back(new Slot[ChunkCapacity]);
+            Slot* pchunk = chunks_.back().get();
+            for (size_t i = 0; i < ChunkCapacity; ++i) {
+                pchunk[i].pnext_ = pfree_;
+                pfree_           = &pchunk[i];
+            }
+        }
+        Slot* pslot = pfree_;
+        pfree_      = pslot->pnext_;
+        stack_.push_back(::new (&pslot->value_) T(std::move(_rt)));
+    }
+
+    void pop()
+    {
+        T*    pt    = stack_.back();
+        Slot* pslot = reinterpret_cast<Slot*>(pt);
+        stack_.pop_back();
+        std::destroy_at(pt);
+        pslot->pnext_ = pfree_;
+        pfree_        = pslot;
+    }
+
+    void clear()
+    {
+        while (!stack_.empty()) {
+            pop();
+        }
+    }
+
+    //! Reverse the order of the topmost _count Runnables
+    void reverseTop(const size_t _count)
+    {
+        std::reverse(stack_.end() - _count, stack_.end());
+    }
+};
+
 } // namespace binary
 } // namespace v3
 } // namespace serialization
@@ -11,7 +11,6 @@
 #pragma once
 
 #include <istream>
-#include <list>
 #include <ostream>
 
 #include "solid/serialization/v3/binarybase.hpp"
@@ -19,6 +18,7 @@
 #include "solid/system/cassert.hpp"
 #include "solid/system/convertors.hpp"
 #include "solid/system/exception.hpp"
+#include "solid/system/fileregionstream.hpp"
 #include "solid/utility/function.hpp"
 
 namespace solid {
@@ -31,8 +31,7 @@ class DeserializerBase : public Base {
 
     typedef ReturnE (*CallbackT)(DeserializerBase&, Runnable&, void*);
 
-    using FunctionT    = solid_function_t(ReturnE(DeserializerBase&, Runnable&, void*), 64);
-    using FunctionPtrT = std::unique_ptr<FunctionT>;
+    using FunctionT = solid_function_t(ReturnE(DeserializerBase&, Runnable&, void*), 64);
 
     struct Runnable {
         Runnable(
@@ -73,7 +72,7 @@ class DeserializerBase : public Base {
             , size_(0)
             , data_(0)
             , name_(_name)
-            , fnc_ptr_(std::make_unique<FunctionT>(std::move(_f)))
+            , fnc_(std::move(_f))
             , limit_(0)
         {
         }
@@ -91,22 +90,22 @@ class DeserializerBase : public Base {
             , size_(_size)
             , data_(_data)
             , name_(_name)
-            , fnc_ptr_(std::make_unique<FunctionT>(std::move(_f)))
+            , fnc_(std::move(_f))
             , limit_(0)
         {
         }
 
-        void*        ptr_;
-        CallbackT    call_;
-        uint64_t     size_;
-        uint64_t     data_;
-        const char*  name_;
-        FunctionPtrT fnc_ptr_;
-        uint64_t     limit_;
+        void*       ptr_;
+        CallbackT   call_;
+        uint64_t    size_;
+        uint64_t    data_;
+        const char* name_;
+        FunctionT   fnc_;
+        uint64_t    limit_;
     };
 
-    using RunListT         = std::list<Runnable>;
-    using RunListIteratorT = std::list<Runnable>::const_iterator;
+    using RunStackT    = RunStack<Runnable>;
+    using RunSentinelT = RunSentinel;
 
 protected:
     DeserializerBase(const reflection::v1::TypeMapBase* const _ptype_map);
@@ -127,7 +126,7 @@ public:
 
     bool empty() const
     {
-        return run_lst_.empty();
+        return run_stk_.empty();
     }
 
     inline void addBasic(bool& _rb, const char* _name)
@@ -288,7 +287,7 @@ public:
                 call_function,
                 _name,
                 [_f = std::move(_f)](DeserializerBase& _rd, Runnable& _rr, void* _pctx) mutable {
-                    const RunListIteratorT old_sentinel = _rd.sentinel();
+                    const RunSentinelT old_sentinel = _rd.sentinel();
 
                     _f(static_cast<D&>(_rd), *static_cast<Ctx*>(_pctx));
 
@@ -310,9 +309,9 @@ public:
     {
         solid_log(logger, Info, _name);
         auto lambda = [_f = std::move(_f)](DeserializerBase& _rd, Runnable& _rr, void* _pctx) mutable {
-            const RunListIteratorT old_sentinel = _rd.sentinel();
-            const bool             done         = _f(static_cast<D&>(_rd), *static_cast<Ctx*>(_pctx), _rr.name_);
-            const bool             is_run_empty = _rd.isRunEmpty();
+            const RunSentinelT old_sentinel = _rd.sentinel();
+            const bool         done         = _f(static_cast<D&>(_rd), *static_cast<Ctx*>(_pctx), _rr.name_);
+            const bool         is_run_empty = _rd.isRunEmpty();
 
             _rd.sentinel(old_sentinel);
 
@@ -351,8 +350,8 @@ public:
             Ctx& rctx       = *static_cast<Ctx*>(_pctx);
 
             if (init) {
-                init                                = false;
-                const RunListIteratorT old_sentinel = _rd.sentinel();
+                init                            = false;
+                const RunSentinelT old_sentinel = _rd.sentinel();
                 solid_assert_log(_rd.isRunEmpty(), logger);
 
                 rd.addBasicCompacted(_rr.size_, _rr.name_);
@@ -375,7 +374,7 @@ public:
                 return ReturnE::Done;
             }
 
-            const RunListIteratorT old_sentinel = _rd.sentinel();
+            const RunSentinelT old_sentinel = _rd.sentinel();
 
             while (_rd.pcrt_ != _rd.pend_ && _rr.size_ != 0) {
                 rd.add(value, rctx, 0, _rr.name_); // TODO: use a propper index
@@ -497,26 +496,38 @@ private:
     void tryRun(Runnable&& _ur, void* _pctx = nullptr);
     void fastTryRun(Runnable&& _ur, void* _pctx = nullptr);
 
-    RunListIteratorT sentinel()
+    RunSentinelT sentinel()
     {
-        RunListIteratorT old = sentinel_;
-        sentinel_            = run_lst_.cbegin();
+        RunSentinelT old = sentinel_;
+        sentinel_.base_ = sentinel_.ordered_ = run_stk_.size();
         return old;
     }
 
-    void sentinel(const RunListIteratorT _s)
+    void sentinel(const RunSentinelT& _s)
     {
+        arrange();
         sentinel_ = _s;
     }
 
     bool isRunEmpty() const
     {
-        return sentinel_ == run_lst_.cbegin();
+        return sentinel_.base_ == run_stk_.size();
     }
 
-    RunListIteratorT schedule(Runnable&& _ur)
+    void schedule(Runnable&& _ur)
     {
-        return run_lst_.emplace(sentinel_, std::move(_ur));
+        run_stk_.push(std::move(_ur));
+    }
+
+    void arrange()
+    {
+        const size_t count   = run_stk_.size() - sentinel_.base_;
+        const size_t ordered = sentinel_.ordered_ - sentinel_.base_;
+        if (count != ordered) {
+            run_stk_.reverseTop(count);
+            run_stk_.reverseTop(ordered);
+            sentinel_.ordered_ = run_stk_.size();
+        }
     }
 
     static ReturnE load_bool(DeserializerBase& _rd, Runnable& _rr, void* _pctx);
@@ -754,7 +765,7 @@ private:
         D&                rd         = static_cast<D&>(_rd);
         Ctx&              rctx       = *static_cast<Ctx*>(_pctx);
 
-        const RunListIteratorT old_sentinel = _rd.sentinel();
+        const RunSentinelT old_sentinel = _rd.sentinel();
 
         while (_rd.pcrt_ != _rd.pend_ && _rr.data_ < _rr.size_) {
             rd.add(rcontainer[static_cast<size_t>(_rr.data_)], rctx, 0, _rr.name_); // TODO: add propper index
@@ -952,11 +963,11 @@ protected:
     const reflection::v1::TypeMapBase* const ptype_map_;
 
 private:
-    const char*      pbeg_;
-    const char*      pend_;
-    const char*      pcrt_;
-    RunListT         run_lst_;
-    RunListIteratorT sentinel_;
+    const char*  pbeg_;
+    const char*  pend_;
+    const char*  pcrt_;
+    RunStackT    run_stk_;
+    RunSentinelT sentinel_;
 }; // namespace solid
 
 template <class MetadataVariant, class MetadataFactory, class Context, typename TypeId>
@@ -1095,7 +1106,10 @@ private:
 #endif
     void addDispatch(const Meta& _meta, T& _rt, ContextT& _rctx, const size_t _id, const char* const _name)
     {
-        if constexpr (std::is_base_of_v<std::ostream, T>) {
+        if constexpr (std::is_base_of_v<FileRegionOStream, T>) {
+            const uint64_t limit = _meta.max_size_ != std::numeric_limits<uint64_t>::max() ? _meta.max_size_ : _rt.remaining();
+            addStream(const_cast<T&>(_rt), limit, _meta.progress_function_, _rctx, _id, _name);
+        } else if constexpr (std::is_base_of_v<std::ostream, T>) {
             addStream(const_cast<T&>(_rt), _meta.max_size_, _meta.progress_function_, _rctx, _id, _name);
         } else if constexpr (std::is_integral_v<T>) {
             addBasic(_rt, _name);
@@ -12,7 +12,6 @@
 #pragma once
 
 #include <istream>
-#include <list>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -22,6 +21,7 @@
 #include "solid/serialization/v3/binarybasic.hpp"
 #include "solid/system/convertors.hpp"
 #include "solid/system/exception.hpp"
+#include "solid/system/fileregionstream.hpp"
 #include "solid/system/log.hpp"
 #include "solid/utility/function.hpp"
 #include "solid/utility/innerlist.hpp"
@@ -37,8 +37,7 @@ class SerializerBase : public Base {
 
     typedef ReturnE (*CallbackT)(SerializerBase&, Runnable&, void*);
 
-    using FunctionT    = solid_function_t(ReturnE(SerializerBase&, Runnable&, void*), 64);
-    using FunctionPtrT = std::unique_ptr<FunctionT>;
+    using FunctionT = solid_function_t(ReturnE(SerializerBase&, Runnable&, void*), 64);
 
     struct Runnable {
         Runnable(
@@ -62,7 +61,7 @@ class SerializerBase : public Base {
             , size_(0)
             , data_(0)
             , name_(_name)
-            , fnc_ptr_(std::make_unique<FunctionT>(std::move(_f)))
+            , fnc_(std::move(_f))
         {
         }
 
@@ -79,20 +78,20 @@ class SerializerBase : public Base {
             , size_(_size)
             , data_(_data)
             , name_(_name)
-            , fnc_ptr_(std::make_unique<FunctionT>(std::move(_f)))
+            , fnc_(std::move(_f))
         {
         }
 
-        const void*  ptr_;
-        CallbackT    call_;
-        uint64_t     size_;
-        uint64_t     data_;
-        const char*  name_;
-        FunctionPtrT fnc_ptr_;
+        const void* ptr_;
+        CallbackT   call_;
+        uint64_t    size_;
+        uint64_t    data_;
+        const char* name_;
+        FunctionT   fnc_;
     };
 
-    using RunListT         = std::list<Runnable>;
-    using RunListIteratorT = std::list<Runnable>::const_iterator;
+    using RunStackT    = RunStack<Runnable>;
+    using RunSentinelT = RunSentinel;
 
 protected:
     SerializerBase(const reflection::v1::TypeMapBase* const _ptype_map);
@@ -107,10 +106,34 @@ public:
 
     bool empty() const
     {
-        return run_lst_.empty();
+        return run_stk_.empty();
     }
 
 public: // should be protected
+    //! Straight-line store of an integral value - same encoding as addBasic
+    /*!
+        Only done when nothing is pending and the value fits in the buffer,
+        otherwise returns false and the caller takes the resumable path.
+    */
+    template <typename T>
+    inline bool tryStoreFixed(const T& _rv)
+    {
+        static_assert(std::is_integral_v<T>, "only integral types are accepted");
+        if (isRunEmpty() && static_cast<size_t>(pend_ - pcrt_) >= sizeof(T)) {
+            if constexpr (std::is_same_v<T, bool>) {
+                *pcrt_ = static_cast<char>(_rv ? 0xFF : 0xAA);
+            } else if constexpr (sizeof(T) == 1) {
+                *pcrt_ = static_cast<char>(_rv);
+            } else {
+                const uint64_t v = static_cast<uint64_t>(_rv);
+                memcpy(pcrt_, &v, sizeof(T));
+            }
+            pcrt_ += sizeof(T);
+            return true;
+        }
+        return false;
+    }
+
     inline void addBasic(const bool& _rb, const char* _name)
     {
         solid_log(logger, Info, _name);
@@ -299,7 +322,7 @@ public: // should be protected
                 call_function,
                 _name,
                 [_f = std::move(_f)](SerializerBase& _rs, Runnable& _rr, void* _pctx) mutable {
-                    const RunListIteratorT old_sentinel = _rs.sentinel();
+                    const RunSentinelT old_sentinel = _rs.sentinel();
 
                     _f(static_cast<S&>(_rs), *static_cast<Ctx*>(_pctx));
 
@@ -321,8 +344,8 @@ public: // should be protected
     {
         solid_log(logger, Info, _name);
         auto lambda = [_f = std::move(_f)](SerializerBase& _rs, Runnable& _rr, void* _pctx) mutable {
-            const RunListIteratorT old_sentinel = _rs.sentinel();
-            const bool             done         = _f(static_cast<S&>(_rs), _rr.name_);
+            const RunSentinelT old_sentinel = _rs.sentinel();
+            const bool         done         = _f(static_cast<S&>(_rs), _rr.name_);
 
             const bool is_run_empty = _rs.isRunEmpty();
             _rs.sentinel(old_sentinel);
@@ -353,8 +376,8 @@ public: // should be protected
     {
         solid_log(logger, Info, _name);
         auto lambda = [_f = std::move(_f)](SerializerBase& _rs, Runnable& _rr, void* _pctx) mutable {
-            const RunListIteratorT old_sentinel = _rs.sentinel();
-            const bool             done         = _f(static_cast<S&>(_rs), *static_cast<Ctx*>(_pctx), _rr.name_);
+            const RunSentinelT old_sentinel = _rs.sentinel();
+            const bool         done         = _f(static_cast<S&>(_rs), *static_cast<Ctx*>(_pctx), _rr.name_);
 
             const bool is_run_empty = _rs.isRunEmpty();
             _rs.sentinel(old_sentinel);
@@ -402,10 +425,10 @@ public: // should be protected
 
             if (it != _rc.cend()) {
                 auto lambda = [it](SerializerBase& _rs, Runnable& _rr, void* _pctx) mutable {
-                    const C&               rcontainer   = *static_cast<const C*>(_rr.ptr_);
-                    Ctx&                   rctx         = *static_cast<Ctx*>(_pctx);
-                    S&                     rs           = static_cast<S&>(_rs);
-                    const RunListIteratorT old_sentinel = _rs.sentinel();
+                    const C&           rcontainer   = *static_cast<const C*>(_rr.ptr_);
+                    Ctx&               rctx         = *static_cast<Ctx*>(_pctx);
+                    S&                 rs           = static_cast<S&>(_rs);
+                    const RunSentinelT old_sentinel = _rs.sentinel();
 
                     while (_rs.pcrt_ != _rs.pend_ && it != rcontainer.cend()) {
                         rs.add(*it, rctx, 0, _rr.name_); // TODO: use index instead of 0
@@ -563,26 +586,38 @@ protected:
 private:
     void tryRun(Runnable&& _ur, void* _pctx = nullptr);
 
-    RunListIteratorT sentinel()
+    RunSentinelT sentinel()
     {
-        RunListIteratorT old = sentinel_;
-        sentinel_            = run_lst_.cbegin();
+        RunSentinelT old = sentinel_;
+        sentinel_.base_ = sentinel_.ordered_ = run_stk_.size();
         return old;
     }
 
-    void sentinel(const RunListIteratorT _s)
+    void sentinel(const RunSentinelT& _s)
     {
+        arrange();
         sentinel_ = _s;
     }
 
     bool isRunEmpty() const
     {
-        return sentinel_ == run_lst_.cbegin();
+        return sentinel_.base_ == run_stk_.size();
     }
 
-    RunListIteratorT schedule(Runnable&& _ur)
+    void schedule(Runnable&& _ur)
     {
-        return run_lst_.emplace(sentinel_, std::move(_ur));
+        run_stk_.push(std::move(_ur));
+    }
+
+    void arrange()
+    {
+        const size_t count   = run_stk_.size() - sentinel_.base_;
+        const size_t ordered = sentinel_.ordered_ - sentinel_.base_;
+        if (count != ordered) {
+            run_stk_.reverseTop(count);
+            run_stk_.reverseTop(ordered);
+            sentinel_.ordered_ = run_stk_.size();
+        }
     }
 
     static ReturnE store_byte(SerializerBase& _rs, Runnable& _rr, void* _pctx);
@@ -667,7 +702,7 @@ private:
         const std::array<T, N>& rcontainer   = *static_cast<const std::array<T, N>*>(_rr.ptr_);
         Ctx&                    rctx         = *static_cast<Ctx*>(_pctx);
         S&                      rs           = static_cast<S&>(_rs);
-        const RunListIteratorT  old_sentinel = _rs.sentinel();
+        const RunSentinelT      old_sentinel = _rs.sentinel();
 
         while (_rs.pcrt_ != _rs.pend_ && _rr.data_ < _rr.size_) {
             rs.add(rcontainer[static_cast<size_t>(_rr.data_)], rctx, _rr.data_, _rr.name_);
@@ -783,11 +818,11 @@ protected:
     const reflection::v1::TypeMapBase* const ptype_map_;
 
 private:
-    char*            pbeg_;
-    char*            pend_;
-    char*            pcrt_;
-    RunListT         run_lst_;
-    RunListIteratorT sentinel_;
+    char*        pbeg_;
+    char*        pend_;
+    char*        pcrt_;
+    RunStackT    run_stk_;
+    RunSentinelT sentinel_;
 }; // namespace v2
 
 //-----------------------------------------------------------------------------
@@ -828,6 +863,12 @@ public:
     template <typename T>
     auto& add(const T& _rt, Context& _rctx, const size_t _id, const char* const _name)
     {
+        if constexpr (std::is_integral_v<T>) {
+            // fixed size fields of reflected structures skip metadata and the run queue
+            if (this->tryStoreFixed(_rt)) {
+                return *this;
+            }
+        }
         auto meta = rmetadata_factory_(_rt, _rctx, this->ptype_map_);
         addDispatch(meta, _rt, _rctx, _id, _name);
         return *this;
@@ -917,7 +958,11 @@ private:
     void addDispatch(const Meta& _meta, const T& _rt, ContextT& _rctx, const size_t _id, const char* const _name)
     {
 
-        if constexpr (std::is_base_of_v<std::istream, T>) {
+        if constexpr (std::is_base_of_v<FileRegionIStream, T>) {
+            solid_assert(_meta.progress_function_);
+            const uint64_t size = _meta.size_ != InvalidSize() ? _meta.size_ : _rt.remaining();
+            addStream(const_cast<T&>(_rt), size, _meta.max_size_, _meta.progress_function_, _rctx, _id, _name);
+        } else if constexpr (std::is_base_of_v<std::istream, T>) {
             solid_assert(_meta.progress_function_);
             addStream(const_cast<T&>(_rt), _meta.size_, _meta.max_size_, _meta.progress_function_, _rctx, _id, _name);
         } else if constexpr (std::is_integral_v<T>) {
@@ -24,7 +24,6 @@ DeserializerBase::DeserializerBase(const reflection::v1::TypeMapBase* const _pty
     , pbeg_(nullptr)
     , pend_(nullptr)
     , pcrt_(nullptr)
-    , sentinel_(run_lst_.cend())
 {
 }
 
@@ -51,12 +50,13 @@ ptrdiff_t DeserializerBase::run(const char* _pbeg, unsigned _sz, void* _pctx)
 
 ptrdiff_t DeserializerBase::doRun(void* _pctx)
 {
-    while (!run_lst_.empty()) {
-        Runnable&     rr = run_lst_.front();
+    arrange();
+    while (!run_stk_.empty()) {
+        Runnable&     rr = run_stk_.top();
         const ReturnE rv = rr.call_(*this, rr, _pctx);
         switch (rv) {
         case ReturnE::Done:
-            run_lst_.pop_front();
+            run_stk_.pop();
             break;
         case ReturnE::Continue:
             break;
@@ -65,24 +65,27 @@ ptrdiff_t DeserializerBase::doRun(void* _pctx)
         }
     }
 DONE:
-    ptrdiff_t rv = error_ ? -1 : pcrt_ - pbeg_;
+    sentinel_.ordered_ = run_stk_.size();
+    ptrdiff_t rv       = error_ ? -1 : pcrt_ - pbeg_;
     pcrt_ = pbeg_ = pend_ = nullptr;
     return rv;
 }
 
 void DeserializerBase::clear()
 {
-    run_lst_.clear();
-    error_ = ErrorConditionT();
+    run_stk_.clear();
+    sentinel_ = RunSentinelT();
+    error_    = ErrorConditionT();
 }
 
 void DeserializerBase::fastTryRun(Runnable&& _ur, void* _pctx)
 {
     if (isRunEmpty()) {
-        const auto    tmp_sentinel = sentinel_;
-        const ReturnE v            = _ur.call_(*this, _ur, _pctx);
+        const ReturnE v = _ur.call_(*this, _ur, _pctx);
         if (v != ReturnE::Done) {
-            run_lst_.emplace(tmp_sentinel, std::move(_ur));
+            // the fast load functions do not schedule sub-runnables
+            solid_assert_log(isRunEmpty(), logger);
+            schedule(std::move(_ur));
         }
     } else {
         schedule(std::move(_ur));
@@ -91,14 +94,19 @@ void DeserializerBase::fastTryRun(Runnable&& _ur, void* _pctx)
 
 void DeserializerBase::tryRun(Runnable&& _ur, void* _pctx)
 {
-    const RunListIteratorT it = schedule(std::move(_ur));
+    const bool is_run_empty = isRunEmpty();
 
-    if (it == run_lst_.cbegin()) {
+    schedule(std::move(_ur));
+
+    if (is_run_empty) {
         // we try run the function on spot
-        Runnable&     rr = run_lst_.front();
+        Runnable&     rr = run_stk_.top();
         const ReturnE v  = rr.call_(*this, rr, _pctx);
         if (v == ReturnE::Done) {
-            run_lst_.pop_front();
+            run_stk_.pop();
+        } else {
+            // rr and whatever it scheduled are already in run order
+            sentinel_.ordered_ = run_stk_.size();
         }
     }
 }
@@ -117,7 +125,7 @@ Base::ReturnE DeserializerBase::load_byte(DeserializerBase& _rd, Runnable& _rr,
 
 Base::ReturnE DeserializerBase::call_function(DeserializerBase& _rd, Runnable& _rr, void* _pctx)
 {
-    return (*_rr.fnc_ptr_)(_rd, _rr, _pctx);
+    return _rr.fnc_(_rd, _rr, _pctx);
 }
 
 Base::ReturnE DeserializerBase::noop(DeserializerBase& /*_rd*/, Runnable& /*_rr*/, void* /*_pctx*/)
@@ -177,7 +185,7 @@ Base::ReturnE DeserializerBase::load_stream_chunk_begin(DeserializerBase& _rd, R
 {
     if (_rr.size_ == 0) {
         _rr.data_ = 0;
-        (*_rr.fnc_ptr_)(_rd, _rr, _pctx);
+        _rr.fnc_(_rd, _rr, _pctx);
         return ReturnE::Done;
     }
     _rr.call_ = load_stream_chunk;
@@ -195,7 +203,7 @@ Base::ReturnE DeserializerBase::load_stream_chunk(DeserializerBase& _rd, Runnabl
 
         _rr.data_ = len;
 
-        (*_rr.fnc_ptr_)(_rd, _rr, _pctx);
+        _rr.fnc_(_rd, _rr, _pctx);
 
         if (_rd.error()) {
             return ReturnE::Done;
@@ -23,7 +23,6 @@ SerializerBase::SerializerBase(const reflection::v1::TypeMapBase* const _ptype_m
     , pbeg_(nullptr)
     , pend_(nullptr)
     , pcrt_(nullptr)
-    , sentinel_(run_lst_.cend())
 {
 }
 
@@ -49,12 +48,13 @@ ptrdiff_t SerializerBase::run(char* _pbeg, unsigned _sz, void* _pctx)
 
 ptrdiff_t SerializerBase::doRun(void* _pctx)
 {
-    while (!run_lst_.empty()) {
-        Runnable&     rr = run_lst_.front();
+    arrange();
+    while (!run_stk_.empty()) {
+        Runnable&     rr = run_stk_.top();
         const ReturnE rv = rr.call_(*this, rr, _pctx);
         switch (rv) {
         case ReturnE::Done:
-            run_lst_.pop_front();
+            run_stk_.pop();
             break;
         case ReturnE::Continue:
             break;
@@ -63,27 +63,34 @@ ptrdiff_t SerializerBase::doRun(void* _pctx)
         }
     }
 DONE:
-    ptrdiff_t rv = error_ ? -1 : pcrt_ - pbeg_;
+    sentinel_.ordered_ = run_stk_.size();
+    ptrdiff_t rv       = error_ ? -1 : pcrt_ - pbeg_;
     pcrt_ = pbeg_ = pend_ = nullptr;
     return rv;
 }
 
 void SerializerBase::clear()
 {
-    run_lst_.clear();
-    error_ = ErrorConditionT();
+    run_stk_.clear();
+    sentinel_ = RunSentinelT();
+    error_    = ErrorConditionT();
 }
 
 void SerializerBase::tryRun(Runnable&& _ur, void* _pctx)
 {
-    const RunListIteratorT it = schedule(std::move(_ur));
+    const bool is_run_empty = isRunEmpty();
 
-    if (it == run_lst_.cbegin()) {
+    schedule(std::move(_ur));
+
+    if (is_run_empty) {
         // we try run the function on spot
-        Runnable& rr = run_lst_.front();
+        Runnable& rr = run_stk_.top();
         ReturnE   v  = rr.call_(*this, rr, _pctx);
         if (v == ReturnE::Done) {
-            run_lst_.pop_front();
+            run_stk_.pop();
+        } else {
+            // rr and whatever it scheduled are already in run order
+            sentinel_.ordered_ = run_stk_.size();
         }
     }
 }
@@ -113,7 +120,7 @@ Base::ReturnE SerializerBase::store_compacted_inline(SerializerBase& _rs, Runnab
 
 Base::ReturnE SerializerBase::call_function(SerializerBase& _rs, Runnable& _rr, void* _pctx)
 {
-    return (*_rr.fnc_ptr_)(_rs, _rr, _pctx);
+    return _rr.fnc_(_rs, _rr, _pctx);
 }
 
 Base::ReturnE SerializerBase::noop(SerializerBase& /*_rs*/, Runnable& /*_rr*/, void* /*_pctx*/)
@@ -157,7 +164,7 @@ Base::ReturnE SerializerBase::store_stream(SerializerBase& _rs, Runnable& _rr, v
 
     if (!done) {
         if (_rr.size_ != 0) {
-            (*_rr.fnc_ptr_)(_rs, _rr, _pctx);
+            _rr.fnc_(_rs, _rr, _pctx);
             if (_rs.error()) {
                 return ReturnE::Done;
             }
@@ -165,7 +172,7 @@ Base::ReturnE SerializerBase::store_stream(SerializerBase& _rs, Runnable& _rr, v
         return ReturnE::Wait;
     }
     _rr.size_ = 0;
-    (*_rr.fnc_ptr_)(_rs, _rr, _pctx);
+    _rr.fnc_(_rs, _rr, _pctx);
 
     return ReturnE::Done;
 }
@@ -0,0 +1,203 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "solid/reflection/v1/metadata.hpp"
+#include "solid/serialization/v3/serialization.hpp"
+#include "solid/system/exception.hpp"
+#include "solid/system/filedevice.hpp"
+#include "solid/system/fileregionstream.hpp"
+#include "solid/system/log.hpp"
+
+using namespace std;
+using namespace solid;
+
+namespace {
+
+struct Context {
+};
+
+using ContextT      = Context;
+using SerializerT   = serialization::v3::binary::Serializer<reflection::metadata::Variant<ContextT>, decltype(reflection::metadata::factory), ContextT, uint8_t>;
+using DeserializerT = serialization::v3::binary::Deserializer<reflection::metadata::Variant<ContextT>, decltype(reflection::metadata::factory), ContextT, uint8_t>;
+
+constexpr size_t buffer_capacity = 64 * 1024; // mprpc packet sized buffer
+
+auto istream_progress = [](ContextT&, std::istream&, uint64_t, const bool, const size_t, const char*) {};
+auto ostream_progress = [](ContextT&, std::ostream&, uint64_t, const bool, const size_t, const char*) {};
+
+// Serializes _ris chunk by chunk into a buffer and deserializes every chunk into _ros
+template <class IS, class OS>
+uint64_t transfer(IS& _ris, OS& _ros, const uint64_t _size = InvalidSize())
+{
+    SerializerT   ser{reflection::metadata::factory};
+    DeserializerT des{reflection::metadata::factory};
+    ContextT      ctx;
+    vector<char>  buf(buffer_capacity);
+    uint64_t      total = 0;
+
+    ptrdiff_t len = ser.run(
+        buf.data(), static_cast<unsigned>(buf.size()),
+        [&_ris, _size](SerializerT& _rs, ContextT& _rctx) {
+            _rs.add(_ris, _rctx, 1, "stream", [_size](auto& _rmeta) {
+                _rmeta.progressFunction(istream_progress);
+                if (_size != InvalidSize()) {
+                    _rmeta.size(_size);
+                }
+            });
+        },
+        ctx);
+    bool first = true;
+
+    while (len > 0) {
+        total += len;
+        ptrdiff_t rv;
+        if (first) {
+            first = false;
+            rv    = des.run(
+                buf.data(), static_cast<unsigned>(len),
+                [&_ros](DeserializerT& _rd, ContextT& _rctx) {
+                    _rd.add(_ros, _rctx, 1, "stream", [](auto& _rmeta) { _rmeta.progressFunction(ostream_progress); });
+                },
+                ctx);
+        } else {
+            rv = des.run(buf.data(), static_cast<unsigned>(len), ctx);
+        }
+        solid_check(rv == len && !des.error(), "deserialization failed: " << des.error().message());
+        len = ser.run(buf.data(), static_cast<unsigned>(buf.size()), ctx);
+    }
+    solid_check(len == 0 && !ser.error(), "serialization failed: " << ser.error().message());
+    solid_check(des.empty(), "deserializer not done");
+    return total;
+}
+
+string read_file(const char* _path, const int64_t _offset, const size_t _size)
+{
+    FileDevice fd;
+    solid_check(fd.open(_path, FileDevice::ReadOnlyE), "open " << _path);
+    string data(_size, '\0');
+    solid_check(fd.read(data.data(), _size, _offset) == static_cast<ssize_t>(_size), "read " << _path);
+    return data;
+}
+
+} // namespace
+
+// Sends a region of a file through serialization v3 - with FileRegionIStream/FileRegionOStream
+// (pread/pwrite straight from/into the (de)serializer buffer) and with std::ifstream/std::ofstream.
+int test_file_region(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWX"});
+
+    size_t file_size = 16 * 1024 * 1024;
+
+    if (argc > 1) {
+        file_size = atoi(argv[1]) * 1024 * 1024;
+    }
+
+    const char* src_path = "test_file_region_src.bin";
+    const char* dst_path = "test_file_region_dst.bin";
+
+    const int64_t  region_offset = 4096 + 13;
+    const uint64_t region_size   = file_size - region_offset - 1000;
+    const int64_t  dst_offset    = 100;
+
+    {
+        FileDevice fd;
+        solid_check(fd.create(src_path, FileDevice::WriteOnlyE | FileDevice::TruncateE), "create " << src_path);
+        vector<char> data(file_size);
+        uint32_t     seed = 1;
+        for (auto& c : data) {
+            seed = seed * 1103515245 + 12345;
+            c    = static_cast<char>(seed >> 16);
+        }
+        solid_check(fd.write(data.data(), data.size()) == static_cast<ssize_t>(data.size()), "write " << src_path);
+    }
+    const string expected = read_file(src_path, region_offset, region_size);
+
+    { // file region to file region
+        FileDevice src_fd;
+        FileDevice dst_fd;
+        solid_check(src_fd.open(src_path, FileDevice::ReadOnlyE));
+        solid_check(dst_fd.create(dst_path, FileDevice::ReadWriteE | FileDevice::TruncateE));
+
+        FileRegionIStream ris(src_fd, region_offset, region_size, true);
+        FileRegionOStream ros(dst_fd, dst_offset, region_size);
+
+        const auto start = chrono::steady_clock::now();
+        transfer(ris, ros);
+        const auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+        solid_check(ris.remaining() == 0 && ros.remaining() == 0);
+        solid_check(read_file(dst_path, dst_offset, region_size) == expected, "file region content mismatch");
+        cout << "file region: " << region_size << " bytes in " << duration.count() << "us - " << (region_size / (duration.count() + 1.0)) << " MB/s" << endl;
+    }
+
+    { // std::fstream
+        ifstream ifs(src_path, ios::binary);
+        ofstream ofs(dst_path, ios::binary | ios::trunc);
+        ifs.seekg(region_offset);
+
+        const auto start = chrono::steady_clock::now();
+        transfer(ifs, ofs, region_size);
+        ofs.flush();
+        const auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+        ofs.close();
+        solid_check(read_file(dst_path, 0, region_size) == expected, "fstream content mismatch");
+        cout << "fstream:     " << region_size << " bytes in " << duration.count() << "us - " << (region_size / (duration.count() + 1.0)) << " MB/s" << endl;
+    }
+
+    { // the wire format is the one of plain streams - mix with std::stringstream
+        FileDevice src_fd;
+        solid_check(src_fd.open(src_path, FileDevice::ReadOnlyE));
+        FileRegionIStream ris(src_fd, region_offset, 100000);
+        ostringstream     oss;
+        transfer(ris, oss);
+        solid_check(oss.str() == expected.substr(0, 100000), "file region to stringstream mismatch");
+
+        FileDevice dst_fd;
+        solid_check(dst_fd.create(dst_path, FileDevice::ReadWriteE | FileDevice::TruncateE));
+        istringstream     iss(expected.substr(0, 200000));
+        FileRegionOStream ros(dst_fd, 0);
+        transfer(iss, ros);
+        solid_check(read_file(dst_path, 0, 200000) == expected.substr(0, 200000), "stringstream to file region mismatch");
+    }
+
+    { // a bounded FileRegionOStream limits the received size
+        FileDevice src_fd;
+        FileDevice dst_fd;
+        solid_check(src_fd.open(src_path, FileDevice::ReadOnlyE));
+        solid_check(dst_fd.create(dst_path, FileDevice::ReadWriteE | FileDevice::TruncateE));
+
+        FileRegionIStream ris(src_fd, 0, 300000);
+        FileRegionOStream ros(dst_fd, 0, 200000);
+
+        SerializerT   ser{reflection::metadata::factory};
+        DeserializerT des{reflection::metadata::factory};
+        ContextT      ctx;
+        vector<char>  buf(buffer_capacity);
+        ptrdiff_t     len = ser.run(
+            buf.data(), static_cast<unsigned>(buf.size()),
+            [&ris](SerializerT& _rs, ContextT& _rctx) {
+                _rs.add(ris, _rctx, 1, "stream", [](auto& _rmeta) { _rmeta.progressFunction(istream_progress); });
+            },
+            ctx);
+        des.run(
+            buf.data(), static_cast<unsigned>(len),
+            [&ros](DeserializerT& _rd, ContextT& _rctx) {
+                _rd.add(ros, _rctx, 1, "stream", [](auto& _rmeta) { _rmeta.progressFunction(ostream_progress); });
+            },
+            ctx);
+        while (!des.error() && (len = ser.run(buf.data(), static_cast<unsigned>(buf.size()), ctx)) > 0) {
+            des.run(buf.data(), static_cast<unsigned>(len), ctx);
+        }
+        solid_check(des.error() == serialization::v3::error_limit_stream, "expected limit error, got: " << des.error().message());
+    }
+
+    remove(src_path);
+    remove(dst_path);
+    return 0;
+}
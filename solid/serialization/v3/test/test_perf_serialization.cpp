@@ -0,0 +1,261 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "solid/serialization/v3/serialization.hpp"
+#include "solid/system/exception.hpp"
+
+using namespace solid;
+using namespace std;
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace {
+std::atomic<size_t> allocation_count{0};
+} // namespace
+
+void* operator new(std::size_t _sz)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(_sz != 0 ? _sz : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* _ptr) noexcept
+{
+    std::free(_ptr);
+}
+
+void operator delete(void* _ptr, std::size_t /*_sz*/) noexcept
+{
+    std::free(_ptr);
+}
+
+namespace {
+
+struct Context {
+};
+
+struct Item {
+    uint32_t       id = 0;
+    std::string    name;
+    vector<string> tags;
+
+    SOLID_REFLECT_V1(_s, _rthis, _rctx)
+    {
+        _s.add(_rthis.id, _rctx, 1, "id");
+        _s.add(_rthis.name, _rctx, 2, "name");
+        _s.add(_rthis.tags, _rctx, 3, "tags");
+    }
+
+    bool operator==(const Item& _other) const
+    {
+        return id == _other.id && name == _other.name && tags == _other.tags;
+    }
+};
+
+struct Message {
+    uint64_t                   id = 0;
+    std::string                text;
+    vector<Item>               items;
+    std::map<string, uint64_t> counters;
+
+    SOLID_REFLECT_V1(_s, _rthis, _rctx)
+    {
+        _s.add(_rthis.id, _rctx, 1, "id");
+        _s.add(_rthis.text, _rctx, 2, "text");
+        _s.add(_rthis.items, _rctx, 3, "items");
+        _s.add(_rthis.counters, _rctx, 4, "counters");
+    }
+
+    void init()
+    {
+        id   = 1234567890;
+        text = "some text describing the message to be serialized";
+        for (uint32_t i = 0; i < 16; ++i) {
+            items.emplace_back();
+            items.back().id   = i * 1000;
+            items.back().name = "item_" + to_string(i);
+            for (uint32_t j = 0; j < 4; ++j) {
+                items.back().tags.emplace_back("tag_" + to_string(j));
+            }
+            counters["counter_" + to_string(i)] = i * 100000;
+        }
+    }
+
+    bool operator==(const Message& _other) const
+    {
+        return id == _other.id && text == _other.text && items == _other.items && counters == _other.counters;
+    }
+};
+
+struct Record {
+    uint64_t timestamp = 0;
+    uint32_t sensor_id = 0;
+    int32_t  value     = 0;
+    uint16_t flags     = 0;
+    uint8_t  kind      = 0;
+    bool     valid     = false;
+
+    SOLID_REFLECT_V1(_s, _rthis, _rctx)
+    {
+        _s.add(_rthis.timestamp, _rctx, 1, "timestamp");
+        _s.add(_rthis.sensor_id, _rctx, 2, "sensor_id");
+        _s.add(_rthis.value, _rctx, 3, "value");
+        _s.add(_rthis.flags, _rctx, 4, "flags");
+        _s.add(_rthis.kind, _rctx, 5, "kind");
+        _s.add(_rthis.valid, _rctx, 6, "valid");
+    }
+
+    bool operator==(const Record& _other) const
+    {
+        return timestamp == _other.timestamp && sensor_id == _other.sensor_id && value == _other.value && flags == _other.flags && kind == _other.kind && valid == _other.valid;
+    }
+};
+
+struct Telemetry {
+    uint64_t       id = 0;
+    vector<Record> records;
+
+    SOLID_REFLECT_V1(_s, _rthis, _rctx)
+    {
+        _s.add(_rthis.id, _rctx, 1, "id");
+        _s.add(_rthis.records, _rctx, 2, "records");
+    }
+
+    void init()
+    {
+        id = 987654321;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            records.emplace_back();
+            records.back().timestamp = 1700000000000ULL + i;
+            records.back().sensor_id = i % 64;
+            records.back().value     = static_cast<int32_t>(i) - 500;
+            records.back().flags     = static_cast<uint16_t>(i * 7);
+            records.back().kind      = static_cast<uint8_t>(i % 5);
+            records.back().valid     = (i % 3) != 0;
+        }
+    }
+
+    bool operator==(const Telemetry& _other) const
+    {
+        return id == _other.id && records == _other.records;
+    }
+};
+
+using ContextT      = Context;
+using SerializerT   = serialization::v3::binary::Serializer<reflection::metadata::Variant<ContextT>, decltype(reflection::metadata::factory), ContextT, uint8_t>;
+using DeserializerT = serialization::v3::binary::Deserializer<reflection::metadata::Variant<ContextT>, decltype(reflection::metadata::factory), ContextT, uint8_t>;
+
+struct Result {
+    size_t              size_        = 0;
+    size_t              allocations_ = 0;
+    chrono::nanoseconds duration_{0};
+};
+
+template <class M>
+Result measure(SerializerT& _rser, DeserializerT& _rdes, const M& _rmsg, const size_t _count, const int _buffer_size)
+{
+    const size_t warmup_count = 16;
+    Context      ctx;
+    vector<char> buf(_buffer_size);
+    string       data;
+    Result       result;
+
+    data.reserve(64 * 1024);
+
+    const auto serialize = [&]() {
+        data.clear();
+        ptrdiff_t rv = _rser.run(
+            buf.data(), _buffer_size, [&_rmsg](SerializerT& _rs, Context& _rctx) { _rs.add(_rmsg, _rctx, 1, "msg"); }, ctx);
+        while (rv > 0) {
+            data.append(buf.data(), rv);
+            rv = _rser.run(buf.data(), _buffer_size, ctx);
+        }
+        solid_check(rv == 0 && _rser.empty());
+    };
+
+    for (size_t i = 0; i < warmup_count; ++i) {
+        serialize();
+    }
+
+    {
+        M         msg_check;
+        ptrdiff_t rv = _rdes.run(
+            data.data(), data.size(), [&msg_check](DeserializerT& _rd, Context& _rctx) { _rd.add(msg_check, _rctx, 1, "msg"); }, ctx);
+        solid_check(rv == static_cast<ptrdiff_t>(data.size()) && msg_check == _rmsg);
+    }
+
+    const size_t start_allocation_count = allocation_count.load();
+    const auto   start_time             = chrono::steady_clock::now();
+
+    for (size_t i = 0; i < _count; ++i) {
+        serialize();
+    }
+
+    result.duration_    = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start_time);
+    result.allocations_ = allocation_count.load() - start_allocation_count;
+    result.size_        = data.size();
+    return result;
+}
+
+} // namespace
+
+int test_perf_serialization(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWX"});
+
+    size_t message_count = 100000;
+    int    buffer_size   = 128;
+
+    if (argc > 1) {
+        message_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        buffer_size = atoi(argv[2]);
+    }
+
+    const reflection::TypeMap<SerializerT, DeserializerT> key_type_map{
+        [](auto& _rmap) {
+            _rmap.template registerType<Message>(0, 1, "Message");
+            _rmap.template registerType<Telemetry>(0, 2, "Telemetry");
+        }};
+
+    SerializerT   ser{reflection::metadata::factory, key_type_map};
+    DeserializerT des{reflection::metadata::factory, key_type_map};
+
+    {
+        Message msg;
+        msg.init();
+
+        const auto result = measure(ser, des, msg, message_count, buffer_size);
+
+        cout << "messages: " << message_count << " size: " << result.size_ << " buffer: " << buffer_size << endl;
+        cout << "serialize: " << (result.duration_.count() / message_count) << "ns/msg allocations: " << result.allocations_ << " (" << (double(result.allocations_) / message_count) << "/msg)" << endl;
+
+        solid_check(result.allocations_ == 0, "serializer allocated " << result.allocations_ << " times in steady state");
+    }
+    {
+        Telemetry msg;
+        msg.init();
+
+        const size_t telemetry_count = message_count / 100 + 1;
+        const auto   result          = measure(ser, des, msg, telemetry_count, 4096);
+
+        cout << "telemetry: " << telemetry_count << " size: " << result.size_ << " records: " << msg.records.size() << " buffer: 4096" << endl;
+        cout << "serialize: " << (result.duration_.count() / telemetry_count) << "ns/msg " << (result.duration_.count() / (telemetry_count * msg.records.size())) << "ns/record allocations: " << result.allocations_ << endl;
+
+        solid_check(result.allocations_ == 0, "serializer allocated " << result.allocations_ << " times in steady state");
+    }
+    return 0;
+}
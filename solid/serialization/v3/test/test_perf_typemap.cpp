@@ -0,0 +1,152 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "solid/serialization/v3/serialization.hpp"
+#include "solid/system/exception.hpp"
+
+using namespace solid;
+using namespace std;
+
+namespace {
+
+struct Context {
+};
+
+struct Base {
+    uint32_t value = 0;
+
+    virtual ~Base() {}
+    virtual size_t typeNumber() const = 0;
+};
+
+template <size_t I>
+struct Derived : Base {
+    uint64_t extra = I;
+
+    size_t typeNumber() const override
+    {
+        return I;
+    }
+
+    SOLID_REFLECT_V1(_s, _rthis, _rctx)
+    {
+        _s.add(_rthis.value, _rctx, 1, "value");
+        _s.add(_rthis.extra, _rctx, 2, "extra");
+    }
+};
+
+constexpr size_t type_count = 200;
+
+template <size_t I>
+std::string_view type_name()
+{
+    static const std::string name = "Derived" + to_string(I);
+    return name;
+}
+
+using ContextT      = Context;
+using SerializerT   = serialization::v3::binary::Serializer<reflection::metadata::Variant<ContextT>, decltype(reflection::metadata::factory), ContextT, uint16_t>;
+using DeserializerT = serialization::v3::binary::Deserializer<reflection::metadata::Variant<ContextT>, decltype(reflection::metadata::factory), ContextT, uint16_t>;
+using TypeMapT      = reflection::TypeMap<SerializerT, DeserializerT>;
+
+template <class Map, size_t... I>
+void register_types(Map& _rmap, std::index_sequence<I...>)
+{
+    (_rmap.template registerType<Derived<I>, Base>(0, I + 1, type_name<I>()), ...);
+}
+
+template <size_t... I>
+vector<shared_ptr<Base>> make_values(std::index_sequence<I...>)
+{
+    return {make_shared<Derived<I>>()...};
+}
+
+} // namespace
+
+// Polymorphic serialization through a TypeMap with many registered types:
+// the cost of finding the id of a value's dynamic type and of a round trip.
+int test_perf_typemap(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EWX"});
+
+    size_t count = 1000000;
+
+    if (argc > 1) {
+        count = atoi(argv[1]);
+    }
+
+    const TypeMapT type_map{
+        [](auto& _rmap) {
+            register_types(_rmap, std::make_index_sequence<type_count>{});
+        }};
+
+    auto value_vec = make_values(std::make_index_sequence<type_count>{});
+    for (size_t i = 0; i < value_vec.size(); ++i) {
+        value_vec[i]->value = static_cast<uint32_t>(i * 10);
+    }
+
+    { // the id of the dynamic type
+        size_t     sum        = 0;
+        const auto start_time = chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i) {
+            sum += std::get<2>(type_map.id(value_vec[i % type_count].get()));
+        }
+        const auto duration = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start_time);
+        solid_check(sum == (count / type_count) * (type_count * (type_count + 1) / 2) + (count % type_count) * (count % type_count + 1) / 2);
+
+        // what a std::type_index keyed hash map costs for the same lookups
+        unordered_map<std::type_index, size_t> type_index_map;
+        for (size_t i = 0; i < value_vec.size(); ++i) {
+            type_index_map[std::type_index(typeid(*value_vec[i]))] = i + 1;
+        }
+        size_t     hash_sum        = 0;
+        const auto hash_start_time = chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i) {
+            hash_sum += type_index_map.find(std::type_index(typeid(*value_vec[i % type_count])))->second;
+        }
+        const auto hash_duration = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - hash_start_time);
+        solid_check(hash_sum == sum);
+
+        cout << "types: " << type_count << " lookups: " << count << endl;
+        cout << "type map id: " << (double(duration.count()) / count) << "ns type_index hash map: " << (double(hash_duration.count()) / count) << "ns" << endl;
+    }
+
+    { // round trip
+        SerializerT   ser{reflection::metadata::factory, type_map};
+        DeserializerT des{reflection::metadata::factory, type_map};
+        Context       ctx;
+        char          buf[256];
+        string        data;
+        const size_t  round_count = count / 10 + type_count;
+
+        const auto start_time = chrono::steady_clock::now();
+        for (size_t i = 0; i < round_count; ++i) {
+            const auto& value_ptr = value_vec[i % type_count];
+
+            data.clear();
+            ptrdiff_t rv = ser.run(
+                buf, sizeof(buf), [&value_ptr](SerializerT& _rs, Context& _rctx) { _rs.add(value_ptr, _rctx, 1, "value"); }, ctx);
+            while (rv > 0) {
+                data.append(buf, rv);
+                rv = ser.run(buf, sizeof(buf), ctx);
+            }
+            solid_check(rv == 0);
+
+            shared_ptr<Base> check_ptr;
+            rv = des.run(
+                data.data(), data.size(), [&check_ptr](DeserializerT& _rd, Context& _rctx) { _rd.add(check_ptr, _rctx, 1, "value"); }, ctx);
+            solid_check(rv == static_cast<ptrdiff_t>(data.size()));
+            solid_check(check_ptr && check_ptr->typeNumber() == value_ptr->typeNumber() && check_ptr->value == value_ptr->value);
+        }
+        const auto duration = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start_time);
+
+        cout << "round trip: " << (duration.count() / round_count) << "ns/value" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,42 @@
+// solid/system/cpu.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include "solid/system/common.hpp"
+#include "solid/system/error.hpp"
+#include <string_view>
+#include <vector>
+
+namespace solid {
+
+using CpuVectorT = std::vector<int>;
+
+//! Parse a cpu list like "0-3,8,10-11" - the format of /sys/devices/system/node/nodeN/cpulist and of taskset -c
+CpuVectorT cpu_list_parse(std::string_view _txt);
+
+size_t cpu_count();
+//! The cpu the calling thread is running on or -1 if unknown
+int cpu_current();
+//! The NUMA node of _cpu - 0 on systems without NUMA information
+int cpu_numa_node(const int _cpu);
+
+//! The number of NUMA nodes - at least 1
+size_t     numa_node_count();
+CpuVectorT numa_node_cpus(const int _node);
+
+//! Pin the calling thread on the given cpus
+/*!
+    Memory first touched by the thread afterwards is allocated,
+    with the default kernel policy, on the NUMA node of the cpus.
+*/
+ErrorCodeT thread_cpu_affinity(const CpuVectorT& _cpu_vec);
+
+} // namespace solid
@@ -0,0 +1,288 @@
+// solid/system/fileregionstream.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <streambuf>
+
+#include "solid/system/seekabledevice.hpp"
+
+namespace solid {
+
+//! Unbuffered streambuf over a [offset, offset + size) region of a SeekableDevice
+/*!
+    Bulk reads (std::istream::read) go straight from the device into the caller's
+    buffer with pread and bulk writes (std::ostream::write) straight from the
+    caller's buffer with pwrite - no intermediate stream buffer.
+    The device is not owned and must outlive the streambuf.
+*/
+class FileRegionBuf : public std::streambuf {
+public:
+    static constexpr uint64_t unbounded_size = std::numeric_limits<uint64_t>::max();
+
+    FileRegionBuf() = default;
+
+    void region(SeekableDevice& _rdevice, const int64_t _offset, const uint64_t _size = unbounded_size)
+    {
+        pdevice_  = &_rdevice;
+        offset_   = _offset;
+        size_     = _size;
+        position_ = 0;
+        setg(nullptr, nullptr, nullptr);
+    }
+
+    void clear()
+    {
+        pdevice_  = nullptr;
+        offset_   = 0;
+        size_     = unbounded_size;
+        position_ = 0;
+        setg(nullptr, nullptr, nullptr);
+    }
+
+    SeekableDevice* device() const
+    {
+        return pdevice_;
+    }
+
+    int64_t offset() const
+    {
+        return offset_;
+    }
+
+    uint64_t size() const
+    {
+        return size_;
+    }
+
+    bool isBounded() const
+    {
+        return size_ != unbounded_size;
+    }
+
+    //! Bytes not yet read or written, unbounded_size for unbounded regions
+    uint64_t remaining() const
+    {
+        if (isBounded()) {
+            return size_ - position();
+        }
+        return unbounded_size;
+    }
+
+    //! Position relative to the region offset
+    uint64_t position() const
+    {
+        return position_ - (egptr() - gptr());
+    }
+
+protected:
+    std::streamsize xsgetn(char_type* _s, std::streamsize _n) override
+    {
+        std::streamsize total = 0;
+        if (gptr() != egptr() && _n != 0) { // the character peeked by underflow
+            *_s = *gptr();
+            gbump(1);
+            ++total;
+        }
+        return total + doRead(_s + total, _n - total);
+    }
+
+    int_type underflow() override
+    {
+        if (gptr() != egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        if (doRead(&peek_, 1) == 1) {
+            setg(&peek_, &peek_, &peek_ + 1);
+            return traits_type::to_int_type(peek_);
+        }
+        return traits_type::eof();
+    }
+
+    std::streamsize xsputn(const char_type* _s, std::streamsize _n) override
+    {
+        if (pdevice_ == nullptr) {
+            return 0;
+        }
+        if (static_cast<uint64_t>(_n) > remaining()) {
+            _n = static_cast<std::streamsize>(remaining());
+        }
+        std::streamsize total = 0;
+        while (total < _n) {
+            const ssize_t rv = pdevice_->write(_s + total, static_cast<size_t>(_n - total), offset_ + position_);
+            if (rv <= 0) {
+                break;
+            }
+            position_ += rv;
+            total += rv;
+        }
+        return total;
+    }
+
+    int_type overflow(int_type _c) override
+    {
+        if (traits_type::eq_int_type(_c, traits_type::eof())) {
+            return traits_type::not_eof(_c);
+        }
+        const char_type c = traits_type::to_char_type(_c);
+        return xsputn(&c, 1) == 1 ? _c : traits_type::eof();
+    }
+
+    pos_type seekoff(off_type _off, std::ios_base::seekdir _way, std::ios_base::openmode /*_mode*/) override
+    {
+        int64_t pos = _off;
+        if (_way == std::ios_base::cur) {
+            pos += position();
+        } else if (_way == std::ios_base::end) {
+            if (!isBounded()) {
+                return pos_type(off_type(-1));
+            }
+            pos += size_;
+        }
+        if (pos < 0 || (isBounded() && static_cast<uint64_t>(pos) > size_)) {
+            return pos_type(off_type(-1));
+        }
+        position_ = pos;
+        setg(nullptr, nullptr, nullptr);
+        return pos_type(pos);
+    }
+
+    pos_type seekpos(pos_type _pos, std::ios_base::openmode _mode) override
+    {
+        return seekoff(off_type(_pos), std::ios_base::beg, _mode);
+    }
+
+private:
+    std::streamsize doRead(char_type* _s, std::streamsize _n)
+    {
+        if (pdevice_ == nullptr) {
+            return 0;
+        }
+        if (static_cast<uint64_t>(_n) > remaining()) {
+            _n = static_cast<std::streamsize>(remaining());
+        }
+        std::streamsize total = 0;
+        while (total < _n) {
+            const ssize_t rv = pdevice_->read(_s + total, static_cast<size_t>(_n - total), offset_ + position_);
+            if (rv <= 0) {
+                break;
+            }
+            position_ += rv;
+            total += rv;
+        }
+        return total;
+    }
+
+private:
+    SeekableDevice* pdevice_  = nullptr;
+    int64_t         offset_   = 0;
+    uint64_t        size_     = unbounded_size;
+    uint64_t        position_ = 0;
+    char_type       peek_     = 0;
+};
+
+//! std::istream over a file region
+/*!
+    Serialization v3 stores it as a regular stream field: each chunk is pread
+    straight into the serializer buffer. If no explicit size is given in the
+    field metadata, the region's size is used.
+*/
+class FileRegionIStream : public std::istream {
+    FileRegionBuf buf_;
+
+public:
+    FileRegionIStream()
+        : std::istream(nullptr)
+    {
+        rdbuf(&buf_);
+    }
+
+    FileRegionIStream(SeekableDevice& _rdevice, const int64_t _offset, const uint64_t _size, const bool _readahead = false)
+        : std::istream(nullptr)
+    {
+        rdbuf(&buf_);
+        region(_rdevice, _offset, _size, _readahead);
+    }
+
+    //! Set the region to read - _readahead asks the kernel to prefetch it (posix_fadvise)
+    void region(SeekableDevice& _rdevice, const int64_t _offset, const uint64_t _size, const bool _readahead = false)
+    {
+        buf_.region(_rdevice, _offset, _size);
+        std::istream::clear();
+        if (_readahead) {
+            _rdevice.adviseSequential(_offset, buf_.isBounded() ? static_cast<int64_t>(_size) : 0);
+        }
+    }
+
+    FileRegionBuf& buffer()
+    {
+        return buf_;
+    }
+
+    const FileRegionBuf& buffer() const
+    {
+        return buf_;
+    }
+
+    uint64_t remaining() const
+    {
+        return buf_.remaining();
+    }
+};
+
+//! std::ostream over a file region
+/*!
+    Serialization v3 loads a stream field into it by pwrite-ing each chunk straight
+    from the deserializer buffer. For bounded regions, if no explicit maxSize is given
+    in the field metadata, the region's size is used as the limit.
+*/
+class FileRegionOStream : public std::ostream {
+    FileRegionBuf buf_;
+
+public:
+    FileRegionOStream()
+        : std::ostream(nullptr)
+    {
+        rdbuf(&buf_);
+    }
+
+    FileRegionOStream(SeekableDevice& _rdevice, const int64_t _offset, const uint64_t _size = FileRegionBuf::unbounded_size)
+        : std::ostream(nullptr)
+    {
+        rdbuf(&buf_);
+        region(_rdevice, _offset, _size);
+    }
+
+    void region(SeekableDevice& _rdevice, const int64_t _offset, const uint64_t _size = FileRegionBuf::unbounded_size)
+    {
+        buf_.region(_rdevice, _offset, _size);
+        std::ostream::clear();
+    }
+
+    FileRegionBuf& buffer()
+    {
+        return buf_;
+    }
+
+    const FileRegionBuf& buffer() const
+    {
+        return buf_;
+    }
+
+    uint64_t remaining() const
+    {
+        return buf_.remaining();
+    }
+};
+
+} // namespace solid
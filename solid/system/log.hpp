@@ -13,12 +13,15 @@
 #include "solid/system/chunkedstream.hpp"
 #include "solid/system/common.hpp"
 #include "solid/system/error.hpp"
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstring>
 #include <memory>
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 namespace solid {
 
@@ -76,10 +79,27 @@ struct LogLineBase {
     virtual ~LogLineBase();
     virtual std::ostream& writeTo(std::ostream&) const = 0;
     virtual size_t        size() const                 = 0;
+    //! Copy the line into a ring buffer of _capacity bytes, starting at _offset and wrapping to _pbuf
+    virtual void copyTo(char* _pbuf, const size_t _capacity, size_t _offset) const;
 };
 
 namespace impl {
 
+inline size_t log_ring_copy(char* _pbuf, const size_t _capacity, size_t _offset, const char* _pdata, size_t _size)
+{
+    while (_size != 0) {
+        const size_t sz = std::min(_size, _capacity - _offset);
+        memcpy(_pbuf + _offset, _pdata, sz);
+        _pdata += sz;
+        _size -= sz;
+        _offset += sz;
+        if (_offset == _capacity) {
+            _offset = 0;
+        }
+    }
+    return _offset;
+}
+
 template <size_t Size>
 class LogLineStream : public OChunkedStream<Size, Size>, public LogLineBase {
     using BaseStream = OChunkedStream<Size, Size>;
@@ -93,6 +113,12 @@ public:
     {
         return BaseStream::size();
     }
+    void copyTo(char* _pbuf, const size_t _capacity, size_t _offset) const override
+    {
+        BaseStream::visit([_pbuf, _capacity, &_offset](const char* _pdata, const size_t _size) {
+            _offset = log_ring_copy(_pbuf, _capacity, _offset, _pdata, _size);
+        });
+    }
 };
 
 #ifdef SOLID_USE_STRINGSTREAM_VIEW
@@ -183,6 +209,8 @@ struct LogRecorder : NonCopyable {
     virtual ~LogRecorder();
 
     virtual void recordLine(const solid::LogLineBase& /*_rlog_line*/);
+    //! Called by the asynchronous flusher with buffers of complete lines
+    virtual void recordBatch(const std::string_view* _pbuffers, const size_t _count);
 };
 
 struct LogStreamRecorder : LogRecorder {
@@ -193,6 +221,7 @@ struct LogStreamRecorder : LogRecorder {
     }
 
     void recordLine(const solid::LogLineBase& _rlog_line) override;
+    void recordBatch(const std::string_view* _pbuffers, const size_t _count) override;
 };
 
 using LogRecorderPtrT = std::shared_ptr<LogRecorder>;
@@ -218,6 +247,58 @@ ErrorConditionT log_start(
     const std::vector<std::string>& _rmodule_mask_vec,
     bool                            _buffered = true);
 
+enum struct LogAsyncPolicyE : uint8_t {
+    Drop,  //!< drop the line and count it when the thread's ring is full
+    Block, //!< wait for the flusher to make room
+};
+
+struct LogAsyncConfiguration {
+    static constexpr size_t default_ring_capacity = 256 * 1024;
+
+    size_t                    ring_capacity_ = default_ring_capacity; //!< bytes per producer thread
+    LogAsyncPolicyE           policy_        = LogAsyncPolicyE::Drop;
+    std::chrono::milliseconds flush_period_{10};
+
+    auto& ringCapacity(const size_t _value)
+    {
+        ring_capacity_ = _value;
+        return *this;
+    }
+    auto& policy(const LogAsyncPolicyE _value)
+    {
+        policy_ = _value;
+        return *this;
+    }
+    auto& flushPeriod(const std::chrono::milliseconds _value)
+    {
+        flush_period_ = _value;
+        return *this;
+    }
+};
+
+struct LogAsyncStatistic {
+    uint64_t dropped_line_count_   = 0;
+    uint64_t dropped_size_         = 0;
+    uint64_t blocked_line_count_   = 0;
+    uint64_t oversized_line_count_ = 0;
+    uint64_t flush_count_          = 0;
+    uint64_t flushed_size_         = 0;
+};
+
+std::ostream& operator<<(std::ostream& _ros, const LogAsyncStatistic& _rstat);
+
+//! Switch the engine to asynchronous recording
+/*!
+ * Every producer thread gets its own lock-free SPSC ring of _config.ring_capacity_ bytes.
+ * A dedicated flusher thread hands the buffered lines to the recorder in batches
+ * (LogRecorder::recordBatch), so file respin and disk writes happen off the logging threads.
+ * Lines larger than the ring are recorded synchronously.
+ */
+ErrorConditionT log_async_start(const LogAsyncConfiguration& _config = LogAsyncConfiguration());
+//! Flush everything and return to synchronous recording
+void              log_async_stop();
+LogAsyncStatistic log_async_statistic();
+
 #ifndef SOLID_LOG_BUFFER_SIZE
 
 constexpr size_t log_buffer_size = 2 * 1024;
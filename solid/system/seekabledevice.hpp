@@ -27,6 +27,12 @@ public:
     int64_t seek(int64_t _pos, SeekRef _ref = SeekBeg);
     //! Truncate to a certain length
     bool truncate(int64_t _len);
+    //! Hint the kernel that [_off, _off + _len) will be read sequentially - start readahead
+    /*!
+        Uses posix_fadvise where available - a no-op returning true elsewhere.
+        _len == 0 means up to the end of the file.
+    */
+    bool adviseSequential(int64_t _off, int64_t _len);
 
 protected:
     SeekableDevice(DescriptorT _desc = invalidDescriptor())
@@ -16,6 +16,43 @@
 
 namespace solid {
 
+//! A contiguous chunk of data for vectored (scatter/gather) socket writes
+struct ConstBuffer {
+    const char* data_ = nullptr;
+    size_t      size_ = 0;
+
+    ConstBuffer() = default;
+
+    ConstBuffer(const char* _data, const size_t _size)
+        : data_(_data)
+        , size_(_size)
+    {
+    }
+};
+
+//! A datagram for batched socket reads and writes (recvMany/sendMany)
+/*!
+ * recvMany: data_ and capacity_ are inputs, size_, address_ and segment_size_ are outputs.
+ * sendMany: data_, size_, address_ (empty for connected sockets) and segment_size_ are inputs.
+ * A non-zero segment_size_ means data_ holds consecutive datagrams of segment_size_ bytes
+ * (the last one can be shorter) - coalesced by UDP GRO on receive or split by UDP GSO on send.
+ */
+struct DatagramBuffer {
+    char*         data_         = nullptr;
+    size_t        capacity_     = 0;
+    size_t        size_         = 0;
+    size_t        segment_size_ = 0;
+    SocketAddress address_;
+
+    DatagramBuffer() = default;
+
+    DatagramBuffer(char* _data, const size_t _capacity)
+        : data_(_data)
+        , capacity_(_capacity)
+    {
+    }
+};
+
 //! A wrapper for berkeley sockets
 class SocketDevice : public Device {
 public:
@@ -54,6 +91,9 @@ public:
     //! Prepares the socket for accepting
     ErrorCodeT prepareAccept(const SocketAddressStub& _rsas, size_t _listencnt = 10);
     //! Accept an incoming connection
+    /*!
+        On Linux the accepted socket is created non-blocking (accept4).
+    */
     ErrorCodeT accept(SocketDevice& _dev, bool& _can_retry);
     ErrorCodeT accept(SocketDevice& _dev);
     //! Make a connection blocking
@@ -83,6 +123,12 @@ public:
 
     ErrorCodeT enableLoopbackFastPath();
 
+    ErrorCodeT enableZeroCopy(); // SO_ZEROCOPY - only on linux
+
+    ErrorCodeT enableReusePort(); // SO_REUSEPORT - must be called before prepareAccept
+
+    ErrorCodeT enableUdpGro(); // UDP_GRO - only on linux
+
     // ErrorCodeT sendBufferSize(size_t _sz);
     // ErrorCodeT recvBufferSize(size_t _sz);
     ErrorCodeT sendBufferSize(int& _rrv);
@@ -90,14 +136,41 @@ public:
 
     ErrorCodeT sendBufferSize(int& _rrv) const;
     ErrorCodeT recvBufferSize(int& _rrv) const;
+
+    ErrorCodeT incomingCpu(int& _rrv) const; // SO_INCOMING_CPU - the cpu handling the NIC receive queue, only on linux
     //! Write data on socket
     ssize_t send(const char* _pb, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr, unsigned _flags = 0);
+    //! Write a sequence of buffers on socket with a single system call
+    /*!
+     * With _zero_copy (MSG_ZEROCOPY, needs enableZeroCopy) the kernel keeps
+     * referencing the buffers after the call returns - they must not be
+     * modified until the completion is read with recvZeroCopyCompletion.
+     */
+    ssize_t sendv(const ConstBuffer* _pbufs, size_t _count, bool& _rcan_retry, ErrorCodeT& _rerr, const bool _zero_copy = false);
+    //! Read a MSG_ZEROCOPY completion from the socket error queue
+    /*!
+     * On success returns true and the range [_rlo, _rhi] of completed zero-copy
+     * send calls (the kernel numbers them from zero, per socket).
+     * Returns false if the error queue holds no zero-copy completion.
+     */
+    bool recvZeroCopyCompletion(uint32_t& _rlo, uint32_t& _rhi, ErrorCodeT& _rerr);
     //! Reads data from a socket
     ssize_t recv(char* _pb, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr, unsigned _flags = 0);
     //! Send a datagram to a socket
     ssize_t send(const char* _pb, size_t _ul, const SocketAddressStub& _sap, bool& _rcan_retry, ErrorCodeT& _rerr);
     //! Recv data from a socket
     ssize_t recv(char* _pb, size_t _ul, SocketAddress& _rsa, bool& _rcan_retry, ErrorCodeT& _rerr);
+    //! Receive up to _count datagrams - recvmmsg on Linux
+    /*!
+     * Returns the number of datagrams received or -1 on error.
+     */
+    ssize_t recvMany(DatagramBuffer* _pbufs, size_t _count, bool& _rcan_retry, ErrorCodeT& _rerr);
+    //! Send up to _count datagrams - sendmmsg on Linux
+    /*!
+     * Returns the number of datagrams sent or -1 on error.
+     * A non-zero DatagramBuffer::segment_size_ needs UDP_SEGMENT (Linux) - error_not_implemented otherwise.
+     */
+    ssize_t sendMany(const DatagramBuffer* _pbufs, size_t _count, bool& _rcan_retry, ErrorCodeT& _rerr);
     //! Gets the remote address for a connected socket
     ErrorCodeT remoteAddress(SocketAddress& _rsa) const;
     //! Gets the local address for a socket
@@ -127,6 +200,9 @@ public:
 private:
     SocketDevice(const SocketDevice& _dev);
     SocketDevice& operator=(const SocketDevice& _dev);
+
+private:
+    bool non_blocking_ = false;
 };
 
 struct LocalAddressPlot {
@@ -0,0 +1,151 @@
+// solid/system/src/cpu.cpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+#include "solid/system/cpu.hpp"
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#ifdef SOLID_ON_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace solid {
+
+namespace {
+#ifdef SOLID_ON_LINUX
+bool read_cpu_list(const std::string& _path, CpuVectorT& _rcpu_vec)
+{
+    std::ifstream ifs(_path);
+    std::string   line;
+    if (!ifs || !std::getline(ifs, line)) {
+        return false;
+    }
+    _rcpu_vec = cpu_list_parse(line);
+    return true;
+}
+#endif
+} // namespace
+
+CpuVectorT cpu_list_parse(std::string_view _txt)
+{
+    CpuVectorT cpu_vec;
+
+    const auto parse_number = [&_txt](size_t& _rpos, int& _rval) {
+        const size_t start = _rpos;
+        _rval              = 0;
+        while (_rpos < _txt.size() && _txt[_rpos] >= '0' && _txt[_rpos] <= '9') {
+            _rval = _rval * 10 + (_txt[_rpos] - '0');
+            ++_rpos;
+        }
+        return _rpos != start;
+    };
+
+    size_t pos = 0;
+    while (pos < _txt.size()) {
+        int first = 0;
+        int last  = 0;
+        if (!parse_number(pos, first)) {
+            ++pos; // skip separators and white spaces
+            continue;
+        }
+        last = first;
+        if (pos < _txt.size() && _txt[pos] == '-') {
+            ++pos;
+            if (!parse_number(pos, last) || last < first) {
+                last = first;
+            }
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpu_vec.emplace_back(cpu);
+        }
+    }
+    std::sort(cpu_vec.begin(), cpu_vec.end());
+    cpu_vec.erase(std::unique(cpu_vec.begin(), cpu_vec.end()), cpu_vec.end());
+    return cpu_vec;
+}
+
+size_t cpu_count()
+{
+    const size_t cnt = std::thread::hardware_concurrency();
+    return cnt != 0 ? cnt : 1;
+}
+
+int cpu_current()
+{
+#ifdef SOLID_ON_LINUX
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+size_t numa_node_count()
+{
+#ifdef SOLID_ON_LINUX
+    CpuVectorT node_vec;
+    if (read_cpu_list("/sys/devices/system/node/online", node_vec) && !node_vec.empty()) {
+        return node_vec.back() + 1;
+    }
+#endif
+    return 1;
+}
+
+CpuVectorT numa_node_cpus(const int _node)
+{
+    CpuVectorT cpu_vec;
+#ifdef SOLID_ON_LINUX
+    if (read_cpu_list("/sys/devices/system/node/node" + std::to_string(_node) + "/cpulist", cpu_vec)) {
+        return cpu_vec;
+    }
+#endif
+    if (_node == 0) {
+        for (size_t i = 0; i < cpu_count(); ++i) {
+            cpu_vec.emplace_back(static_cast<int>(i));
+        }
+    }
+    return cpu_vec;
+}
+
+int cpu_numa_node(const int _cpu)
+{
+    const size_t node_cnt = numa_node_count();
+    for (size_t i = 0; i < node_cnt; ++i) {
+        const CpuVectorT cpu_vec = numa_node_cpus(static_cast<int>(i));
+        if (std::binary_search(cpu_vec.begin(), cpu_vec.end(), _cpu)) {
+            return static_cast<int>(i);
+        }
+    }
+    return 0;
+}
+
+ErrorCodeT thread_cpu_affinity(const CpuVectorT& _cpu_vec)
+{
+#ifdef SOLID_ON_LINUX
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (const auto cpu : _cpu_vec) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpuset);
+        }
+    }
+    const int rv = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return ErrorCodeT(rv, std::system_category());
+#else
+    (void)_cpu_vec;
+    return solid::error_not_implemented;
+#endif
+}
+
+} // namespace solid
@@ -22,9 +22,16 @@
 #else
 #define _FILE_OFFSET_BITS 64
 #include <netinet/tcp.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#ifdef SOLID_ON_LINUX
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#endif
 #endif
 
 #include <cassert>
@@ -192,6 +199,18 @@ bool SeekableDevice::truncate(int64_t _len)
 #endif
 }
 
+bool SeekableDevice::adviseSequential(int64_t _off, int64_t _len)
+{
+#if defined(SOLID_ON_LINUX) || defined(SOLID_ON_FREEBSD)
+    if (::posix_fadvise(descriptor(), _off, _len, POSIX_FADV_SEQUENTIAL) != 0) {
+        return false;
+    }
+    return ::posix_fadvise(descriptor(), _off, _len, POSIX_FADV_WILLNEED) == 0;
+#else
+    return true;
+#endif
+}
+
 //-- File ----------------------------------------
 
 FileDevice::FileDevice()
@@ -404,7 +423,9 @@ ErrorCodeT last_socket_error()
 
 SocketDevice::SocketDevice(SocketDevice&& _sd) noexcept
     : Device(std::move(_sd))
+    , non_blocking_(_sd.non_blocking_)
 {
+    _sd.non_blocking_ = false;
 #ifndef SOLID_HAS_DEBUG
 #ifdef SOLID_ON_WINDOWS
     static const wsa_cleaner wsaclean;
@@ -419,6 +440,8 @@ SocketDevice::SocketDevice()
 SocketDevice& SocketDevice::operator=(SocketDevice&& _dev) noexcept
 {
     *static_cast<Device*>(this) = static_cast<Device&&>(_dev);
+    non_blocking_               = _dev.non_blocking_;
+    _dev.non_blocking_          = false;
     return *this;
 }
 
@@ -475,6 +498,7 @@ void SocketDevice::close()
     shutdownReadWrite();
     Device::close();
 #endif
+    non_blocking_ = false;
 }
 
 ErrorCodeT SocketDevice::create(const ResolveIterator& _rri)
@@ -489,6 +513,7 @@ ErrorCodeT SocketDevice::create(const ResolveIterator& _rri)
 #else
     Device::descriptor(socket(_rri.family(), _rri.type(), _rri.protocol()));
 #endif
+    non_blocking_ = false;
     return ok() ? ErrorCodeT() : last_socket_error();
 }
 
@@ -504,6 +529,7 @@ ErrorCodeT SocketDevice::create(
 #else
     Device::descriptor(socket(_family, _type, _proto));
 #endif
+    non_blocking_ = false;
     return ok() ? ErrorCodeT() : last_socket_error();
 }
 
@@ -603,9 +629,11 @@ ErrorCodeT SocketDevice::accept(SocketDevice& _dev, bool& _rcan_retry)
 
     return rv > 0 ? ErrorCodeT() : last_socket_error();
 #else
-    const int rv = ::accept(descriptor(), nullptr, nullptr);
+    // the accepted socket is already non-blocking - saves the fcntl calls of makeNonBlocking
+    const int rv = ::accept4(descriptor(), nullptr, nullptr, SOCK_NONBLOCK);
     _rcan_retry  = (errno == EAGAIN || errno == ENETDOWN || errno == EPROTO || errno == ENOPROTOOPT || errno == EHOSTDOWN || errno == ENONET || errno == EHOSTUNREACH || errno == EOPNOTSUPP || errno == ENETUNREACH);
     _dev.Device::descriptor(rv);
+    _dev.non_blocking_ = rv > 0;
 
     return rv > 0 ? ErrorCodeT() : last_socket_error();
 #endif
@@ -622,6 +650,7 @@ ErrorCodeT SocketDevice::accept(SocketDevice& _dev)
 #else
     int rv = ::accept(descriptor(), nullptr, nullptr);
     _dev.Device::descriptor(rv);
+    _dev.non_blocking_ = false;
     return rv > 0 ? ErrorCodeT() : last_socket_error();
 #endif
 }
@@ -656,6 +685,7 @@ ErrorCodeT SocketDevice::makeBlocking()
     if (rv < 0) {
         return last_socket_error();
     }
+    non_blocking_ = false;
     return ErrorCodeT();
 #endif
 }
@@ -689,6 +719,7 @@ ErrorCodeT SocketDevice::makeBlocking(size_t _msec)
     if (rv < 0) {
         return last_socket_error();
     }
+    non_blocking_ = false;
     struct timeval timeout;
     timeout.tv_sec  = _msec / 1000;
     timeout.tv_usec = _msec % 1000;
@@ -715,12 +746,16 @@ ErrorCodeT SocketDevice::makeNonBlocking()
     }
     return last_socket_error();
 #else
+    if (non_blocking_) {
+        return ErrorCodeT();
+    }
     int flg = fcntl(descriptor(), F_GETFL);
     if (flg == -1) {
         return last_socket_error();
     }
     int rv = fcntl(descriptor(), F_SETFL, flg | O_NONBLOCK);
     if (rv >= 0) {
+        non_blocking_ = true;
         return ErrorCodeT();
     }
     return last_socket_error();
@@ -771,6 +806,97 @@ ssize_t SocketDevice::send(const char* _pb, size_t _ul, bool& _rcan_retry, Error
     return rv;
 #endif
 }
+ssize_t SocketDevice::sendv(const ConstBuffer* _pbufs, size_t _count, bool& _rcan_retry, ErrorCodeT& _rerr, const bool _zero_copy)
+{
+    constexpr size_t iov_capacity = 64;
+#ifdef SOLID_ON_WINDOWS
+    WSABUF buffers[iov_capacity];
+    DWORD  bytes_sent = 0;
+
+    if (_count > iov_capacity) {
+        _count = iov_capacity;
+    }
+    for (size_t i = 0; i < _count; ++i) {
+        buffers[i].len = static_cast<ULONG>(_pbufs[i].size_);
+        buffers[i].buf = const_cast<char*>(_pbufs[i].data_);
+    }
+    const int status = WSASend(descriptor(), buffers, static_cast<DWORD>(_count), &bytes_sent, 0, NULL, NULL);
+    _rcan_retry      = (WSAGetLastError() == WSAEWOULDBLOCK);
+    _rerr            = last_socket_error();
+    if (status == 0) {
+        return bytes_sent;
+    }
+    return -1;
+#else
+    struct iovec  iov[iov_capacity];
+    struct msghdr msg;
+
+    if (_count > iov_capacity) {
+        _count = iov_capacity;
+    }
+    for (size_t i = 0; i < _count; ++i) {
+        iov[i].iov_base = const_cast<char*>(_pbufs[i].data_);
+        iov[i].iov_len  = _pbufs[i].size_;
+    }
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov    = iov;
+    msg.msg_iovlen = _count;
+
+    int flags = 0;
+#if defined(MSG_ZEROCOPY)
+    if (_zero_copy) {
+        flags = MSG_ZEROCOPY;
+    }
+#else
+    (void)_zero_copy;
+#endif
+    ssize_t rv  = ::sendmsg(descriptor(), &msg, flags);
+    _rcan_retry = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr       = last_socket_error();
+    return rv;
+#endif
+}
+
+bool SocketDevice::recvZeroCopyCompletion(uint32_t& _rlo, uint32_t& _rhi, ErrorCodeT& _rerr)
+{
+#if defined(SOLID_ON_LINUX) && defined(SO_EE_ORIGIN_ZEROCOPY)
+    char          control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    struct msghdr msg;
+
+    while (true) {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+
+        const ssize_t rv = ::recvmsg(descriptor(), &msg, MSG_ERRQUEUE);
+
+        if (rv < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                _rerr = last_socket_error();
+            }
+            return false;
+        }
+
+        for (struct cmsghdr* pcm = CMSG_FIRSTHDR(&msg); pcm != nullptr; pcm = CMSG_NXTHDR(&msg, pcm)) {
+            if (!((pcm->cmsg_level == SOL_IP && pcm->cmsg_type == IP_RECVERR) || (pcm->cmsg_level == SOL_IPV6 && pcm->cmsg_type == IPV6_RECVERR))) {
+                continue;
+            }
+            const sock_extended_err* pee = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(pcm));
+            if (pee->ee_errno == 0 && pee->ee_origin == SO_EE_ORIGIN_ZEROCOPY) {
+                _rlo = pee->ee_info;
+                _rhi = pee->ee_data;
+                return true;
+            }
+        }
+        // not a zero-copy notification - skip it
+    }
+#else
+    (void)_rlo;
+    (void)_rhi;
+    (void)_rerr;
+    return false;
+#endif
+}
 ssize_t SocketDevice::recv(char* _pb, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr, unsigned)
 {
 #ifdef SOLID_ON_WINDOWS
@@ -832,6 +958,134 @@ ssize_t SocketDevice::recv(char* _pb, size_t _ul, SocketAddress& _rsa, bool& _rc
 #endif
 }
 
+ssize_t SocketDevice::recvMany(DatagramBuffer* _pbufs, size_t _count, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+#if defined(SOLID_ON_LINUX)
+    constexpr size_t msg_capacity = 64;
+    struct mmsghdr   msgs[msg_capacity];
+    struct iovec     iov[msg_capacity];
+    alignas(cmsghdr) char control[msg_capacity][CMSG_SPACE(sizeof(int))];
+
+    if (_count > msg_capacity) {
+        _count = msg_capacity;
+    }
+    memset(msgs, 0, sizeof(mmsghdr) * _count);
+    for (size_t i = 0; i < _count; ++i) {
+        DatagramBuffer& rbuf = _pbufs[i];
+        iov[i].iov_base      = rbuf.data_;
+        iov[i].iov_len       = rbuf.capacity_;
+        rbuf.address_.clear();
+
+        msghdr& rhdr        = msgs[i].msg_hdr;
+        rhdr.msg_name       = rbuf.address_.sockAddr();
+        rhdr.msg_namelen    = SocketAddress::Capacity;
+        rhdr.msg_iov        = &iov[i];
+        rhdr.msg_iovlen     = 1;
+        rhdr.msg_control    = control[i];
+        rhdr.msg_controllen = sizeof(control[i]);
+    }
+
+    const int rv = ::recvmmsg(descriptor(), msgs, static_cast<unsigned>(_count), 0, nullptr);
+    _rcan_retry  = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr        = last_socket_error();
+
+    for (int i = 0; i < rv; ++i) {
+        DatagramBuffer& rbuf = _pbufs[i];
+        rbuf.size_           = msgs[i].msg_len;
+        rbuf.segment_size_   = 0;
+        rbuf.address_.sz     = msgs[i].msg_hdr.msg_namelen;
+#if defined(UDP_GRO)
+        for (cmsghdr* pcmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); pcmsg != nullptr; pcmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, pcmsg)) {
+            if (pcmsg->cmsg_level == SOL_UDP && pcmsg->cmsg_type == UDP_GRO) {
+                int segment_size;
+                memcpy(&segment_size, CMSG_DATA(pcmsg), sizeof(segment_size));
+                rbuf.segment_size_ = segment_size;
+            }
+        }
+#endif
+    }
+    return rv;
+#else
+    ssize_t count = 0;
+    for (; count < static_cast<ssize_t>(_count); ++count) {
+        DatagramBuffer& rbuf = _pbufs[count];
+        const ssize_t   rv   = recv(rbuf.data_, rbuf.capacity_, rbuf.address_, _rcan_retry, _rerr);
+        if (rv < 0) {
+            break;
+        }
+        rbuf.size_         = rv;
+        rbuf.segment_size_ = 0;
+    }
+    return count != 0 ? count : -1;
+#endif
+}
+
+ssize_t SocketDevice::sendMany(const DatagramBuffer* _pbufs, size_t _count, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+#if defined(SOLID_ON_LINUX)
+    constexpr size_t msg_capacity = 64;
+    struct mmsghdr   msgs[msg_capacity];
+    struct iovec     iov[msg_capacity];
+    alignas(cmsghdr) char control[msg_capacity][CMSG_SPACE(sizeof(uint16_t))];
+
+    if (_count > msg_capacity) {
+        _count = msg_capacity;
+    }
+    memset(msgs, 0, sizeof(mmsghdr) * _count);
+    for (size_t i = 0; i < _count; ++i) {
+        const DatagramBuffer& rbuf = _pbufs[i];
+        iov[i].iov_base            = rbuf.data_;
+        iov[i].iov_len             = rbuf.size_;
+
+        msghdr& rhdr = msgs[i].msg_hdr;
+        if (!rbuf.address_.empty()) {
+            rhdr.msg_name    = const_cast<sockaddr*>(rbuf.address_.sockAddr());
+            rhdr.msg_namelen = rbuf.address_.size();
+        }
+        rhdr.msg_iov    = &iov[i];
+        rhdr.msg_iovlen = 1;
+
+        if (rbuf.segment_size_ != 0) {
+#if defined(UDP_SEGMENT)
+            rhdr.msg_control    = control[i];
+            rhdr.msg_controllen = sizeof(control[i]);
+
+            cmsghdr* pcmsg         = CMSG_FIRSTHDR(&rhdr);
+            pcmsg->cmsg_level      = SOL_UDP;
+            pcmsg->cmsg_type       = UDP_SEGMENT;
+            pcmsg->cmsg_len        = CMSG_LEN(sizeof(uint16_t));
+            const uint16_t segment = static_cast<uint16_t>(rbuf.segment_size_);
+            memcpy(CMSG_DATA(pcmsg), &segment, sizeof(segment));
+#else
+            _rcan_retry = false;
+            _rerr       = solid::error_not_implemented;
+            return -1;
+#endif
+        }
+    }
+
+    const int rv = ::sendmmsg(descriptor(), msgs, static_cast<unsigned>(_count), 0);
+    _rcan_retry  = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr        = last_socket_error();
+    return rv;
+#else
+    ssize_t count = 0;
+    for (; count < static_cast<ssize_t>(_count); ++count) {
+        const DatagramBuffer& rbuf = _pbufs[count];
+        if (rbuf.segment_size_ != 0) {
+            _rcan_retry = false;
+            _rerr       = solid::error_not_implemented;
+            break;
+        }
+        const ssize_t rv = rbuf.address_.empty() ? send(rbuf.data_, rbuf.size_, _rcan_retry, _rerr) : send(rbuf.data_, rbuf.size_, rbuf.address_, _rcan_retry, _rerr);
+        if (rv < 0) {
+            break;
+        }
+    }
+    return count != 0 ? count : -1;
+#endif
+}
+
 ErrorCodeT SocketDevice::remoteAddress(SocketAddress& _rsa) const
 {
 #ifdef SOLID_ON_WINDOWS
@@ -926,6 +1180,64 @@ ErrorCodeT SocketDevice::enableLoopbackFastPath()
 #endif
 }
 
+ErrorCodeT SocketDevice::enableReusePort()
+{
+#if defined(SO_REUSEPORT) && !defined(SOLID_ON_WINDOWS)
+    int flag = 1;
+    int rv   = setsockopt(descriptor(), SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<char*>(&flag), sizeof(flag));
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return last_socket_error();
+#else
+    return solid::error_not_implemented;
+#endif
+}
+
+ErrorCodeT SocketDevice::incomingCpu(int& _rrv) const
+{
+#if defined(SOLID_ON_LINUX) && defined(SO_INCOMING_CPU)
+    socklen_t sz = sizeof(_rrv);
+    int       rv = getsockopt(descriptor(), SOL_SOCKET, SO_INCOMING_CPU, &_rrv, &sz);
+    if (rv == 0 && _rrv >= 0) {
+        return ErrorCodeT();
+    }
+    _rrv = -1;
+    return rv == 0 ? solid::error_not_implemented : last_socket_error();
+#else
+    _rrv = -1;
+    return solid::error_not_implemented;
+#endif
+}
+
+ErrorCodeT SocketDevice::enableUdpGro()
+{
+#if defined(SOLID_ON_LINUX) && defined(UDP_GRO)
+    int flag = 1;
+    int rv   = setsockopt(descriptor(), SOL_UDP, UDP_GRO, &flag, sizeof(flag));
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return last_socket_error();
+#else
+    return solid::error_not_implemented;
+#endif
+}
+
+ErrorCodeT SocketDevice::enableZeroCopy()
+{
+#if defined(SOLID_ON_LINUX) && defined(SO_ZEROCOPY)
+    int flag = 1;
+    int rv   = setsockopt(descriptor(), SOL_SOCKET, SO_ZEROCOPY, reinterpret_cast<char*>(&flag), sizeof(flag));
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return last_socket_error();
+#else
+    return solid::error_not_implemented;
+#endif
+}
+
 ErrorCodeT SocketDevice::enableNoDelay()
 {
 #if defined(SOLID_ON_WINDOWS)
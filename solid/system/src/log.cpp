@@ -16,12 +16,17 @@
 #include "solid/system/socketaddress.hpp"
 #include "solid/system/socketdevice.hpp"
 #include <chrono>
+#include <condition_variable>
 #include <cstring>
 #include <iostream>
 #include <mutex>
 #include <regex>
 #include <sstream>
 #include <thread>
+#include <vector>
+#ifndef SOLID_ON_WINDOWS
+#include <sys/uio.h>
+#endif
 
 using namespace std;
 using namespace std::chrono;
@@ -33,17 +38,90 @@ std::ostream& operator<<(std::ostream& _ros, const LogLineBase& _line)
     return _line.writeTo(_ros);
 }
 
+namespace {
+
+class RingStreamBuffer : public std::streambuf {
+    char*        pbuf_;
+    const size_t capacity_;
+    size_t       offset_;
+
+public:
+    RingStreamBuffer(char* _pbuf, const size_t _capacity, const size_t _offset)
+        : pbuf_(_pbuf)
+        , capacity_(_capacity)
+        , offset_(_offset)
+    {
+    }
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (c != EOF) {
+            const char z = static_cast<char>(c);
+            offset_      = impl::log_ring_copy(pbuf_, capacity_, offset_, &z, 1);
+        }
+        return c;
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize num) override
+    {
+        offset_ = impl::log_ring_copy(pbuf_, capacity_, offset_, s, static_cast<size_t>(num));
+        return num;
+    }
+};
+
+struct LogLineView : LogLineBase {
+    const std::string_view view_;
+
+    LogLineView(const std::string_view& _view)
+        : view_(_view)
+    {
+    }
+
+    std::ostream& writeTo(std::ostream& _ros) const override
+    {
+        return _ros.write(view_.data(), view_.size());
+    }
+    size_t size() const override
+    {
+        return view_.size();
+    }
+};
+
+} // namespace
+
 LogLineBase::~LogLineBase() {}
 
+void LogLineBase::copyTo(char* _pbuf, const size_t _capacity, size_t _offset) const
+{
+    RingStreamBuffer buf(_pbuf, _capacity, _offset);
+    std::ostream     os(&buf);
+    writeTo(os);
+}
+
 LogRecorder::~LogRecorder() {}
 
 void LogRecorder::recordLine(const solid::LogLineBase& /*_rlog_line*/) {}
 
+void LogRecorder::recordBatch(const std::string_view* _pbuffers, const size_t _count)
+{
+    for (size_t i = 0; i < _count; ++i) {
+        recordLine(LogLineView(_pbuffers[i]));
+    }
+}
+
 void LogStreamRecorder::recordLine(const solid::LogLineBase& _rlog_line)
 {
     _rlog_line.writeTo(ros_);
 }
 
+void LogStreamRecorder::recordBatch(const std::string_view* _pbuffers, const size_t _count)
+{
+    for (size_t i = 0; i < _count; ++i) {
+        ros_.write(_pbuffers[i].data(), _pbuffers[i].size());
+    }
+}
+
 namespace {
 
 enum {
@@ -99,6 +177,74 @@ const ErrorConditionT error_no_server(ErrorNoServerE, category);
 const ErrorConditionT error_file_open(ErrorFileOpenE, category);
 const ErrorConditionT error_path(ErrorPathE, category);
 
+//-----------------------------------------------------------------------------
+//  device_write_all - vectored write of a flusher batch
+//-----------------------------------------------------------------------------
+
+bool device_write_all(Device& _rdev, const std::string_view* _pbuffers, const size_t _count, uint64_t& _rsz)
+{
+#ifdef SOLID_ON_WINDOWS
+    for (size_t i = 0; i < _count; ++i) {
+        const char* pdata = _pbuffers[i].data();
+        size_t      size  = _pbuffers[i].size();
+        while (size != 0) {
+            const ssize_t written = _rdev.write(pdata, size);
+            if (written < 0) {
+                return false;
+            }
+            pdata += written;
+            size -= written;
+            _rsz += written;
+        }
+    }
+    return true;
+#else
+    constexpr size_t iov_capacity = 64;
+    struct iovec     iov[iov_capacity];
+    size_t           index  = 0;
+    size_t           offset = 0; // offset within _pbuffers[index]
+
+    while (index < _count) {
+        size_t iov_count = 0;
+        for (size_t i = index; i < _count && iov_count < iov_capacity; ++i) {
+            const size_t off = (i == index) ? offset : 0;
+            if (_pbuffers[i].size() != off) {
+                iov[iov_count].iov_base = const_cast<char*>(_pbuffers[i].data() + off);
+                iov[iov_count].iov_len  = _pbuffers[i].size() - off;
+                ++iov_count;
+            }
+        }
+        if (iov_count == 0) {
+            break;
+        }
+        ssize_t written = ::writev(_rdev.descriptor(), iov, static_cast<int>(iov_count));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        _rsz += written;
+        while (written != 0 && index < _count) {
+            const size_t left = _pbuffers[index].size() - offset;
+            if (static_cast<size_t>(written) < left) {
+                offset += written;
+                written = 0;
+            } else {
+                written -= left;
+                ++index;
+                offset = 0;
+            }
+        }
+        while (index < _count && _pbuffers[index].size() == offset) {
+            ++index;
+            offset = 0;
+        }
+    }
+    return true;
+#endif
+}
+
 //-----------------------------------------------------------------------------
 //  DeviceBasicStream
 //-----------------------------------------------------------------------------
@@ -121,6 +267,11 @@ public:
         std::swap(_rdev, dev_);
     }
 
+    bool writeBatch(const std::string_view* _pbuffers, const size_t _count)
+    {
+        return device_write_all(dev_, _pbuffers, _count, rsz_);
+    }
+
 protected:
     bool writeAll(const char* _s, size_t _n)
     {
@@ -187,6 +338,11 @@ public:
     {
         buf.swapDevice(_rdev);
     }
+
+    bool writeBatch(const std::string_view* _pbuffers, const size_t _count)
+    {
+        return buf.writeBatch(_pbuffers, _count);
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -216,6 +372,12 @@ public:
         std::swap(_rdev, dev_);
     }
 
+    bool writeBatch(const std::string_view* _pbuffers, const size_t _count)
+    {
+        // the flusher batch is already large - write it through
+        return flush() && device_write_all(dev_, _pbuffers, _count, rsz_);
+    }
+
 protected:
     // write one character
     int_type overflow(int_type c) override;
@@ -316,9 +478,15 @@ public:
     {
         buf.swapDevice(_rdev);
     }
+
+    bool writeBatch(const std::string_view* _pbuffers, const size_t _count)
+    {
+        return buf.writeBatch(_pbuffers, _count);
+    }
 };
 
 struct SocketRecorder : LogRecorder {
+    bool              buffered_; // set by stream(), before ros_ is initialized
     uint64_t          current_size_;
     DeviceBasicStream unbuffered_stream_;
     DeviceStream      buffered_stream_;
@@ -326,6 +494,7 @@ struct SocketRecorder : LogRecorder {
 
     std::ostream& stream(const bool _buffered, SocketDevice&& _rsd)
     {
+        buffered_ = _buffered;
         if (_buffered) {
             buffered_stream_.device(std::move(_rsd));
             return buffered_stream_;
@@ -358,6 +527,15 @@ struct SocketRecorder : LogRecorder {
     {
         _rlog_line.writeTo(ros_);
     }
+
+    void recordBatch(const std::string_view* _pbuffers, const size_t _count) override
+    {
+        if (buffered_) {
+            buffered_stream_.writeBatch(_pbuffers, _count);
+        } else {
+            unbuffered_stream_.writeBatch(_pbuffers, _count);
+        }
+    }
 };
 
 #ifdef SOLID_ON_WINDOWS
@@ -394,6 +572,7 @@ void splitPrefix(string& _path, string& _name, const char* _prefix)
 }
 
 struct FileRecorder : LogRecorder {
+    bool              buffered_; // set by stream(), before ros_ is initialized
     uint64_t          current_size_;
     DeviceBasicStream unbuffered_stream_;
     DeviceStream      buffered_stream_;
@@ -405,6 +584,7 @@ struct FileRecorder : LogRecorder {
 
     std::ostream& stream(const bool _buffered, FileDevice&& _rsd)
     {
+        buffered_ = _buffered;
         if (_buffered) {
             buffered_stream_.device(std::move(_rsd));
             return buffered_stream_;
@@ -519,12 +699,71 @@ struct FileRecorder : LogRecorder {
         }
         _rlog_line.writeTo(ros_);
     }
+
+    void recordBatch(const std::string_view* _pbuffers, const size_t _count) override
+    {
+        size_t size = 0;
+        for (size_t i = 0; i < _count; ++i) {
+            size += _pbuffers[i].size();
+        }
+        if (shouldRespin(size)) {
+            doRespin();
+        }
+        if (buffered_) {
+            buffered_stream_.writeBatch(_pbuffers, _count);
+        } else {
+            unbuffered_stream_.writeBatch(_pbuffers, _count);
+        }
+    }
 };
 
 //-----------------------------------------------------------------------------
 //  Engine
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+//  LogRing - single producer (the logging thread) single consumer (the flusher)
+//-----------------------------------------------------------------------------
+
+struct LogRing {
+    const size_t            capacity_;
+    std::unique_ptr<char[]> buf_;
+    alignas(64) std::atomic<uint64_t> head_{0}; // written by the producer
+    alignas(64) std::atomic<uint64_t> tail_{0}; // written by the flusher
+    std::atomic_bool closed_{false};            // the producer thread has exited
+
+    LogRing(const size_t _capacity)
+        : capacity_(_capacity)
+        , buf_(new char[_capacity])
+    {
+    }
+
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed);
+    }
+};
+
+using LogRingPtrT = std::shared_ptr<LogRing>;
+
+struct LocalLogRing {
+    LogRingPtrT ring_ptr_;
+    uint64_t    generation_ = 0;
+
+    ~LocalLogRing()
+    {
+        if (ring_ptr_) {
+            ring_ptr_->closed_.store(true, std::memory_order_release);
+        }
+    }
+};
+
+LocalLogRing& local_log_ring()
+{
+    static thread_local LocalLogRing lr;
+    return lr;
+}
+
 class Engine {
     struct ModuleStub {
         LoggerBase*            plgr_;
@@ -553,11 +792,36 @@ class Engine {
     using StringPairVectorT = std::vector<StringPairT>;
     using ModuleVectorT     = std::vector<ModuleStub>;
 
+    using RingVectorT       = std::vector<LogRingPtrT>;
+
+    struct FlushStub {
+        RingVectorT                   ring_vec_;
+        std::vector<std::string_view> view_vec_;
+        std::vector<uint64_t>         head_vec_;
+    };
+
     mutex             mtx_;
     StringPairVectorT module_mask_vec_;
     ModuleVectorT     module_vec_;
     LogRecorderPtrT   recorder_ptr_;
 
+    // asynchronous mode
+    mutex                 async_mtx_;
+    condition_variable    async_cnd_;
+    RingVectorT           ring_vec_;
+    std::thread           flusher_thr_;
+    LogAsyncConfiguration async_config_;
+    std::atomic<uint64_t> async_generation_{0}; // 0 - synchronous
+    uint64_t              last_generation_ = 0;
+    bool                  flusher_stop_    = false;
+    bool                  flusher_wake_    = false;
+    std::atomic<uint64_t> dropped_line_count_{0};
+    std::atomic<uint64_t> dropped_size_{0};
+    std::atomic<uint64_t> blocked_line_count_{0};
+    std::atomic<uint64_t> oversized_line_count_{0};
+    std::atomic<uint64_t> flush_count_{0};
+    std::atomic<uint64_t> flushed_size_{0};
+
 public:
     static Engine& the()
     {
@@ -583,8 +847,14 @@ public:
 
     ErrorConditionT configure(LogRecorderPtrT&& _recorder_ptr, const std::vector<std::string>& _rmodule_mask_vec);
 
+    ErrorConditionT asyncStart(const LogAsyncConfiguration& _config);
+    void            asyncStop();
+
+    LogAsyncStatistic asyncStatistic() const;
+
     void close()
     {
+        asyncStop();
         lock_guard<mutex> lock(mtx_);
         recorder_ptr_ = std::make_shared<LogRecorder>();
     }
@@ -592,6 +862,12 @@ public:
 private:
     void doConfigureMasks(const std::vector<std::string>& _rmodule_mask_vec);
     void doConfigureModule(size_t _idx);
+
+    bool     doAsyncLog(const LogLineBase& _log_ros);
+    LogRing* doAsyncRing();
+    void     doAsyncWakeFlusher();
+    void     doFlusherRun();
+    size_t   doFlush(FlushStub& _rflush);
 };
 
 size_t Engine::registerLogger(LoggerBase& _rlg, const LogCategoryBase& _rlc)
@@ -612,10 +888,213 @@ void Engine::unregisterLogger(const size_t _idx)
 
 void Engine::log(const size_t /*_idx*/, const LogLineBase& _log_ros)
 {
+    if (async_generation_.load(std::memory_order_acquire) != 0 && doAsyncLog(_log_ros)) {
+        return;
+    }
     std::lock_guard<std::mutex> lock(mtx_);
     recorder_ptr_->recordLine(_log_ros);
 }
 
+LogRing* Engine::doAsyncRing()
+{
+    auto&      rlocal     = local_log_ring();
+    const auto generation = async_generation_.load(std::memory_order_acquire);
+
+    if (rlocal.generation_ == generation && rlocal.ring_ptr_) {
+        return rlocal.ring_ptr_.get();
+    }
+
+    lock_guard<mutex> lock(async_mtx_);
+    if (generation != async_generation_.load(std::memory_order_relaxed) || generation == 0) {
+        return nullptr;
+    }
+    if (rlocal.ring_ptr_) {
+        rlocal.ring_ptr_->closed_.store(true, std::memory_order_release);
+    }
+    rlocal.ring_ptr_   = std::make_shared<LogRing>(async_config_.ring_capacity_);
+    rlocal.generation_ = generation;
+    ring_vec_.emplace_back(rlocal.ring_ptr_);
+    return rlocal.ring_ptr_.get();
+}
+
+void Engine::doAsyncWakeFlusher()
+{
+    {
+        lock_guard<mutex> lock(async_mtx_);
+        flusher_wake_ = true;
+    }
+    async_cnd_.notify_one();
+}
+
+//! Returns false if the line must be recorded synchronously
+bool Engine::doAsyncLog(const LogLineBase& _log_ros)
+{
+    LogRing* pring = doAsyncRing();
+
+    if (pring == nullptr) {
+        return false;
+    }
+
+    const size_t size = _log_ros.size();
+
+    if (size > pring->capacity_) {
+        oversized_line_count_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const uint64_t head    = pring->head_.load(std::memory_order_relaxed);
+    bool           blocked = false;
+
+    while ((head - pring->tail_.load(std::memory_order_acquire)) + size > pring->capacity_) {
+        if (async_config_.policy_ == LogAsyncPolicyE::Drop) {
+            dropped_line_count_.fetch_add(1, std::memory_order_relaxed);
+            dropped_size_.fetch_add(size, std::memory_order_relaxed);
+            return true;
+        }
+        if (!blocked) {
+            blocked = true;
+            blocked_line_count_.fetch_add(1, std::memory_order_relaxed);
+            doAsyncWakeFlusher();
+        }
+        if (async_generation_.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+
+    _log_ros.copyTo(pring->buf_.get(), pring->capacity_, static_cast<size_t>(head % pring->capacity_));
+
+    pring->head_.store(head + size, std::memory_order_release);
+
+    const uint64_t used = head + size - pring->tail_.load(std::memory_order_relaxed);
+
+    if (used > pring->capacity_ / 2 && (used - size) <= pring->capacity_ / 2) {
+        // just crossed the half mark - do not wait for the flush period
+        doAsyncWakeFlusher();
+    }
+    return true;
+}
+
+ErrorConditionT Engine::asyncStart(const LogAsyncConfiguration& _config)
+{
+    asyncStop();
+
+    lock_guard<mutex> lock(async_mtx_);
+    async_config_ = _config;
+    if (async_config_.ring_capacity_ < 1024) {
+        async_config_.ring_capacity_ = 1024;
+    }
+    flusher_stop_ = false;
+    flusher_wake_ = false;
+    ++last_generation_;
+    async_generation_.store(last_generation_, std::memory_order_release);
+    flusher_thr_ = std::thread([this]() { doFlusherRun(); });
+    return ErrorConditionT();
+}
+
+void Engine::asyncStop()
+{
+    {
+        lock_guard<mutex> lock(async_mtx_);
+        if (!flusher_thr_.joinable()) {
+            return;
+        }
+        async_generation_.store(0, std::memory_order_release);
+        flusher_stop_ = true;
+    }
+    async_cnd_.notify_one();
+    flusher_thr_.join();
+
+    lock_guard<mutex> lock(async_mtx_);
+    ring_vec_.clear();
+}
+
+void Engine::doFlusherRun()
+{
+    FlushStub flush;
+    bool      stop = false;
+
+    while (!stop) {
+        {
+            unique_lock<mutex> lock(async_mtx_);
+            async_cnd_.wait_for(lock, async_config_.flush_period_, [this]() { return flusher_stop_ || flusher_wake_; });
+            flusher_wake_ = false;
+            stop          = flusher_stop_;
+
+            // forget the rings of the exited threads once they were drained
+            ring_vec_.erase(
+                std::remove_if(ring_vec_.begin(), ring_vec_.end(), [](const LogRingPtrT& _ring_ptr) {
+                    return _ring_ptr->closed_.load(std::memory_order_acquire) && _ring_ptr->empty();
+                }),
+                ring_vec_.end());
+            flush.ring_vec_ = ring_vec_;
+        }
+
+        doFlush(flush);
+    }
+    // on stop, give the producers that were already committing a line a chance to finish
+    do {
+        std::this_thread::yield();
+    } while (doFlush(flush) != 0);
+}
+
+size_t Engine::doFlush(FlushStub& _rflush)
+{
+    _rflush.view_vec_.clear();
+    _rflush.head_vec_.clear();
+
+    size_t total_size = 0;
+
+    for (auto& ring_ptr : _rflush.ring_vec_) {
+        auto&          rring = *ring_ptr;
+        const uint64_t tail  = rring.tail_.load(std::memory_order_relaxed);
+        const uint64_t head  = rring.head_.load(std::memory_order_acquire);
+
+        _rflush.head_vec_.emplace_back(head);
+
+        if (head == tail) {
+            continue;
+        }
+
+        const size_t offset = static_cast<size_t>(tail % rring.capacity_);
+        const size_t size   = static_cast<size_t>(head - tail);
+        const size_t first  = std::min(size, rring.capacity_ - offset);
+
+        _rflush.view_vec_.emplace_back(rring.buf_.get() + offset, first);
+        if (first != size) {
+            _rflush.view_vec_.emplace_back(rring.buf_.get(), size - first);
+        }
+        total_size += size;
+    }
+
+    if (total_size != 0) {
+        {
+            lock_guard<mutex> lock(mtx_);
+            recorder_ptr_->recordBatch(_rflush.view_vec_.data(), _rflush.view_vec_.size());
+        }
+        flush_count_.fetch_add(1, std::memory_order_relaxed);
+        flushed_size_.fetch_add(total_size, std::memory_order_relaxed);
+
+        // release the space only after the recorder is done with it
+        for (size_t i = 0; i < _rflush.ring_vec_.size(); ++i) {
+            _rflush.ring_vec_[i]->tail_.store(_rflush.head_vec_[i], std::memory_order_release);
+        }
+    }
+    return total_size;
+}
+
+LogAsyncStatistic Engine::asyncStatistic() const
+{
+    LogAsyncStatistic stat;
+    stat.dropped_line_count_   = dropped_line_count_.load(std::memory_order_relaxed);
+    stat.dropped_size_         = dropped_size_.load(std::memory_order_relaxed);
+    stat.blocked_line_count_   = blocked_line_count_.load(std::memory_order_relaxed);
+    stat.oversized_line_count_ = oversized_line_count_.load(std::memory_order_relaxed);
+    stat.flush_count_          = flush_count_.load(std::memory_order_relaxed);
+    stat.flushed_size_         = flushed_size_.load(std::memory_order_relaxed);
+    return stat;
+}
+
 ErrorConditionT Engine::configure(LogRecorderPtrT&& _recorder_ptr, const std::vector<std::string>& _rmodule_mask_vec)
 {
     lock_guard<mutex> lock(mtx_);
@@ -827,6 +1306,32 @@ void log_stop()
     Engine::the().close();
 }
 
+ErrorConditionT log_async_start(const LogAsyncConfiguration& _config)
+{
+    return Engine::the().asyncStart(_config);
+}
+
+void log_async_stop()
+{
+    Engine::the().asyncStop();
+}
+
+LogAsyncStatistic log_async_statistic()
+{
+    return Engine::the().asyncStatistic();
+}
+
+std::ostream& operator<<(std::ostream& _ros, const LogAsyncStatistic& _rstat)
+{
+    _ros << "dropped_line_count = " << _rstat.dropped_line_count_;
+    _ros << " dropped_size = " << _rstat.dropped_size_;
+    _ros << " blocked_line_count = " << _rstat.blocked_line_count_;
+    _ros << " oversized_line_count = " << _rstat.oversized_line_count_;
+    _ros << " flush_count = " << _rstat.flush_count_;
+    _ros << " flushed_size = " << _rstat.flushed_size_;
+    return _ros;
+}
+
 ErrorConditionT log_start(LogRecorderPtrT&& _rec_ptr, const std::vector<std::string>& _rmodule_mask_vec)
 {
     return Engine::the().configure(std::move(_rec_ptr), _rmodule_mask_vec);
@@ -0,0 +1,99 @@
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+solid::LoggerT logger{"test"};
+
+size_t run_threads(const size_t _thread_count, const size_t _line_count)
+{
+    vector<thread> thr_vec;
+    for (size_t t = 0; t < _thread_count; ++t) {
+        thr_vec.emplace_back([t, _line_count]() {
+            for (size_t i = 0; i < _line_count; ++i) {
+                solid_log(logger, Info, "thread " << t << " line " << i);
+            }
+        });
+    }
+    for (auto& thr : thr_vec) {
+        thr.join();
+    }
+    return _thread_count * _line_count;
+}
+
+} // namespace
+
+int test_log_async(int argc, char* argv[])
+{
+    const size_t thread_count = 4;
+    const size_t line_count   = 10000;
+
+    {
+        // Block policy: nothing is lost and per thread order is kept
+        ostringstream oss;
+
+        solid::log_start(std::make_shared<solid::LogStreamRecorder>(std::ref(oss)), {"test:VIEW"});
+        solid::log_async_start(solid::LogAsyncConfiguration().ringCapacity(4 * 1024).policy(solid::LogAsyncPolicyE::Block));
+
+        const size_t total = run_threads(thread_count, line_count);
+
+        solid::log_async_stop();
+
+        const auto stat = solid::log_async_statistic();
+        cout << "block: " << stat << endl;
+
+        const string s{oss.str()};
+        solid_check(static_cast<size_t>(std::count(s.begin(), s.end(), '\n')) == total, "lines lost");
+
+        for (size_t t = 0; t < thread_count; ++t) {
+            size_t pos = 0;
+            for (size_t i = 0; i < line_count; i += 997) {
+                ostringstream line;
+                line << "thread " << t << " line " << i << '\n';
+                const auto new_pos = s.find(line.str(), pos);
+                solid_check(new_pos != string::npos, "line out of order: " << line.str());
+                pos = new_pos;
+            }
+        }
+        solid_check(stat.dropped_line_count_ == 0, "dropped lines on Block policy");
+    }
+
+    {
+        // Drop policy: recorded + dropped == logged
+        ostringstream oss;
+
+        solid::log_start(std::make_shared<solid::LogStreamRecorder>(std::ref(oss)), {"test:VIEW"});
+
+        const auto before = solid::log_async_statistic();
+
+        solid::log_async_start(solid::LogAsyncConfiguration().ringCapacity(1024).flushPeriod(std::chrono::milliseconds(100)));
+
+        const size_t total = run_threads(thread_count, line_count);
+
+        solid::log_async_stop();
+
+        const auto   stat    = solid::log_async_statistic();
+        const string s{oss.str()};
+        const size_t dropped = stat.dropped_line_count_ - before.dropped_line_count_;
+        cout << "drop: " << stat << endl;
+
+        solid_check(static_cast<size_t>(std::count(s.begin(), s.end(), '\n')) + dropped == total, "lines lost");
+    }
+
+    {
+        // back to synchronous mode
+        ostringstream oss;
+
+        solid::log_start(std::make_shared<solid::LogStreamRecorder>(std::ref(oss)), {"test:VIEW"});
+        solid_log(logger, Info, "synchronous line");
+        solid_check(oss.str().find("synchronous line") != string::npos, "line not recorded synchronously");
+    }
+    solid::log_stop();
+    return 0;
+}
@@ -6,6 +6,7 @@
 
 #include "solid/system/common.hpp"
 #include "solid/system/pimpl.hpp"
+#include "solid/system/statistic.hpp"
 
 namespace solid {
 
@@ -22,6 +23,7 @@ struct SharedBufferData {
     std::size_t              size_     = 0;
     std::size_t              capacity_ = 0;
     char*                    buffer_   = nullptr;
+    void*                    powner_   = nullptr; // the BufferManager slab for pooled buffers
     char                     data_[8];
 
     SharedBufferData()
@@ -226,6 +228,27 @@ public:
     }
 
     SharedBuffer& operator=(MutableSharedBuffer&& _other);
+
+    //! Release the buffer unless this is the last reference to it
+    /*!
+     * Returns the buffer if this was its last reference, an empty buffer otherwise.
+     * Unlike checking useCount() == 1 before reset(), it is safe when other
+     * threads release their references at the same time.
+     */
+    SharedBuffer collapse()
+    {
+        if (*this) {
+            std::size_t use_count = pdata_->use_count_.load();
+            while (use_count > 1) {
+                if (pdata_->use_count_.compare_exchange_weak(use_count, use_count - 1)) {
+                    pdata_ = &sentinel;
+                    return {};
+                }
+            }
+            return std::move(*this);
+        }
+        return {};
+    }
 };
 
 inline SharedBuffer make_shared_buffer(const std::size_t _cap)
@@ -346,14 +369,14 @@ public:
     MutableSharedBuffer collapse()
     {
         if (*this) {
-            size_t previous_use_count = 0;
-            auto   buf                = pdata_->release(previous_use_count);
-            if (buf) {
-                pdata_->acquire();
-                return MutableSharedBuffer(std::move(*this));
-            } else {
-                pdata_ = &sentinel;
+            std::size_t use_count = pdata_->use_count_.load();
+            while (use_count > 1) {
+                if (pdata_->use_count_.compare_exchange_weak(use_count, use_count - 1)) {
+                    pdata_ = &sentinel;
+                    return {};
+                }
             }
+            return MutableSharedBuffer(std::move(*this));
         }
         return {};
     }
@@ -411,7 +434,18 @@ inline SharedBuffer::SharedBuffer(MutableSharedBuffer&& _other)
 //-----------------------------------------------------------------------------
 // BufferManager
 //-----------------------------------------------------------------------------
-
+//! Per thread size-class slab pools for SharedBuffers
+/*!
+ * Every thread calling make/makeMutable (e.g. every aio reactor thread) owns a pool.
+ * Capacities are rounded up to size classes (quarter steps between powers of two)
+ * and buffers are carved from slabs - mmap-ed arenas, optionally backed by
+ * transparent huge pages.
+ * A buffer released on its maker thread goes back to the slab's free list.
+ * A buffer released on another thread (e.g. a relayed buffer) is pushed on the
+ * maker pool's lock-free return stack, drained by the maker on its next allocation.
+ * Once the free buffers of a size class exceed the class's local max count,
+ * completely unused slabs are given back to the system.
+ */
 class BufferManager : NonCopyable {
     friend class impl::SharedBufferData;
     friend class impl::SharedBufferBase;
@@ -427,7 +461,24 @@ public:
     struct LocalData;
 
     struct Configuration {
-        size_t default_local_max_count_ = 0;
+        size_t default_local_max_count_ = 0; // per size class free buffers high-water, 0 - unlimited
+        size_t slab_size_               = 512 * 1024;
+        size_t max_pooled_capacity_     = 16 * 1024 * 1024; // bigger buffers are not pooled
+        bool   use_huge_pages_          = false;
+    };
+
+    struct LocalStatistic : solid::Statistic {
+        uint64_t allocate_count_       = 0;
+        uint64_t reuse_count_          = 0;
+        uint64_t unpooled_count_       = 0;
+        uint64_t remote_release_count_ = 0;
+        uint64_t slab_allocate_count_  = 0;
+        uint64_t slab_trim_count_      = 0;
+        size_t   slab_count_           = 0;
+        size_t   max_slab_count_       = 0;
+        size_t   slab_bytes_           = 0;
+
+        std::ostream& print(std::ostream& _ros) const override;
     };
 
     static BufferManager& instance(const Configuration* _pconfig = nullptr);
@@ -446,6 +497,9 @@ public:
     static size_t localMaxCount(const size_t _cap);
     static size_t localCount(const size_t _cap);
 
+    //! Statistic of the calling thread's pool
+    static LocalStatistic localStatistic();
+
     static const Configuration& configuration();
 
 private:
@@ -1,7 +1,13 @@
-
 #include "solid/utility/sharedbuffer.hpp"
+#include <algorithm>
+#include <bit>
 #include <new>
-#include <unordered_map>
+#include <vector>
+
+#if defined(SOLID_ON_WINDOWS)
+#else
+#include <sys/mman.h>
+#endif
 
 namespace solid {
 
@@ -22,13 +28,52 @@ inline constexpr std::size_t compute_capacity(const std::size_t _cap)
         return (sum - (sum % allign)) + allign;
     }
 }
+
+constexpr std::size_t min_class_capacity = 256;
+constexpr std::size_t block_align        = 64;
+constexpr std::size_t page_size          = 4 * 1024;
+constexpr std::size_t huge_page_size     = 2 * 1024 * 1024;
+
+inline constexpr std::size_t align_up(const std::size_t _sz, const std::size_t _align)
+{
+    return (_sz + _align - 1) & ~(_align - 1);
+}
+
+// size classes: 256 then four steps between consecutive powers of two: 320, 384, 448, 512, 640, ...
+inline constexpr std::size_t class_index(const std::size_t _cap)
+{
+    if (_cap <= min_class_capacity) {
+        return 0;
+    }
+    const std::size_t bits    = std::bit_width(_cap - 1); // 2^bits >= _cap > 2^(bits - 1)
+    const std::size_t base    = std::size_t{1} << (bits - 1);
+    const std::size_t step    = base >> 2;
+    const std::size_t quarter = (_cap - base + step - 1) / step; // 1..4
+    return 1 + (bits - 9) * 4 + (quarter - 1);
+}
+
+inline constexpr std::size_t class_capacity(const std::size_t _idx)
+{
+    if (_idx == 0) {
+        return min_class_capacity;
+    }
+    const std::size_t bits    = 9 + (_idx - 1) / 4;
+    const std::size_t quarter = (_idx - 1) % 4 + 1;
+    return (std::size_t{1} << (bits - 1)) + quarter * (std::size_t{1} << (bits - 3));
+}
+
+static_assert(class_capacity(class_index(257)) == 320);
+static_assert(class_capacity(class_index(512)) == 512);
+static_assert(class_capacity(class_index(513)) == 640);
+static_assert(class_capacity(class_index(64 * 1024)) == 64 * 1024);
+
 } // namespace
 
 namespace impl {
 char* SharedBufferData::release(size_t& _previous_use_count)
 {
     if ((_previous_use_count = use_count_.fetch_sub(1)) == 1) {
-        if (make_thread_id_ == std::thread::id{}) {
+        if (powner_ == nullptr) {
             return buffer_;
         } else {
             return BufferManager::release(this);
@@ -59,67 +104,345 @@ SharedBufferBase::SharedBufferBase(const std::size_t _cap, const std::thread::id
     pdata_->make_thread_id_ = _thr_id;
 }
 
-std::size_t SharedBufferBase::actualCapacity() const
-{
-    if (*this) {
-        const std::size_t new_cap = compute_capacity<sizeof(SharedBufferData)>(pdata_->capacity_);
-        return (pdata_->buffer_ + new_cap) - pdata_->data();
-    } else {
-        return 0;
-    }
-}
-
 } // namespace impl
 
 //-----------------------------------------------------------------------------
 
 struct BufferManager::LocalData {
-    struct Entry {
-        impl::SharedBufferData* ptop_      = nullptr;
-        size_t                  max_count_ = BufferManager::configuration().default_local_max_count_;
-        size_t                  count_     = 0;
+    struct Entry;
+
+    struct Slab {
+        LocalData&   rlocal_;
+        Entry&       rentry_;
+        char* const  pbuf_;
+        const size_t size_;
+        const size_t block_size_;
+        const size_t block_count_;
+        size_t       carved_count_ = 0; // blocks handed out at least once
+        size_t       live_count_   = 0;
+        size_t       free_count_   = 0; // carved blocks on the free list
+        DataT*       pfree_        = nullptr;
+        Slab*        pprev_        = nullptr; // Entry::pavailable_ list
+        Slab*        pnext_        = nullptr;
+        Slab*        pprev_all_    = nullptr; // LocalData::pslabs_ list
+        Slab*        pnext_all_    = nullptr;
+
+        Slab(LocalData& _rlocal, Entry& _rentry, char* _pbuf, const size_t _size, const size_t _block_size)
+            : rlocal_(_rlocal)
+            , rentry_(_rentry)
+            , pbuf_(_pbuf)
+            , size_(_size)
+            , block_size_(_block_size)
+            , block_count_(_size / _block_size)
+        {
+        }
 
-        inline bool empty() const noexcept
+        bool available() const noexcept
         {
-            return ptop_ == nullptr;
+            return free_count_ != 0 || carved_count_ != block_count_;
         }
 
-        inline bool full() const noexcept
+        DataT* pop() noexcept
         {
-            return max_count_ != 0 && count_ >= max_count_;
+            DataT* pdata;
+            if (pfree_ != nullptr) {
+                pdata  = pfree_;
+                pfree_ = pdata->pnext_;
+                --free_count_;
+                --rentry_.free_count_;
+            } else {
+                char* pblock   = pbuf_ + carved_count_ * block_size_;
+                pdata          = new (pblock) DataT{pblock};
+                pdata->powner_ = this;
+                ++carved_count_;
+            }
+            ++live_count_;
+            return pdata;
         }
 
-        inline impl::SharedBufferData* pop() noexcept
+        void push(DataT* _pdata) noexcept
+        {
+            _pdata->pnext_ = pfree_;
+            pfree_         = _pdata;
+            ++free_count_;
+            ++rentry_.free_count_;
+            --live_count_;
+        }
+    };
+
+    struct Entry {
+        Slab*  pavailable_ = nullptr;
+        size_t max_count_  = BufferManager::configuration().default_local_max_count_;
+        size_t free_count_ = 0;
+
+        void link(Slab* _pslab) noexcept
         {
-            if (!empty()) {
-                auto* ptmp = ptop_;
-                ptop_      = ptop_->pnext_;
-                --count_;
-                return ptmp;
+            _pslab->pprev_ = nullptr;
+            _pslab->pnext_ = pavailable_;
+            if (pavailable_ != nullptr) {
+                pavailable_->pprev_ = _pslab;
             }
-            return nullptr;
+            pavailable_ = _pslab;
         }
 
-        inline void push(impl::SharedBufferData* _pnode) noexcept
+        void unlink(Slab* _pslab) noexcept
         {
-            if (_pnode) {
-                _pnode->pnext_ = ptop_;
-                ptop_          = _pnode;
-                ++count_;
+            if (_pslab->pprev_ != nullptr) {
+                _pslab->pprev_->pnext_ = _pslab->pnext_;
+            } else {
+                pavailable_ = _pslab->pnext_;
+            }
+            if (_pslab->pnext_ != nullptr) {
+                _pslab->pnext_->pprev_ = _pslab->pprev_;
             }
+            _pslab->pprev_ = _pslab->pnext_ = nullptr;
+        }
+
+        bool full() const noexcept
+        {
+            return max_count_ != 0 && free_count_ > max_count_;
         }
     };
 
-    using CapacityMapT = std::unordered_map<size_t, Entry>;
-    CapacityMapT entry_map_;
+    const Configuration& rconfig_;
+    std::vector<Entry>   entries_;
+    Slab*                pslabs_ = nullptr;
+    LocalStatistic       statistic_;
+    size_t               live_count_           = 0; // pooled buffers not yet returned to this pool
+    uint64_t             remote_release_count_ = 0;
+    std::atomic<DataT*>  return_top_{nullptr};
+    std::atomic<int64_t> balance_{0};
+
+    LocalData(const Configuration& _rconfig)
+        : rconfig_(_rconfig)
+        , entries_(_rconfig.max_pooled_capacity_ < min_class_capacity ? 0 : class_index(_rconfig.max_pooled_capacity_) + 1)
+    {
+    }
+
+    ~LocalData()
+    {
+        while (pslabs_ != nullptr) {
+            Slab* pslab = pslabs_;
+            pslabs_     = pslab->pnext_all_;
+            freeSlab(pslab);
+        }
+    }
+
+    DataT* allocate(const size_t _cap);
+
+    void release(DataT* _pdata) noexcept;
+
+    void remoteRelease(DataT* _pdata) noexcept
+    {
+        DataT* ptop = return_top_.load(std::memory_order_relaxed);
+        do {
+            _pdata->pnext_ = ptop;
+        } while (!return_top_.compare_exchange_weak(ptop, _pdata, std::memory_order_release, std::memory_order_relaxed));
+
+        if (balance_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this; // the maker thread has already exited
+        }
+    }
+
+    void drain() noexcept
+    {
+        DataT* pdata = return_top_.exchange(nullptr, std::memory_order_acquire);
+        while (pdata != nullptr) {
+            DataT* pnext = pdata->pnext_;
+            release(pdata);
+            ++remote_release_count_;
+            ++statistic_.remote_release_count_;
+            pdata = pnext;
+        }
+    }
+
+    //! Called on thread exit - the last one between this and remoteRelease deletes the pool
+    void close() noexcept
+    {
+        drain();
+        const auto count = static_cast<int64_t>(live_count_ + remote_release_count_);
+        if (balance_.fetch_add(count, std::memory_order_acq_rel) + count == 0) {
+            delete this;
+        }
+    }
+
+private:
+    Slab* allocateSlab(Entry& _rentry, const size_t _block_size);
+    void  freeSlab(Slab* _pslab) noexcept;
 };
 
 namespace {
 
-thread_local BufferManager::LocalData local_data;
+thread_local BufferManager::LocalData* plocal_data  = nullptr;
+thread_local bool                      local_closed = false;
+
+struct LocalGuard {
+    ~LocalGuard()
+    {
+        local_closed = true;
+        if (plocal_data != nullptr) {
+            auto* ptmp  = plocal_data;
+            plocal_data = nullptr;
+            ptmp->close();
+        }
+    }
+};
+
+thread_local LocalGuard local_guard;
+
+BufferManager::LocalData* local_data()
+{
+    if (plocal_data == nullptr && !local_closed) [[unlikely]] {
+        (void)&local_guard; // odr-use so that the pool is closed on thread exit
+        plocal_data = new BufferManager::LocalData(BufferManager::configuration());
+    }
+    return plocal_data;
+}
 
 } // namespace
 
+BufferManager::LocalData::Slab* BufferManager::LocalData::allocateSlab(Entry& _rentry, const size_t _block_size)
+{
+    size_t size = std::max(rconfig_.slab_size_, _block_size * 4);
+    char*  pbuf = nullptr;
+#if defined(SOLID_ON_WINDOWS)
+    size = align_up(size, page_size);
+    pbuf = new (std::nothrow) char[size];
+#else
+    if (rconfig_.use_huge_pages_) {
+        size = align_up(size, huge_page_size);
+        // over-map to get a huge page aligned arena then unmap the excess
+        void* pmem = mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (pmem != MAP_FAILED) {
+            char*        pstart = static_cast<char*>(pmem);
+            const size_t head   = align_up(reinterpret_cast<uintptr_t>(pstart), huge_page_size) - reinterpret_cast<uintptr_t>(pstart);
+            if (head != 0) {
+                munmap(pstart, head);
+            }
+            if (head != huge_page_size) {
+                munmap(pstart + head + size, huge_page_size - head);
+            }
+            pbuf = pstart + head;
+#if defined(MADV_HUGEPAGE)
+            madvise(pbuf, size, MADV_HUGEPAGE);
+#endif
+        }
+    } else {
+        size       = align_up(size, page_size);
+        void* pmem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (pmem != MAP_FAILED) {
+            pbuf = static_cast<char*>(pmem);
+        }
+    }
+#endif
+    if (pbuf == nullptr) {
+        return nullptr;
+    }
+    Slab* pslab       = new Slab(*this, _rentry, pbuf, size, _block_size);
+    pslab->pnext_all_ = pslabs_;
+    if (pslabs_ != nullptr) {
+        pslabs_->pprev_all_ = pslab;
+    }
+    pslabs_ = pslab;
+    _rentry.link(pslab);
+
+    ++statistic_.slab_allocate_count_;
+    ++statistic_.slab_count_;
+    statistic_.slab_bytes_ += size;
+    store_max(statistic_.max_slab_count_, statistic_.slab_count_);
+    return pslab;
+}
+
+void BufferManager::LocalData::freeSlab(Slab* _pslab) noexcept
+{
+    --statistic_.slab_count_;
+    statistic_.slab_bytes_ -= _pslab->size_;
+#if defined(SOLID_ON_WINDOWS)
+    delete[] _pslab->pbuf_;
+#else
+    munmap(_pslab->pbuf_, _pslab->size_);
+#endif
+    delete _pslab;
+}
+
+BufferManager::DataT* BufferManager::LocalData::allocate(const size_t _cap)
+{
+    if (return_top_.load(std::memory_order_relaxed) != nullptr) {
+        drain();
+    }
+
+    const size_t idx = class_index(_cap);
+    if (idx >= entries_.size()) [[unlikely]] {
+        ++statistic_.unpooled_count_;
+        return nullptr;
+    }
+
+    Entry& rentry = entries_[idx];
+    Slab*  pslab  = rentry.pavailable_;
+    if (pslab == nullptr) {
+        pslab = allocateSlab(rentry, align_up(sizeof(DataT) + class_capacity(idx), block_align));
+        if (pslab == nullptr) [[unlikely]] {
+            ++statistic_.unpooled_count_;
+            return nullptr;
+        }
+    } else if (pslab->pfree_ != nullptr) {
+        ++statistic_.reuse_count_;
+    }
+
+    DataT* pdata = pslab->pop();
+    if (!pslab->available()) {
+        rentry.unlink(pslab);
+    }
+    ++live_count_;
+    ++statistic_.allocate_count_;
+    return pdata;
+}
+
+void BufferManager::LocalData::release(DataT* _pdata) noexcept
+{
+    Slab*  pslab  = static_cast<Slab*>(_pdata->powner_);
+    Entry& rentry = pslab->rentry_;
+
+    if (!pslab->available()) {
+        rentry.link(pslab);
+    }
+    pslab->push(_pdata);
+    --live_count_;
+
+    if (pslab->live_count_ == 0 && rentry.full()) {
+        // trim the high-water: give the completely unused slab back
+        rentry.unlink(pslab);
+        rentry.free_count_ -= pslab->free_count_;
+
+        if (pslab->pprev_all_ != nullptr) {
+            pslab->pprev_all_->pnext_all_ = pslab->pnext_all_;
+        } else {
+            pslabs_ = pslab->pnext_all_;
+        }
+        if (pslab->pnext_all_ != nullptr) {
+            pslab->pnext_all_->pprev_all_ = pslab->pprev_all_;
+        }
+        ++statistic_.slab_trim_count_;
+        freeSlab(pslab);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+std::ostream& BufferManager::LocalStatistic::print(std::ostream& _ros) const
+{
+    _ros << " allocate_count = " << allocate_count_;
+    _ros << " reuse_count = " << reuse_count_;
+    _ros << " unpooled_count = " << unpooled_count_;
+    _ros << " remote_release_count = " << remote_release_count_;
+    _ros << " slab_allocate_count = " << slab_allocate_count_;
+    _ros << " slab_trim_count = " << slab_trim_count_;
+    _ros << " slab_count = " << slab_count_;
+    _ros << " max_slab_count = " << max_slab_count_;
+    _ros << " slab_bytes = " << slab_bytes_;
+    return _ros;
+}
+
 struct BufferManager::Data {
     const Configuration config_;
 
@@ -146,25 +469,23 @@ BufferManager::~BufferManager() {}
 /* static */ char* BufferManager::release(DataT* _pdata)
 {
     if (_pdata) {
-        if (_pdata->make_thread_id_ == std::this_thread::get_id()) {
-            const std::size_t new_cap = compute_capacity<sizeof(DataT)>(_pdata->capacity_);
-            auto&             entry   = local_data.entry_map_[new_cap];
-
-            if (!entry.full()) {
-                entry.push(_pdata);
-                return nullptr;
-            }
+        auto& rlocal = static_cast<LocalData::Slab*>(_pdata->powner_)->rlocal_;
+        if (&rlocal == plocal_data) {
+            rlocal.release(_pdata);
+        } else {
+            rlocal.remoteRelease(_pdata);
         }
-        return _pdata->buffer_;
     }
     return nullptr;
 }
 
 /* static */ BufferManager::DataT* BufferManager::allocate(const size_t _cap)
 {
-    const std::size_t new_cap = compute_capacity<sizeof(DataT)>(_cap);
-    auto&             entry   = local_data.entry_map_[new_cap];
-    auto*             pdata   = entry.pop();
+    auto* plocal = local_data();
+    if (plocal == nullptr) [[unlikely]] {
+        return nullptr;
+    }
+    auto* pdata = plocal->allocate(_cap);
     if (pdata) {
         pdata->use_count_.store(1);
         pdata->size_     = 0;
@@ -176,20 +497,39 @@ BufferManager::~BufferManager() {}
 
 /* static */ void BufferManager::localMaxCount(const size_t _cap, const size_t _count)
 {
-    const std::size_t new_cap                 = compute_capacity<sizeof(DataT)>(_cap);
-    local_data.entry_map_[new_cap].max_count_ = _count;
+    auto*        plocal = local_data();
+    const size_t idx    = class_index(_cap);
+    if (plocal != nullptr && idx < plocal->entries_.size()) {
+        plocal->entries_[idx].max_count_ = _count;
+    }
 }
 
 /* static */ size_t BufferManager::localMaxCount(const size_t _cap)
 {
-    const std::size_t new_cap = compute_capacity<sizeof(DataT)>(_cap);
-    return local_data.entry_map_[new_cap].max_count_;
+    auto*        plocal = local_data();
+    const size_t idx    = class_index(_cap);
+    if (plocal != nullptr && idx < plocal->entries_.size()) {
+        return plocal->entries_[idx].max_count_;
+    }
+    return 0;
 }
 
 /* static */ size_t BufferManager::localCount(const size_t _cap)
 {
-    const std::size_t new_cap = compute_capacity<sizeof(DataT)>(_cap);
-    return local_data.entry_map_[new_cap].count_;
+    auto*        plocal = local_data();
+    const size_t idx    = class_index(_cap);
+    if (plocal != nullptr && idx < plocal->entries_.size()) {
+        return plocal->entries_[idx].free_count_;
+    }
+    return 0;
+}
+
+/* static */ BufferManager::LocalStatistic BufferManager::localStatistic()
+{
+    if (plocal_data != nullptr) {
+        return plocal_data->statistic_;
+    }
+    return {};
 }
 
 /* static */ const BufferManager::Configuration& BufferManager::configuration()
@@ -197,4 +537,22 @@ BufferManager::~BufferManager() {}
     return instance().pimpl_->config_;
 }
 
-} // namespace solid
\ No newline at end of file
+namespace impl {
+
+std::size_t SharedBufferBase::actualCapacity() const
+{
+    if (*this) {
+        if (pdata_->powner_ != nullptr) {
+            const auto* pslab = static_cast<const BufferManager::LocalData::Slab*>(pdata_->powner_);
+            return (pdata_->buffer_ + pslab->block_size_) - pdata_->data();
+        }
+        const std::size_t new_cap = compute_capacity<sizeof(SharedBufferData)>(pdata_->capacity_);
+        return (pdata_->buffer_ + new_cap) - pdata_->data();
+    } else {
+        return 0;
+    }
+}
+
+} // namespace impl
+
+} // namespace solid
@@ -0,0 +1,142 @@
+#include "solid/system/exception.hpp"
+#include "solid/utility/sharedbuffer.hpp"
+#include <chrono>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+namespace {
+
+template <class MakeF>
+uint64_t measure(MakeF _make, const size_t _count)
+{
+    const auto          start = chrono::steady_clock::now();
+    deque<SharedBuffer> dq;
+    for (size_t i = 0; i < _count; ++i) {
+        dq.emplace_back(_make(i));
+        dq.back().data()[0] = static_cast<char>(i);
+        if (dq.size() > 64) {
+            dq.pop_front();
+        }
+    }
+    return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int test_buffer_pool(int argc, char* argv[])
+{
+    constexpr size_t buffer_capacity = 64 * 1024;
+    { // size classes
+        for (size_t cap = 1; cap < 200000; cap += 777) {
+            SharedBuffer sb = BufferManager::make(cap);
+            solid_check(sb.capacity() == cap);
+            solid_check(sb.actualCapacity() >= cap && sb.actualCapacity() <= cap + cap / 4 + 320, cap << " " << sb.actualCapacity());
+        }
+        SharedBuffer sb1 = BufferManager::make(1000);
+        const void*  p1  = sb1.data();
+        sb1.reset();
+        SharedBuffer sb2 = BufferManager::make(1020); // same size class
+        solid_check(p1 == sb2.data());
+    }
+    { // slabs and high-water trimming
+        const auto stat_begin = BufferManager::localStatistic();
+
+        BufferManager::localMaxCount(buffer_capacity, 4);
+        solid_check(BufferManager::localMaxCount(buffer_capacity) == 4);
+
+        vector<SharedBuffer> buf_vec;
+        for (size_t i = 0; i < 200; ++i) {
+            buf_vec.emplace_back(BufferManager::make(buffer_capacity));
+        }
+        const auto stat_full = BufferManager::localStatistic();
+        cout << "full: " << stat_full << endl;
+        solid_check(stat_full.slab_count_ > stat_begin.slab_count_);
+        solid_check(BufferManager::localCount(buffer_capacity) == 0);
+
+        buf_vec.clear();
+
+        const auto stat_trim = BufferManager::localStatistic();
+        cout << "trimmed: " << stat_trim << endl;
+        solid_check(stat_trim.slab_trim_count_ > stat_full.slab_trim_count_);
+        solid_check(stat_trim.slab_count_ < stat_full.slab_count_);
+        solid_check(BufferManager::localCount(buffer_capacity) <= 4 + BufferManager::configuration().slab_size_ / buffer_capacity);
+        BufferManager::localMaxCount(buffer_capacity, 0);
+    }
+    { // buffers released on other threads go back to the maker's pool
+        const auto stat_begin = BufferManager::localStatistic();
+
+        mutex               mtx;
+        deque<SharedBuffer> dq;
+        bool                done = false;
+        vector<thread>      thr_vec;
+        for (size_t i = 0; i < 4; ++i) {
+            thr_vec.emplace_back([&]() {
+                while (true) {
+                    SharedBuffer sb;
+                    {
+                        lock_guard<mutex> lock(mtx);
+                        if (!dq.empty()) {
+                            sb = std::move(dq.front());
+                            dq.pop_front();
+                        } else if (done) {
+                            break;
+                        }
+                    }
+                    if (sb) {
+                        solid_check(sb.data()[0] == 'x');
+                    } else {
+                        this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (size_t i = 0; i < 100000; ++i) {
+            SharedBuffer sb = BufferManager::make(4096);
+            sb.data()[0]    = 'x';
+            lock_guard<mutex> lock(mtx);
+            dq.emplace_back(std::move(sb));
+        }
+        {
+            lock_guard<mutex> lock(mtx);
+            done = true;
+        }
+        for (auto& t : thr_vec) {
+            t.join();
+        }
+        SharedBuffer sb   = BufferManager::make(4096); // drains the return stack
+        const auto   stat = BufferManager::localStatistic();
+        cout << "remote: " << stat << endl;
+        solid_check(stat.remote_release_count_ - stat_begin.remote_release_count_ >= 100000 - 1);
+        solid_check(stat.reuse_count_ > stat_begin.reuse_count_);
+    }
+    { // a maker thread exiting before its buffers are released
+        vector<SharedBuffer> buf_vec;
+        thread               thr([&buf_vec]() {
+            for (size_t i = 0; i < 100; ++i) {
+                buf_vec.emplace_back(BufferManager::make(1000 + i * 100));
+            }
+            buf_vec.pop_back();
+        });
+        thr.join();
+        for (auto& sb : buf_vec) {
+            solid_check(sb.useCount() == 1);
+            sb.data()[0] = 'y';
+        }
+        buf_vec.clear(); // the last release frees the exited thread's pool
+    }
+    { // pooled vs plain allocation
+        const size_t count = argc > 1 ? atoi(argv[1]) : 1000000;
+
+        const auto plain_us = measure([](size_t) { return make_shared_buffer(buffer_capacity); }, count);
+        const auto pool_us  = measure([](size_t) { return BufferManager::make(buffer_capacity); }, count);
+        cout << "make_shared_buffer: " << plain_us << "us BufferManager::make: " << pool_us << "us for " << count << " buffers" << endl;
+    }
+    return 0;
+}
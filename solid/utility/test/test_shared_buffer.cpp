@@ -1,5 +1,6 @@
 #include "solid/system/exception.hpp"
 #include "solid/utility/sharedbuffer.hpp"
+#include <atomic>
 #include <future>
 #include <iostream>
 #include <thread>
@@ -140,6 +141,30 @@ int test_shared_buffer(int argc, char* argv[])
         cout << "Empty buffer actualCapacity = " << empty_buf.actualCapacity() << endl;
         solid_check(empty_buf.actualCapacity() == 0);
     }
+    {
+        // exactly one of the owners collapsing at the same time gets the buffer
+        for (size_t i = 0; i < 100; ++i) {
+            SharedBuffer   sb = make_shared_buffer(100);
+            atomic<size_t> collapsed_count{0};
+            vector<thread> thr_vec;
+
+            for (size_t j = 0; j < 4; ++j) {
+                thr_vec.emplace_back([&collapsed_count, sbc = sb]() mutable {
+                    if (sbc.collapse()) {
+                        ++collapsed_count;
+                    }
+                    solid_check(!sbc);
+                });
+            }
+            if (sb.collapse()) {
+                ++collapsed_count;
+            }
+            for (auto& t : thr_vec) {
+                t.join();
+            }
+            solid_check(collapsed_count == 1);
+        }
+    }
     {
         SharedBuffer zero_buf = make_shared_buffer(0);
         solid_check(zero_buf.capacity() == 0);
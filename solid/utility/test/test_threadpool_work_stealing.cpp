@@ -0,0 +1,124 @@
+#include "solid/system/crashhandler.hpp"
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/utility/function.hpp"
+#include "solid/utility/threadpool.hpp"
+#include <atomic>
+#include <future>
+#include <iostream>
+#include <vector>
+
+using namespace solid;
+using namespace std;
+namespace {
+const LoggerT logger("test_work_stealing");
+
+struct Context;
+using CallPoolT = ThreadPool<Function<void(Context&)>, Function<void(Context&)>>;
+
+struct Context {
+    CallPoolT*     ppool_ = nullptr;
+    atomic<size_t> leaf_count_{0};
+    atomic<size_t> all_count_{0};
+    atomic<size_t> synch_count_{0};
+};
+
+void fan_out(Context& _rctx, const size_t _depth)
+{
+    if (_depth == 0) {
+        ++_rctx.leaf_count_;
+        return;
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        _rctx.ppool_->pushOne([_depth](Context& _rctx) { fan_out(_rctx, _depth - 1); });
+    }
+}
+
+struct SynchContext {
+    CallPoolT::SynchronizationContextT ctx_;
+    size_t                             next_ = 0;
+    bool                               ok_   = true;
+};
+
+} // namespace
+
+int test_threadpool_work_stealing(int argc, char* argv[])
+{
+    install_crash_handler();
+    solid::log_start(std::cerr, {".*:EWXS", "test_work_stealing:VIEWS"});
+
+    int          wait_seconds = 300;
+    int          loop_cnt     = 5;
+    size_t       thread_count = 4;
+    const size_t depth        = 7; // 4^7 leaves
+    const size_t leaf_count   = 1 << (2 * depth);
+    const size_t synch_count  = 16;
+    const size_t synch_steps  = 1000;
+
+    if (argc > 1) {
+        thread_count = atoi(argv[1]);
+    }
+
+    auto lambda = [&]() {
+        for (int i = 0; i < loop_cnt; ++i) {
+            Context              ctx;
+            vector<SynchContext> synch_contexts(synch_count);
+            {
+                CallPoolT wp{
+                    ThreadPoolConfiguration{thread_count}.mode(ThreadPoolModeE::WorkStealing).localCapacity(256), [](const size_t, Context&) {}, [](const size_t, Context& _rctx) {},
+                    std::ref(ctx)};
+
+                ctx.ppool_ = &wp;
+
+                for (auto& sc : synch_contexts) {
+                    sc.ctx_ = wp.createSynchronizationContext();
+                }
+
+                wp.pushOne([depth](Context& _rctx) { fan_out(_rctx, depth); });
+
+                // tasks pushed on a synchronization context from within a worker
+                //  must still be executed in order
+                wp.pushOne([&synch_contexts, synch_steps](Context&) {
+                    for (size_t s = 0; s < synch_steps; ++s) {
+                        for (auto& sc : synch_contexts) {
+                            sc.ctx_.push([&sc, s](Context& _rctx) {
+                                if (sc.next_ != s) {
+                                    sc.ok_ = false;
+                                }
+                                ++sc.next_;
+                                ++_rctx.synch_count_;
+                            });
+                        }
+                    }
+                });
+
+                for (size_t j = 0; j < 100; ++j) {
+                    wp.pushAll([](Context& _rctx) { ++_rctx.all_count_; });
+                }
+
+                while (ctx.leaf_count_ != leaf_count || ctx.synch_count_ != synch_count * synch_steps) {
+                    this_thread::sleep_for(chrono::milliseconds(10));
+                }
+                for (auto& sc : synch_contexts) {
+                    sc.ctx_.clear();
+                }
+                solid_log(logger, Statistic, "ThreadPool statistic: " << wp.statistic());
+            }
+            solid_check(ctx.leaf_count_ == leaf_count, ctx.leaf_count_ << " != " << leaf_count);
+            solid_check(ctx.all_count_ == 100 * thread_count, ctx.all_count_ << " != " << 100 * thread_count);
+            for (const auto& sc : synch_contexts) {
+                solid_check(sc.ok_ && sc.next_ == synch_steps, "synchronization context out of order " << sc.next_);
+            }
+            solid_log(logger, Verbose, "after loop");
+        }
+    };
+
+    auto fut = async(launch::async, lambda);
+    if (fut.wait_for(chrono::seconds(wait_seconds)) != future_status::ready) {
+        solid_throw(" Test is taking too long - waited " << wait_seconds << " secs");
+    }
+    fut.get();
+    solid_log(logger, Verbose, "after async wait");
+
+    return 0;
+}
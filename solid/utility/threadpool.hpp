@@ -55,6 +55,10 @@ struct ThreadPoolStatistic : solid::Statistic {
     std::atomic_uint_fast64_t push_one_latency_min_us_     = {0};
     std::atomic_uint_fast64_t push_one_latency_max_us_     = {0};
     std::atomic_uint_fast64_t push_one_latency_sum_us_     = {0};
+    std::atomic_uint_fast64_t push_one_local_count_        = {0};
+    std::atomic_uint_fast64_t run_one_local_count_         = {0};
+    std::atomic_uint_fast64_t run_one_steal_count_         = {0};
+    std::atomic_uint_fast64_t wake_idle_count_             = {0};
 
     ThreadPoolStatistic();
 
@@ -139,6 +143,22 @@ struct ThreadPoolStatistic : solid::Statistic {
     {
         ++push_all_wait_pushing_count_;
     }
+    void pushOneLocal()
+    {
+        ++push_one_local_count_;
+    }
+    void runOneLocal()
+    {
+        ++run_one_local_count_;
+    }
+    void runOneSteal()
+    {
+        ++run_one_steal_count_;
+    }
+    void wakeIdle()
+    {
+        ++wake_idle_count_;
+    }
 
     std::ostream& print(std::ostream& _ros) const override;
     void          clear();
@@ -165,19 +185,31 @@ struct EmptyThreadPoolStatistic : solid::Statistic {
     void popOneWaitPopping() {}
     void pushAllWaitLock() {}
     void pushAllWaitPushing() {}
+    void pushOneLocal() {}
+    void runOneLocal() {}
+    void runOneSteal() {}
+    void wakeIdle() {}
 
     std::ostream& print(std::ostream& _ros) const override { return _ros; }
     void          clear() {}
 };
 
+enum struct ThreadPoolModeE : uint8_t {
+    Shared,       //!< all TaskOne go through the shared lock-free ring
+    WorkStealing, //!< TaskOne pushed from worker threads go to per-worker deques
+};
+
 struct ThreadPoolConfiguration {
-    static constexpr size_t default_one_capacity = 8 * 1024;
-    static constexpr size_t default_all_capacity = 1024;
+    static constexpr size_t default_one_capacity   = 8 * 1024;
+    static constexpr size_t default_all_capacity   = 1024;
+    static constexpr size_t default_local_capacity = 1024;
 
-    size_t thread_count_ = 1;
-    size_t one_capacity_ = default_one_capacity;
-    size_t all_capacity_ = default_all_capacity;
-    size_t spin_count_   = 1;
+    size_t          thread_count_   = 1;
+    size_t          one_capacity_   = default_one_capacity;
+    size_t          all_capacity_   = default_all_capacity;
+    size_t          spin_count_     = 1;
+    ThreadPoolModeE mode_           = ThreadPoolModeE::Shared;
+    size_t          local_capacity_ = default_local_capacity;
 
     ThreadPoolConfiguration(
         const size_t _thread_count = 1,
@@ -212,6 +244,18 @@ struct ThreadPoolConfiguration {
         spin_count_ = _value;
         return *this;
     }
+
+    auto& mode(const ThreadPoolModeE _value)
+    {
+        mode_ = _value;
+        return *this;
+    }
+
+    auto& localCapacity(const size_t _value)
+    {
+        local_capacity_ = _value;
+        return *this;
+    }
 };
 
 template <class TaskOne, class TaskAll, class Stats = ThreadPoolStatistic>
@@ -617,18 +661,144 @@ private:
             return count == expected_count && id_.load() == _id;
         }
     };
+    struct LocalStub {
+        std::atomic_uint8_t filled_{0};
+        ContextStub*        pcontext_           = nullptr;
+        uint64_t            all_id_             = 0;
+        uint64_t            context_produce_id_ = 0;
+        TaskData<TaskOne>   data_;
+    };
+
+    /*
+    NOTE:
+        Bounded Chase-Lev deque: the owner worker pushes and pops at the bottom,
+        the other workers steal from the top.
+        A slot is reused only after the consumer has moved the task out of it
+        (filled_ == 0), otherwise the deque is considered full and the task
+        goes to the shared ring.
+    */
+    class alignas(hardware_destructive_interference_size) LocalQueue {
+        alignas(hardware_destructive_interference_size) std::atomic_int64_t top_{0};
+        alignas(hardware_destructive_interference_size) std::atomic_int64_t bottom_{0};
+        int64_t                      capacity_ = 0;
+        std::unique_ptr<LocalStub[]> stubs_;
+        uint64_t                     random_state_ = 0;
+
+        LocalStub& stub(const int64_t _index) noexcept
+        {
+            return stubs_[static_cast<size_t>(_index & (capacity_ - 1))];
+        }
+
+        static void take(LocalStub& _rstub, TaskData<TaskOne>& _rtask_data, ContextStub*& _rpctx, uint64_t& _rall_id, uint64_t& _rcontext_produce_id)
+        {
+            _rtask_data.task(std::move(_rstub.data_.task()));
+            _rstub.data_.destroy();
+            _rpctx               = _rstub.pcontext_;
+            _rall_id             = _rstub.all_id_;
+            _rcontext_produce_id = _rstub.context_produce_id_;
+            _rstub.filled_.store(0, std::memory_order_release);
+        }
+
+    public:
+        void init(const size_t _capacity, const uint64_t _seed)
+        {
+            capacity_     = static_cast<int64_t>(std::bit_ceil(std::max(_capacity, size_t(2))));
+            random_state_ = _seed | 1;
+            stubs_.reset(new LocalStub[static_cast<size_t>(capacity_)]);
+        }
+
+        //! Owner only - true if the next push will succeed
+        bool canPush() noexcept
+        {
+            const auto b = bottom_.load(std::memory_order_relaxed);
+            const auto t = top_.load(std::memory_order_acquire);
+            return (b - t) < capacity_ && stub(b).filled_.load(std::memory_order_acquire) == 0;
+        }
+
+        //! Owner only - must be preceded by a successful canPush
+        template <class Tsk>
+        void push(Tsk&& _task, ContextStub* _pctx, const uint64_t _all_id, const uint64_t _context_produce_id)
+        {
+            const auto b     = bottom_.load(std::memory_order_relaxed);
+            auto&      rstub = stub(b);
+
+            rstub.data_.task(std::forward<Tsk>(_task));
+            rstub.pcontext_           = _pctx;
+            rstub.all_id_             = _all_id;
+            rstub.context_produce_id_ = _context_produce_id;
+            rstub.filled_.store(1, std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_release);
+        }
+
+        //! Owner only
+        bool pop(TaskData<TaskOne>& _rtask_data, ContextStub*& _rpctx, uint64_t& _rall_id, uint64_t& _rcontext_produce_id)
+        {
+            const auto b = bottom_.load(std::memory_order_relaxed) - 1;
+            bottom_.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto t = top_.load(std::memory_order_relaxed);
+
+            if (t <= b) {
+                if (t == b) {
+                    // last task - race against the thieves
+                    const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                    bottom_.store(b + 1, std::memory_order_relaxed);
+                    if (!won) {
+                        return false;
+                    }
+                }
+                take(stub(b), _rtask_data, _rpctx, _rall_id, _rcontext_produce_id);
+                return true;
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        bool steal(TaskData<TaskOne>& _rtask_data, ContextStub*& _rpctx, uint64_t& _rall_id, uint64_t& _rcontext_produce_id)
+        {
+            auto t = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto b = bottom_.load(std::memory_order_acquire);
+
+            if (t < b && top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                take(stub(t), _rtask_data, _rpctx, _rall_id, _rcontext_produce_id);
+                return true;
+            }
+            return false;
+        }
+
+        bool empty() const noexcept
+        {
+            return top_.load(std::memory_order_acquire) >= bottom_.load(std::memory_order_acquire);
+        }
+
+        //! Owner only - xorshift for choosing the steal victims
+        uint64_t random() noexcept
+        {
+            random_state_ ^= random_state_ << 13;
+            random_state_ ^= random_state_ >> 7;
+            random_state_ ^= random_state_ << 17;
+            return random_state_;
+        }
+    };
+
+    struct LocalQueueRef {
+        ThreadPool* ppool_  = nullptr;
+        LocalQueue* pqueue_ = nullptr;
+    };
+
     using AllStubT      = AllStub;
     using OneStubT      = OneStub;
     using ThreadVectorT = std::vector<std::thread>;
 
     size_t spin_count_ = 1;
-    /* alignas(hardware_constructive_interference_size) */ struct {
+    struct {
         size_t                               capacity_{0};
         std::unique_ptr<OneStubT[]>          tasks_;
         std::unique_ptr<TaskData<TaskOne>[]> datas_;
     } one_;
 
-    /* alignas(hardware_constructive_interference_size) */ struct {
+    struct {
         size_t                               capacity_{0};
         std::atomic_size_t                   pending_count_{0};
         std::atomic_uint_fast64_t            push_index_{1};
@@ -637,6 +807,15 @@ private:
         std::unique_ptr<TaskData<TaskAll>[]> datas_;
     } all_;
 
+    struct {
+        size_t                        count_{0};
+        std::unique_ptr<LocalQueue[]> queues_;
+        alignas(hardware_destructive_interference_size) std::atomic_size_t idle_count_{0};
+        std::atomic_bool waking_{false};
+    } ws_;
+
+    inline static thread_local LocalQueueRef local_queue_ref_;
+
     Stats statistic_;
     using AtomicIndexT      = std::atomic_size_t;
     using AtomicIndexValueT = std::atomic_size_t::value_type;
@@ -747,6 +926,35 @@ private:
         class AllFnc,
         typename... Args>
     void consumeAll(LocalContext& _rlocal_context, const uint64_t _all_id, AllFnc& _all_fnc, Args&&... _args);
+
+    template <
+        class OneFnc,
+        class AllFnc,
+        typename... Args>
+    void doRunOne(
+        LocalContext&  _rlocal_context,
+        TaskOne&       _rtask,
+        ContextStub*   _pctx,
+        uint64_t       _all_id,
+        uint64_t       _context_produce_id,
+        OneFnc&        _one_fnc,
+        AllFnc&        _all_fnc,
+        Args&&... _args);
+
+    template <
+        class OneFnc,
+        class AllFnc,
+        typename... Args>
+    bool tryRunLocal(
+        const size_t  _thread_index,
+        LocalContext& _rlocal_context,
+        OneFnc&       _one_fnc,
+        AllFnc&       _all_fnc,
+        Args&&... _args);
+
+    bool trySteal(const size_t _thread_index, TaskData<TaskOne>& _rtask_data, ContextStub*& _rpctx, uint64_t& _rall_id, uint64_t& _rcontext_produce_id);
+    bool hasLocalTasks() const;
+    void wakeIdle();
 };
 
 } // namespace tpimpl
@@ -1045,6 +1253,17 @@ void ThreadPool<TaskOne, TaskAll, Stats>::doStart(
 
     spin_count_ = _config.spin_count_;
 
+    if (_config.mode_ == ThreadPoolModeE::WorkStealing) {
+        ws_.count_ = thread_count;
+        ws_.queues_.reset(new LocalQueue[thread_count]);
+        for (size_t i = 0; i < thread_count; ++i) {
+            ws_.queues_[i].init(_config.local_capacity_, (i + 1) * 0x9E3779B97F4A7C15ull);
+        }
+    } else {
+        ws_.count_ = 0;
+        ws_.queues_.reset();
+    }
+
     for (size_t i = 0; i < thread_count; ++i) {
         threads_.emplace_back(
             std::thread{
@@ -1093,10 +1312,28 @@ void ThreadPool<TaskOne, TaskAll, Stats>::doRun(
 {
     LocalContext local_context;
 
+    if (ws_.count_ != 0) {
+        local_queue_ref_.ppool_  = this;
+        local_queue_ref_.pqueue_ = &ws_.queues_[_thread_index];
+    }
+
     while (true) {
-        const auto [index, count]        = popOneIndex();
-        auto&    rstub                   = one_.tasks_[index];
-        uint64_t local_one_context_count = 0;
+        if (ws_.count_ != 0) {
+            if (tryRunLocal(_thread_index, local_context, _one_fnc, _all_fnc, _args...)) {
+                continue;
+            }
+            ws_.idle_count_.fetch_add(1);
+            // NOTE: pairs with the fence in doPushOne - either the pusher sees us
+            //  idle and wakes us or we see its task here.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (hasLocalTasks()) {
+                ws_.idle_count_.fetch_sub(1);
+                continue;
+            }
+        }
+
+        const auto [index, count] = popOneIndex();
+        auto& rstub               = one_.tasks_[index];
 
         const auto event = rstub.waitWhilePop(
             statistic_,
@@ -1114,90 +1351,204 @@ void ThreadPool<TaskOne, TaskAll, Stats>::doRun(
             _all_fnc,
             _args...);
 
+        if (ws_.count_ != 0) {
+            ws_.idle_count_.fetch_sub(1);
+        }
+
         if (event == EventE::Fill) {
-            auto  context_produce_id = rstub.context_produce_id_;
-            auto* pctx               = rstub.pcontext_;
-            auto  all_id             = rstub.all_id_;
-            {
-                TaskOne task{std::move(rstub.task())};
-
-                rstub.destroy();
-                rstub.clear();
-                rstub.notifyWhilePop();
-
-                if (pctx == nullptr) {
-                    consumeAll(local_context, all_id, _all_fnc, _args...);
-
-                    _one_fnc(task, _args...);
-                    ++local_context.one_free_count_;
-                    statistic_.runOneFreeCount(local_context.one_free_count_);
-                    continue;
-                } else if (context_produce_id == pctx->consume_id_.load(std::memory_order_relaxed)) {
-                    consumeAll(local_context, all_id, _all_fnc, _args...);
-
-                    _one_fnc(task, _args...);
-                    ++local_one_context_count;
-                } else {
-                    pctx->spin_.lock();
-                    if (context_produce_id != pctx->consume_id_.load(std::memory_order_relaxed)) {
-                        pctx->push(std::move(task), all_id, context_produce_id);
-                        pctx->spin_.unlock();
-                        ++local_context.one_context_push_count_;
-                        statistic_.runOneContextPush(local_context.one_context_push_count_);
-                        continue;
-                    } else {
-                        pctx->spin_.unlock();
-
-                        consumeAll(local_context, all_id, _all_fnc, _args...);
-
-                        _one_fnc(task, _args...);
-                        ++local_one_context_count;
-                    }
+            const auto context_produce_id = rstub.context_produce_id_;
+            auto*      pctx               = rstub.pcontext_;
+            const auto all_id             = rstub.all_id_;
+            TaskOne    task{std::move(rstub.task())};
+
+            rstub.destroy();
+            rstub.clear();
+            rstub.notifyWhilePop();
+
+            doRunOne(local_context, task, pctx, all_id, context_produce_id, _one_fnc, _all_fnc, _args...);
+        } else if (event == EventE::Wake) {
+            const auto all_id = rstub.all_id_;
+            consumeAll(local_context, all_id, _all_fnc, _args...);
+
+            ++local_context.wake_count_;
+            statistic_.runWakeCount(local_context.wake_count_);
+            rstub.notifyWhilePop();
+            if (ws_.count_ != 0) {
+                ws_.waking_.store(false);
+            }
+        } else if (event == EventE::Stop) {
+            rstub.notifyWhilePop();
+            if (ws_.count_ != 0) {
+                while (tryRunLocal(_thread_index, local_context, _one_fnc, _all_fnc, _args...)) {
                 }
             }
+            break;
+        }
+    }
 
-            context_produce_id = pctx->consume_id_.fetch_add(1) + 1;
+    if (ws_.count_ != 0) {
+        local_queue_ref_ = LocalQueueRef{};
+    }
+}
+//-----------------------------------------------------------------------------
+template <class TaskOne, class TaskAll, class Stats>
+template <
+    class OneFnc,
+    class AllFnc,
+    typename... Args>
+void ThreadPool<TaskOne, TaskAll, Stats>::doRunOne(
+    LocalContext& _rlocal_context,
+    TaskOne&      _rtask,
+    ContextStub*  _pctx,
+    uint64_t      _all_id,
+    uint64_t      _context_produce_id,
+    OneFnc&       _one_fnc,
+    AllFnc&       _all_fnc,
+    Args&&... _args)
+{
+    uint64_t local_one_context_count = 0;
 
-            do {
-                TaskData<TaskOne> task_data;
-                {
-                    SpinGuardT lock{pctx->spin_};
-                    if (pctx->pop(task_data, all_id, context_produce_id)) {
-                    } else {
-                        break;
-                    }
-                }
+    if (_pctx == nullptr) {
+        consumeAll(_rlocal_context, _all_id, _all_fnc, _args...);
 
-                consumeAll(local_context, all_id, _all_fnc, _args...);
+        _one_fnc(_rtask, _args...);
+        ++_rlocal_context.one_free_count_;
+        statistic_.runOneFreeCount(_rlocal_context.one_free_count_);
+        return;
+    } else if (_context_produce_id == _pctx->consume_id_.load(std::memory_order_relaxed)) {
+        consumeAll(_rlocal_context, _all_id, _all_fnc, _args...);
+
+        _one_fnc(_rtask, _args...);
+        ++local_one_context_count;
+    } else {
+        _pctx->spin_.lock();
+        if (_context_produce_id != _pctx->consume_id_.load(std::memory_order_relaxed)) {
+            _pctx->push(std::move(_rtask), _all_id, _context_produce_id);
+            _pctx->spin_.unlock();
+            ++_rlocal_context.one_context_push_count_;
+            statistic_.runOneContextPush(_rlocal_context.one_context_push_count_);
+            return;
+        } else {
+            _pctx->spin_.unlock();
 
-                _one_fnc(task_data.task(), _args...);
+            consumeAll(_rlocal_context, _all_id, _all_fnc, _args...);
 
-                task_data.destroy();
+            _one_fnc(_rtask, _args...);
+            ++local_one_context_count;
+        }
+    }
 
-                context_produce_id = pctx->consume_id_.fetch_add(1) + 1;
-                pctx->release();
-                ++local_one_context_count;
-            } while (true);
+    _context_produce_id = _pctx->consume_id_.fetch_add(1) + 1;
 
-            if (pctx->release()) {
-                delete pctx;
+    do {
+        TaskData<TaskOne> task_data;
+        {
+            SpinGuardT lock{_pctx->spin_};
+            if (_pctx->pop(task_data, _all_id, _context_produce_id)) {
+            } else {
+                break;
             }
+        }
 
-            local_context.one_context_count_ += local_one_context_count;
+        consumeAll(_rlocal_context, _all_id, _all_fnc, _args...);
 
-            statistic_.runOneContextCount(local_one_context_count, local_context.one_context_count_);
-        } else if (event == EventE::Wake) {
-            const auto all_id = rstub.all_id_;
-            consumeAll(local_context, all_id, _all_fnc, _args...);
+        _one_fnc(task_data.task(), _args...);
 
-            ++local_context.wake_count_;
-            statistic_.runWakeCount(local_context.wake_count_);
-            rstub.notifyWhilePop();
-        } else if (event == EventE::Stop) {
-            rstub.notifyWhilePop();
-            break;
+        task_data.destroy();
+
+        _context_produce_id = _pctx->consume_id_.fetch_add(1) + 1;
+        _pctx->release();
+        ++local_one_context_count;
+    } while (true);
+
+    if (_pctx->release()) {
+        delete _pctx;
+    }
+
+    _rlocal_context.one_context_count_ += local_one_context_count;
+
+    statistic_.runOneContextCount(local_one_context_count, _rlocal_context.one_context_count_);
+}
+//-----------------------------------------------------------------------------
+template <class TaskOne, class TaskAll, class Stats>
+template <
+    class OneFnc,
+    class AllFnc,
+    typename... Args>
+bool ThreadPool<TaskOne, TaskAll, Stats>::tryRunLocal(
+    const size_t  _thread_index,
+    LocalContext& _rlocal_context,
+    OneFnc&       _one_fnc,
+    AllFnc&       _all_fnc,
+    Args&&... _args)
+{
+    TaskData<TaskOne> task_data;
+    ContextStub*      pctx;
+    uint64_t          all_id;
+    uint64_t          context_produce_id;
+
+    if (ws_.queues_[_thread_index].pop(task_data, pctx, all_id, context_produce_id)) {
+        statistic_.runOneLocal();
+    } else if (trySteal(_thread_index, task_data, pctx, all_id, context_produce_id)) {
+        statistic_.runOneSteal();
+        // there might be more where this came from
+        wakeIdle();
+    } else {
+        return false;
+    }
+
+    TaskOne task{std::move(task_data.task())};
+    task_data.destroy();
+
+    doRunOne(_rlocal_context, task, pctx, all_id, context_produce_id, _one_fnc, _all_fnc, _args...);
+    return true;
+}
+//-----------------------------------------------------------------------------
+template <class TaskOne, class TaskAll, class Stats>
+bool ThreadPool<TaskOne, TaskAll, Stats>::trySteal(const size_t _thread_index, TaskData<TaskOne>& _rtask_data, ContextStub*& _rpctx, uint64_t& _rall_id, uint64_t& _rcontext_produce_id)
+{
+    if (ws_.count_ < 2) {
+        return false;
+    }
+    const size_t start = static_cast<size_t>(ws_.queues_[_thread_index].random() % ws_.count_);
+    for (size_t i = 0; i < ws_.count_; ++i) {
+        const size_t victim = (start + i) % ws_.count_;
+        if (victim != _thread_index && ws_.queues_[victim].steal(_rtask_data, _rpctx, _rall_id, _rcontext_produce_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+//-----------------------------------------------------------------------------
+template <class TaskOne, class TaskAll, class Stats>
+bool ThreadPool<TaskOne, TaskAll, Stats>::hasLocalTasks() const
+{
+    for (size_t i = 0; i < ws_.count_; ++i) {
+        if (!ws_.queues_[i].empty()) {
+            return true;
         }
     }
+    return false;
+}
+//-----------------------------------------------------------------------------
+// NOTE:
+// Wakes at most one idle worker at a time by pushing a Wake stub on the shared ring.
+//  The woken worker clears waking_ and looks for local tasks to steal.
+template <class TaskOne, class TaskAll, class Stats>
+void ThreadPool<TaskOne, TaskAll, Stats>::wakeIdle()
+{
+    if (ws_.idle_count_.load() == 0 || ws_.waking_.exchange(true)) {
+        return;
+    }
+    const auto [index, count] = pushOneIndex();
+    auto& rstub               = one_.tasks_[index];
+
+    rstub.waitWhilePushAll(statistic_, count, spin_count_);
+
+    rstub.all_id_ = all_.commited_index_.load();
+
+    rstub.notifyWhilePushAll();
+    statistic_.wakeIdle();
 }
 //-----------------------------------------------------------------------------
 template <class TaskOne, class TaskAll, class Stats>
@@ -1267,6 +1618,22 @@ template <class Tsk>
 void ThreadPool<TaskOne, TaskAll, Stats>::doPushOne(Tsk&& _task, ContextStub* _pctx)
 {
     using namespace std::chrono;
+
+    if (ws_.count_ != 0 && local_queue_ref_.ppool_ == this && local_queue_ref_.pqueue_->canPush()) {
+        // pushed from within one of our workers - keep the task local
+        uint64_t context_produce_id = 0;
+        if (_pctx) {
+            _pctx->acquire();
+            context_produce_id = _pctx->produce_id_.fetch_add(1);
+        }
+        local_queue_ref_.pqueue_->push(std::forward<Tsk>(_task), _pctx, all_.commited_index_.load(), context_produce_id);
+        statistic_.pushOneLocal();
+        // NOTE: pairs with the fence in doRun
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wakeIdle();
+        return;
+    }
+
     const auto start          = steady_clock::now();
     const auto [index, count] = pushOneIndex();
     auto& rstub               = one_.tasks_[index];
@@ -11,6 +11,7 @@
 
 #include "mprpc_file_messages.hpp"
 
+#include <fstream>
 #include <iostream>
 
 using namespace solid;
@@ -4,8 +4,9 @@
 #include "solid/frame/mprpc/mprpccontext.hpp"
 #include "solid/frame/mprpc/mprpcmessage.hpp"
 #include "solid/frame/mprpc/mprpcprotocol_serialization_v3.hpp"
+#include "solid/system/filedevice.hpp"
+#include "solid/system/fileregionstream.hpp"
 #include <deque>
-#include <fstream>
 #include <iostream>
 #include <vector>
 
@@ -63,10 +64,12 @@ struct FileRequest : solid::frame::mprpc::Message {
 };
 
 struct FileResponse : solid::frame::mprpc::Message {
-    std::string           remote_path;
-    mutable int64_t       remote_file_size = 0;
-    mutable std::ifstream ifs;
-    std::ofstream         ofs;
+    std::string                      remote_path;
+    mutable int64_t                  remote_file_size = 0;
+    mutable solid::FileDevice        ifd;
+    mutable solid::FileRegionIStream ifs; // file chunks are pread straight into the mprpc packet
+    solid::FileDevice                ofd;
+    solid::FileRegionOStream         ofs; // file chunks are pwritten straight from the mprpc packet
 
     FileResponse() {}
 
@@ -82,13 +85,9 @@ struct FileResponse : solid::frame::mprpc::Message {
     {
         if constexpr (Reflector::is_const_reflector) {
 
-            _rthis.ifs.open(_rthis.remote_path);
-            if (_rthis.ifs) {
-                std::streampos pos = _rthis.ifs.tellg();
-                _rthis.ifs.seekg(0, _rthis.ifs.end);
-                std::streampos endpos = _rthis.ifs.tellg();
-                _rthis.ifs.seekg(pos);
-                _rthis.remote_file_size = endpos;
+            if (_rthis.ifd.open(_rthis.remote_path.c_str(), solid::FileDevice::ReadOnlyE)) {
+                _rthis.remote_file_size = _rthis.ifd.size();
+                _rthis.ifs.region(_rthis.ifd, 0, _rthis.remote_file_size, true /*readahead*/);
                 _rr.add(_rthis.remote_file_size, _rctx, 1, "remote_file_size");
 
                 auto progress_lambda = [](Context& _rctx, std::istream& _ris, uint64_t _len, const bool _done, const size_t _index, const char* _name) {
@@ -110,8 +109,8 @@ struct FileResponse : solid::frame::mprpc::Message {
 
                     if (_rthis.remote_file_size != solid::InvalidIndex()) {
                         const std::string* plocal_path = _rthis.localPath(_rctx);
-                        if (plocal_path != nullptr) {
-                            _rthis.ofs.open(*plocal_path);
+                        if (plocal_path != nullptr && _rthis.ofd.create(plocal_path->c_str(), solid::FileDevice::WriteOnlyE)) {
+                            _rthis.ofs.region(_rthis.ofd, 0, _rthis.remote_file_size);
                         }
 
                         _rr.add(_rthis.ofs, _rctx, 2, "stream", [&progress_lambda](auto& _rmeta) { _rmeta.progressFunction(progress_lambda); });